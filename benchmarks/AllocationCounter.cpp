@@ -0,0 +1,62 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic< unsigned long long > allocationCount = 0;
+
+unsigned long long AllocationCounter::GetCount()
+{
+    return allocationCount.load( std::memory_order_relaxed );
+}
+
+static void* CountedAllocate( std::size_t size )
+{
+    allocationCount.fetch_add( 1, std::memory_order_relaxed );
+    if ( void* pointer = std::malloc( size > 0 ? size : 1 ) )
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new( std::size_t size )
+{
+    return CountedAllocate( size );
+}
+
+void* operator new[]( std::size_t size )
+{
+    return CountedAllocate( size );
+}
+
+void* operator new( std::size_t size, const std::nothrow_t& ) noexcept
+{
+    allocationCount.fetch_add( 1, std::memory_order_relaxed );
+    return std::malloc( size > 0 ? size : 1 );
+}
+
+void* operator new[]( std::size_t size, const std::nothrow_t& ) noexcept
+{
+    allocationCount.fetch_add( 1, std::memory_order_relaxed );
+    return std::malloc( size > 0 ? size : 1 );
+}
+
+void operator delete( void* pointer ) noexcept
+{
+    std::free( pointer );
+}
+
+void operator delete[]( void* pointer ) noexcept
+{
+    std::free( pointer );
+}
+
+void operator delete( void* pointer, std::size_t ) noexcept
+{
+    std::free( pointer );
+}
+
+void operator delete[]( void* pointer, std::size_t ) noexcept
+{
+    std::free( pointer );
+}
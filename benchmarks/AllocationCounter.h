@@ -0,0 +1,8 @@
+#pragma once
+
+// Counts every global operator new of the process. Only linked into the executables that report allocations.
+class AllocationCounter
+{
+public:
+    static unsigned long long GetCount();
+};
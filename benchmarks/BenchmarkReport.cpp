@@ -0,0 +1,180 @@
+#include "BenchmarkReport.h"
+
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#define FMT_HEADER_ONLY
+#include "fmt/format.h"
+
+static constexpr double BYTES_IN_MEGABYTE = 1024.0 * 1024.0;
+static constexpr double MILLISECONDS_IN_SECOND = 1000.0;
+
+double BenchmarkEntry::GetPercentile( double percentile ) const
+{
+    if ( samplesSeconds.empty() )
+        return 0.0;
+    std::vector< double > sortedSamples = samplesSeconds;
+    std::sort( sortedSamples.begin(), sortedSamples.end() );
+    // Nearest-rank, so that the reported value is always an observed sample.
+    const size_t rank = static_cast< size_t >( std::ceil( percentile / 100.0 * static_cast< double >( sortedSamples.size() ) ) );
+    return sortedSamples[ std::clamp< size_t >( rank, 1, sortedSamples.size() ) - 1 ];
+}
+
+BenchmarkReport::BenchmarkReport( const std::string& suiteName )
+    : suiteName_( suiteName )
+{
+}
+
+void BenchmarkReport::AddCommonOptions( QCommandLineParser& parser )
+{
+    parser.addHelpOption();
+    parser.addOption( QCommandLineOption( "iterations", "Number of samples per benchmark.", "count", "5" ) );
+    parser.addOption( QCommandLineOption( "json", "Write the results to this file.", "file" ) );
+    parser.addOption( QCommandLineOption( "baseline", "Compare the medians with the results of a previous --json run.", "file" ) );
+    parser.addOption( QCommandLineOption( "tolerance", "Accepted relative slowdown against the baseline.", "ratio", "0.10" ) );
+}
+
+BenchmarkOptions BenchmarkReport::ReadCommonOptions( const QCommandLineParser& parser )
+{
+    BenchmarkOptions options;
+    options.iterations = std::max( parser.value( "iterations" ).toUInt(), 1u );
+    options.jsonOutputPath = parser.value( "json" );
+    options.baselinePath = parser.value( "baseline" );
+    options.tolerance = parser.value( "tolerance" ).toDouble();
+    return options;
+}
+
+BenchmarkEntry& BenchmarkReport::AddEntry( const std::string& name )
+{
+    BenchmarkEntry& entry = entries_.emplace_back();
+    entry.name = name;
+    return entry;
+}
+
+void BenchmarkReport::Print() const
+{
+    fmt::print( "{}\n", suiteName_ );
+    fmt::print( "{:<40} {:>6} {:>11} {:>11} {:>11} {:>11} {:>10} {:>13} {:>12}\n",
+                "benchmark",
+                "n",
+                "p50 (ms)",
+                "p90 (ms)",
+                "p99 (ms)",
+                "max (ms)",
+                "MB/s",
+                "records/s",
+                "allocs" );
+    for ( const BenchmarkEntry& entry : entries_ )
+    {
+        const double median = entry.GetMedian();
+        const std::string megabytesPerSecond =
+            entry.bytesPerSample > 0 && median > 0.0 ? fmt::format( "{:.1f}", entry.bytesPerSample / BYTES_IN_MEGABYTE / median ) : "-";
+        const std::string recordsPerSecond =
+            entry.recordsPerSample > 0 && median > 0.0 ? fmt::format( "{:.0f}", entry.recordsPerSample / median ) : "-";
+        const double allocationsPerSample = entry.GetAllocationsPerSample();
+        const std::string allocations = allocationsPerSample >= 0.0 ? fmt::format( "{:.1f}", allocationsPerSample ) : "-";
+        fmt::print( "{:<40} {:>6} {:>11.3f} {:>11.3f} {:>11.3f} {:>11.3f} {:>10} {:>13} {:>12}\n",
+                    entry.name,
+                    entry.samplesSeconds.size(),
+                    median * MILLISECONDS_IN_SECOND,
+                    entry.GetPercentile( 90.0 ) * MILLISECONDS_IN_SECOND,
+                    entry.GetPercentile( 99.0 ) * MILLISECONDS_IN_SECOND,
+                    entry.GetPercentile( 100.0 ) * MILLISECONDS_IN_SECOND,
+                    megabytesPerSecond,
+                    recordsPerSecond,
+                    allocations );
+    }
+}
+
+bool BenchmarkReport::SaveToFile( const QString& filePath ) const
+{
+    QJsonArray entriesArray;
+    for ( const BenchmarkEntry& entry : entries_ )
+    {
+        QJsonObject entryObj;
+        entryObj[ "name" ] = QString::fromStdString( entry.name );
+        entryObj[ "samples" ] = static_cast< qint64 >( entry.samplesSeconds.size() );
+        entryObj[ "p50Seconds" ] = entry.GetMedian();
+        entryObj[ "p90Seconds" ] = entry.GetPercentile( 90.0 );
+        entryObj[ "p99Seconds" ] = entry.GetPercentile( 99.0 );
+        entryObj[ "maxSeconds" ] = entry.GetPercentile( 100.0 );
+        entryObj[ "bytesPerSample" ] = static_cast< qint64 >( entry.bytesPerSample );
+        entryObj[ "recordsPerSample" ] = static_cast< qint64 >( entry.recordsPerSample );
+        entryObj[ "allocationsPerSample" ] = entry.GetAllocationsPerSample();
+        entriesArray.append( entryObj );
+    }
+    QJsonObject root;
+    root[ "suite" ] = QString::fromStdString( suiteName_ );
+    root[ "benchmarks" ] = entriesArray;
+
+    QFile file( filePath );
+    if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+        return false;
+    const QByteArray data = QJsonDocument( root ).toJson( QJsonDocument::Indented );
+    return file.write( data ) == data.size();
+}
+
+bool BenchmarkReport::CompareWithBaseline( const QString& baselinePath,
+                                           double tolerance,
+                                           std::vector< std::string >& regressions,
+                                           QString& error ) const
+{
+    QFile file( baselinePath );
+    if ( !file.open( QIODevice::ReadOnly ) )
+    {
+        error = QString( "Could not open baseline %1" ).arg( baselinePath );
+        return false;
+    }
+    const QJsonDocument doc = QJsonDocument::fromJson( file.readAll() );
+    if ( !doc.isObject() )
+    {
+        error = QString( "Baseline %1 is not a benchmark result file" ).arg( baselinePath );
+        return false;
+    }
+
+    for ( const QJsonValue& value : doc.object().value( "benchmarks" ).toArray() )
+    {
+        const QJsonObject baselineObj = value.toObject();
+        const std::string name = baselineObj.value( "name" ).toString().toStdString();
+        const auto entry = std::find_if( entries_.begin(), entries_.end(), [ &name ]( const BenchmarkEntry& e ) { return e.name == name; } );
+        if ( entry == entries_.end() )
+            continue;
+        const double baselineMedian = baselineObj.value( "p50Seconds" ).toDouble();
+        if ( baselineMedian > 0.0 && entry->GetMedian() > baselineMedian * ( 1.0 + tolerance ) )
+        {
+            regressions.push_back( fmt::format(
+                "{}: {:.3f} ms, baseline {:.3f} ms", name, entry->GetMedian() * MILLISECONDS_IN_SECOND, baselineMedian * MILLISECONDS_IN_SECOND ) );
+        }
+    }
+    return true;
+}
+
+int BenchmarkReport::Finish( const BenchmarkOptions& options ) const
+{
+    Print();
+    if ( !options.jsonOutputPath.isEmpty() && !SaveToFile( options.jsonOutputPath ) )
+    {
+        std::cerr << "Could not write results to " << options.jsonOutputPath.toStdString() << std::endl;
+        return EXIT_FAILURE;
+    }
+    if ( options.baselinePath.isEmpty() )
+        return EXIT_SUCCESS;
+
+    std::vector< std::string > regressions;
+    QString error;
+    if ( !CompareWithBaseline( options.baselinePath, options.tolerance, regressions, error ) )
+    {
+        std::cerr << error.toStdString() << std::endl;
+        return EXIT_FAILURE;
+    }
+    for ( const std::string& regression : regressions )
+        std::cerr << "Regression: " << regression << std::endl;
+    return regressions.empty() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <QString>
+
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+
+class QCommandLineParser;
+
+class BenchmarkTimer
+{
+public:
+    BenchmarkTimer()
+        : start_( std::chrono::steady_clock::now() )
+    {
+    }
+
+    double GetElapsedSeconds() const
+    {
+        return std::chrono::duration< double >( std::chrono::steady_clock::now() - start_ ).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_;
+};
+
+struct BenchmarkEntry
+{
+    std::string name;
+    std::vector< double > samplesSeconds;
+    unsigned long long bytesPerSample = 0;   // 0 when throughput in MB/s is meaningless.
+    unsigned long long recordsPerSample = 0; // 0 when throughput in records/s is meaningless.
+    long long allocations = -1;              // Total over all samples, negative when allocations are not tracked.
+
+    double GetPercentile( double percentile ) const;
+    double GetMedian() const
+    {
+        return GetPercentile( 50.0 );
+    }
+    double GetAllocationsPerSample() const
+    {
+        return allocations >= 0 && !samplesSeconds.empty() ? static_cast< double >( allocations ) / samplesSeconds.size() : -1.0;
+    }
+};
+
+struct BenchmarkOptions
+{
+    unsigned int iterations = 5;
+    QString jsonOutputPath;
+    QString baselinePath;
+    double tolerance = 0.10; // Relative slowdown of the median accepted before reporting a regression.
+};
+
+// Collects the samples of one benchmark executable, prints them and checks them against a previous run.
+class BenchmarkReport
+{
+public:
+    explicit BenchmarkReport( const std::string& suiteName );
+
+    static void AddCommonOptions( QCommandLineParser& parser );
+    static BenchmarkOptions ReadCommonOptions( const QCommandLineParser& parser );
+
+    BenchmarkEntry& AddEntry( const std::string& name );
+
+    void Print() const;
+    bool SaveToFile( const QString& filePath ) const;
+    bool CompareWithBaseline( const QString& baselinePath, double tolerance, std::vector< std::string >& regressions, QString& error ) const;
+
+    // Prints, saves and compares as requested by the options, returns the process exit code.
+    int Finish( const BenchmarkOptions& options ) const;
+
+private:
+    std::string suiteName_;
+    std::deque< BenchmarkEntry > entries_; // References returned by AddEntry stay valid.
+};
@@ -0,0 +1,219 @@
+#include "AllocationCounter.h"
+#include "BenchmarkReport.h"
+#include "SyntheticRessourcesLoader.h"
+#include "SyntheticSdeGenerator.h"
+
+#include "Blueprint.h"
+#include "BuildOrBuyOptimizer.h"
+#include "GlobalRessources.h"
+#include "IndustryCalculator.h"
+#include "InventionCalculator.h"
+#include "JobScheduler.h"
+#include "LPHelper.h"
+#include "LogManager.h"
+#include "ManufacturingJob.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QSettings>
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <random>
+
+static constexpr unsigned int LP_SOLVES_PER_ITERATION = 20;
+static constexpr unsigned int LP_BLUEPRINTS_PER_DEPTH = 10;
+static constexpr std::array< unsigned int, 4 > LP_REQUIREMENT_COUNTS = { 1, 2, 4, 8 };
+
+struct DepthClass
+{
+    const char* name;
+    unsigned int firstTier; // Zero based tiers of SyntheticSdeLayout.
+    unsigned int lastTier;
+};
+
+static constexpr std::array< DepthClass, 3 > DEPTH_CLASSES = { DepthClass{ "shallow", 0, 0 },
+                                                               DepthClass{ "medium", 1, 2 },
+                                                               DepthClass{ "capital", 3, 3 } };
+
+// Keeps the measured calls from being optimized away.
+static volatile size_t resultSink = 0;
+
+template < typename Call >
+static void MeasureCalls( BenchmarkEntry& entry, size_t callCount, Call&& call )
+{
+    const unsigned long long allocationsBefore = AllocationCounter::GetCount();
+    for ( size_t i = 0; i < callCount; ++i )
+    {
+        const BenchmarkTimer timer;
+        call( i );
+        entry.samplesSeconds.push_back( timer.GetElapsedSeconds() );
+    }
+    const long long allocations = static_cast< long long >( AllocationCounter::GetCount() - allocationsBefore );
+    entry.allocations = std::max( entry.allocations, 0ll ) + allocations;
+}
+
+static std::vector< std::shared_ptr< const Blueprint > > GetBlueprints( const SyntheticSdeLayout& layout, const DepthClass& depthClass )
+{
+    std::vector< std::shared_ptr< const Blueprint > > blueprints;
+    for ( unsigned int tier = depthClass.firstTier; tier <= depthClass.lastTier; ++tier )
+    {
+        for ( const tTypeId blueprintId : layout.blueprintsByTier[ tier ] )
+        {
+            if ( const auto blueprint = GlobalRessources::GetBlueprintById( blueprintId ) )
+                blueprints.push_back( blueprint );
+        }
+    }
+    return blueprints;
+}
+
+static void RunBomBenchmarks( const SyntheticSdeLayout& layout, unsigned int iterations, BenchmarkReport& report )
+{
+    for ( const DepthClass& depthClass : DEPTH_CLASSES )
+    {
+        const auto blueprints = GetBlueprints( layout, depthClass );
+        const std::string suffix = std::string( "/" ) + depthClass.name;
+
+        // GetRecursedRawMaterialList memoizes per job, so the first call is only observable once per process.
+        // Components shared with previously expanded blueprints are already warm, as they would be in the application.
+        BenchmarkEntry& coldEntry = report.AddEntry( "GetRecursedRawMaterialList/first" + suffix );
+        MeasureCalls( coldEntry,
+                      blueprints.size(),
+                      [ & ]( size_t i ) { resultSink = resultSink + blueprints[ i ]->GetProductionJob()->GetRecursedRawMaterialList().size(); } );
+
+        BenchmarkEntry& warmEntry = report.AddEntry( "GetRecursedRawMaterialList/memoized" + suffix );
+        BenchmarkEntry& calculatorEntry = report.AddEntry( "IndustryCalculator::ComputeRawMaterials" + suffix );
+        BenchmarkEntry& buildOrBuyEntry = report.AddEntry( "BuildOrBuyOptimizer::Solve" + suffix );
+        for ( unsigned int iteration = 0; iteration < iterations; ++iteration )
+        {
+            MeasureCalls( warmEntry,
+                          blueprints.size(),
+                          [ & ]( size_t i )
+                          { resultSink = resultSink + blueprints[ i ]->GetProductionJob()->GetRecursedRawMaterialList().size(); } );
+            MeasureCalls( calculatorEntry,
+                          blueprints.size(),
+                          [ & ]( size_t i )
+                          { resultSink = resultSink + IndustryCalculator::ComputeRawMaterials( blueprints[ i ]->GetTypeId(), 10, 10 ).size(); } );
+            // A fresh optimizer per iteration, its memo is only shared between the blueprints of one pass.
+            BuildOrBuyOptimizer optimizer( BuildOrBuySettings(), 10 );
+            MeasureCalls( buildOrBuyEntry,
+                          blueprints.size(),
+                          [ & ]( size_t i )
+                          {
+                              const tTypeId productId = blueprints[ i ]->GetProductionJob()->GetManufacturedProducts().front().item;
+                              resultSink = resultSink + optimizer.Solve( productId ).isBuilt;
+                          } );
+        }
+    }
+}
+
+static void RunInventionBenchmarks( unsigned int iterations, BenchmarkReport& report )
+{
+    // Every invented blueprint with every decryptor, the whole pass is one call.
+    BenchmarkEntry& entry = report.AddEntry( "InventionCalculator::EstimateAll" );
+    for ( unsigned int iteration = 0; iteration < iterations; ++iteration )
+    {
+        MeasureCalls(
+            entry, 1, [ & ]( size_t ) { resultSink = resultSink + InventionCalculator::EstimateAll( InventionSkills() ).size(); } );
+    }
+}
+
+static void RunSchedulerBenchmarks( const SyntheticSdeLayout& layout, unsigned int iterations, BenchmarkReport& report )
+{
+    SchedulerSettings settings;
+    settings.characters.assign( 3, SchedulerCharacter{ "", 11, 11, 20 } );
+    for ( const DepthClass& depthClass : DEPTH_CLASSES )
+    {
+        std::vector< std::vector< PlannedJob > > plans;
+        for ( const auto& blueprint : GetBlueprints( layout, depthClass ) )
+        {
+            ProductionRequest request;
+            request.blueprintId = blueprint->GetTypeId();
+            request.runs = 10;
+            request.materialEfficiency = 10;
+            plans.push_back( JobScheduler::BuildPlan( request ) );
+        }
+        BenchmarkEntry& entry = report.AddEntry( std::string( "JobScheduler::Schedule/" ) + depthClass.name );
+        for ( unsigned int iteration = 0; iteration < iterations; ++iteration )
+        {
+            MeasureCalls( entry,
+                          plans.size(),
+                          [ & ]( size_t i ) { resultSink = resultSink + JobScheduler::Schedule( plans[ i ], settings ).has_value(); } );
+        }
+    }
+}
+
+static void RunLpBenchmarks( const SyntheticSdeLayout& layout, unsigned int iterations, BenchmarkReport& report )
+{
+    LPHelper solver( GlobalRessources::GetOresMap() );
+
+    std::mt19937 random( 7 );
+    for ( const unsigned int requirementCount : LP_REQUIREMENT_COUNTS )
+    {
+        const unsigned int mineralCount = std::min< unsigned int >( requirementCount, static_cast< unsigned int >( layout.minerals.size() ) );
+        std::vector< std::map< tTypeId, unsigned int > > requirementSets( LP_SOLVES_PER_ITERATION );
+        for ( auto& requirements : requirementSets )
+        {
+            for ( unsigned int i = 0; i < mineralCount; ++i )
+                requirements[ layout.minerals[ i ] ] = 1000 + random() % 5000000;
+        }
+
+        BenchmarkEntry& entry = report.AddEntry( "LPHelper::SolveForRequirements/" + std::to_string( mineralCount ) + " requirements" );
+        for ( unsigned int iteration = 0; iteration < iterations; ++iteration )
+        {
+            MeasureCalls( entry,
+                          requirementSets.size(),
+                          [ & ]( size_t i ) { resultSink = resultSink + solver.SolveForRequirements( requirementSets[ i ] ); } );
+        }
+    }
+
+    for ( const DepthClass& depthClass : DEPTH_CLASSES )
+    {
+        auto blueprints = GetBlueprints( layout, depthClass );
+        blueprints.resize( std::min< size_t >( blueprints.size(), LP_BLUEPRINTS_PER_DEPTH ) );
+        BenchmarkEntry& entry = report.AddEntry( std::string( "LPHelper::SolveForBlueprint/" ) + depthClass.name );
+        for ( unsigned int iteration = 0; iteration < iterations; ++iteration )
+        {
+            MeasureCalls(
+                entry, blueprints.size(), [ & ]( size_t i ) { resultSink = resultSink + solver.SolveForBlueprint( *blueprints[ i ] ); } );
+        }
+    }
+}
+
+int main( int argc, char** argv )
+{
+    QCoreApplication app( argc, argv );
+    LOG_CONSOLE_OUTPUT( false );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Latency of the BOM expansion and ore LP solves on a fixed synthetic dataset." );
+    BenchmarkReport::AddCommonOptions( parser );
+    parser.addOption( QCommandLineOption( "scale", "Synthetic SDE size, 1 is roughly a tenth of the real one.", "scale", "1" ) );
+    parser.process( app );
+    const BenchmarkOptions options = BenchmarkReport::ReadCommonOptions( parser );
+
+    // The seed is fixed: results are only comparable on the same dataset.
+    SyntheticSdeOptions sdeOptions;
+    sdeOptions.scale = std::max( parser.value( "scale" ).toUInt(), 1u );
+    const QString workingDirectory = QDir( QCoreApplication::applicationDirPath() ).filePath( QString( "industry-dataset-%1" ).arg( sdeOptions.scale ) );
+    const QString sourceDirectory = QDir( workingDirectory ).filePath( "source" );
+
+    SyntheticSdeGenerator generator( sdeOptions );
+    if ( !generator.Generate( sourceDirectory ) )
+    {
+        std::cerr << generator.GetLastError().toStdString() << std::endl;
+        return EXIT_FAILURE;
+    }
+    QSettings settings( QDir( workingDirectory ).filePath( "benchmark.ini" ), QSettings::IniFormat );
+    if ( !SyntheticRessourcesLoader::Load( sourceDirectory, settings ) )
+        return EXIT_FAILURE;
+
+    BenchmarkReport report( "BOM expansion and ore LP latency" );
+    RunBomBenchmarks( generator.GetLayout(), options.iterations, report );
+    RunInventionBenchmarks( options.iterations, report );
+    RunSchedulerBenchmarks( generator.GetLayout(), options.iterations, report );
+    RunLpBenchmarks( generator.GetLayout(), options.iterations, report );
+    return report.Finish( options );
+}
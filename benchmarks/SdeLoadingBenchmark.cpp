@@ -0,0 +1,235 @@
+#include "BenchmarkReport.h"
+#include "SyntheticSdeGenerator.h"
+
+#include "EveType.h"
+#include "LogManager.h"
+#include "Ore.h"
+#include "RessourcesManager.h"
+#include "ZipExtractor.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSettings>
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <map>
+
+static constexpr std::array< const char*, 4 > SDE_FILES = { "types.jsonl", "blueprints.jsonl", "typeMaterials.jsonl", "groups.jsonl" };
+
+static unsigned long long GetFileSize( const QString& filePath )
+{
+    return static_cast< unsigned long long >( QFileInfo( filePath ).size() );
+}
+
+static unsigned long long CountLines( const QString& filePath )
+{
+    QFile file( filePath );
+    if ( !file.open( QIODevice::ReadOnly ) )
+        return 0;
+    unsigned long long lineCount = 0;
+    while ( !file.atEnd() )
+        lineCount += file.read( 1 << 20 ).count( '\n' );
+    return lineCount;
+}
+
+// Drives the private stages of RessourcesManager one by one, in the order LoadSdeData runs them.
+class SdeLoadingBenchmark
+{
+public:
+    SdeLoadingBenchmark( const QString& workingDirectory, bool isCompressingSnapshots, BenchmarkReport& report )
+        : report_( report )
+        , isCompressingSnapshots_( isCompressingSnapshots )
+        , zipPath_( QDir( workingDirectory ).filePath( "sde.zip" ) )
+        , extractedPath_( QDir( workingDirectory ).filePath( "extracted" ) + "/" )
+        , settings_( QDir( workingDirectory ).filePath( "benchmark.ini" ), QSettings::IniFormat )
+    {
+    }
+
+    bool RunIteration()
+    {
+        // Element counts are cached in the settings, a first launch has none.
+        settings_.clear();
+        settings_.setValue( "StaticData/CompressSnapshots", isCompressingSnapshots_ );
+
+        if ( !Measure( "ExtractZip",
+                       0,
+                       SDE_FILES.size(),
+                       [ this ]()
+                       {
+                           ZipExtractor zipExtractor;
+                           return zipExtractor.ExtractZip( zipPath_, extractedPath_ );
+                       } ) )
+            return false;
+        entries_.at( "ExtractZip" )->bytesPerSample = GetExtractedBytes();
+
+        RessourcesManager manager( settings_ );
+        QObject::connect( &manager,
+                          &RessourcesManager::ErrorOccured,
+                          []( const QString& errorMessage ) { std::cerr << errorMessage.toStdString() << std::endl; } );
+
+        const QString typesPath = extractedPath_ + "types.jsonl";
+        const QString blueprintsPath = extractedPath_ + "blueprints.jsonl";
+        const QString typeMaterialsPath = extractedPath_ + "typeMaterials.jsonl";
+        const QString groupsPath = extractedPath_ + "groups.jsonl";
+
+        manager.import_ = std::make_unique< SdeImport >();
+        std::unordered_set< unsigned int > oreGroupIds;
+        if ( !Measure( "ReadOreGroupIds",
+                       GetFileSize( groupsPath ),
+                       GetLineCount( groupsPath ),
+                       [ & ]() { return manager.ReadOreGroupIds( groupsPath, oreGroupIds ); } ) )
+            return false;
+        if ( !Measure( "StageJsonlFile<SdeBlueprintRecord>",
+                       GetFileSize( blueprintsPath ),
+                       GetLineCount( blueprintsPath ),
+                       [ & ]()
+                       { return manager.StageJsonlFile( blueprintsPath, manager.import_->GetBlueprints(), eDataLoadingSteps::LoadingBlueprints ); } ) )
+            return false;
+        if ( !Measure( "StageJsonlFile<SdeOreRecord>",
+                       GetFileSize( typeMaterialsPath ),
+                       GetLineCount( typeMaterialsPath ),
+                       [ & ]() { return manager.StageJsonlFile( typeMaterialsPath, manager.import_->GetOres(), eDataLoadingSteps::LoadingOres ); } ) )
+            return false;
+        const std::unordered_set< tTypeId > referencedTypeIds = manager.CollectReferencedTypeIds();
+        if ( !Measure( "StageJsonlFile<SdeTypeRecord>",
+                       GetFileSize( typesPath ),
+                       GetLineCount( typesPath ),
+                       [ & ]()
+                       {
+                           return manager.StageJsonlFile(
+                               typesPath, manager.import_->GetTypes(), eDataLoadingSteps::LoadingTypes, &referencedTypeIds );
+                       } ) )
+            return false;
+
+        Measure( "FilterIrrelevantTypes",
+                 0,
+                 manager.import_->GetTypes().size(),
+                 [ & ]()
+                 {
+                     manager.FilterIrrelevantTypes( oreGroupIds );
+                     return true;
+                 } );
+        Measure( "SetManufacturableTypes",
+                 0,
+                 manager.blueprints_.size(),
+                 [ & ]()
+                 {
+                     manager.SetManufacturableTypes();
+                     return true;
+                 } );
+        Measure( "AddReprocessedFromOreDataToTypes",
+                 0,
+                 manager.ores_.size(),
+                 [ & ]()
+                 {
+                     manager.AddReprocessedFromOreDataToTypes();
+                     return true;
+                 } );
+
+        const unsigned long long filteredRecords = manager.types_.size() + manager.blueprints_.size() + manager.ores_.size();
+        if ( !Measure( "SaveToBinaryFile", 0, filteredRecords, [ & ]() { return manager.SaveToBinaryFile(); } ) )
+            return false;
+        entries_.at( "SaveToBinaryFile" )->bytesPerSample = GetBinaryBytes( manager );
+
+        RessourcesManager binaryManager( settings_ );
+        return Measure( "LoadMapsFromBinaryFiles",
+                        GetBinaryBytes( binaryManager ),
+                        filteredRecords,
+                        [ & ]() { return binaryManager.LoadMapsFromBinaryFiles() == eSnapshotStatus::Valid; } );
+    }
+
+private:
+    template < typename Stage >
+    bool Measure( const std::string& name, unsigned long long bytes, unsigned long long records, Stage&& stage )
+    {
+        auto entry = entries_.find( name );
+        if ( entry == entries_.end() )
+            entry = entries_.emplace( name, &report_.AddEntry( name ) ).first;
+
+        const BenchmarkTimer timer;
+        const bool isSuccess = stage();
+        entry->second->samplesSeconds.push_back( timer.GetElapsedSeconds() );
+        entry->second->bytesPerSample = bytes;
+        entry->second->recordsPerSample = records;
+        if ( !isSuccess )
+            std::cerr << name << " failed" << std::endl;
+        return isSuccess;
+    }
+
+    unsigned long long GetExtractedBytes()
+    {
+        unsigned long long bytes = 0;
+        for ( const char* fileName : SDE_FILES )
+            bytes += GetFileSize( extractedPath_ + fileName );
+        return bytes;
+    }
+
+    unsigned long long GetLineCount( const QString& filePath )
+    {
+        auto lineCount = lineCounts_.find( filePath );
+        if ( lineCount == lineCounts_.end() )
+            lineCount = lineCounts_.emplace( filePath, CountLines( filePath ) ).first;
+        return lineCount->second;
+    }
+
+    static unsigned long long GetBinaryBytes( const RessourcesManager& manager )
+    {
+        return GetFileSize( manager.BINARY_TYPES_FILEPATH_ ) + GetFileSize( manager.BINARY_BLUEPRINTS_FILEPATH_ )
+               + GetFileSize( manager.BINARY_ORES_FILEPATH_ );
+    }
+
+private:
+    BenchmarkReport& report_;
+    std::map< std::string, BenchmarkEntry* > entries_;
+    std::map< QString, unsigned long long > lineCounts_;
+    const bool isCompressingSnapshots_;
+    const QString zipPath_;
+    const QString extractedPath_;
+    QSettings settings_;
+};
+
+int main( int argc, char** argv )
+{
+    QCoreApplication app( argc, argv );
+    LOG_CONSOLE_OUTPUT( false );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Times every stage of the SDE loading pipeline on a synthetic SDE." );
+    BenchmarkReport::AddCommonOptions( parser );
+    parser.addOption( QCommandLineOption( "scale", "Synthetic SDE size, 1 is roughly a tenth of the real one.", "scale", "1" ) );
+    parser.addOption( QCommandLineOption( "seed", "Synthetic SDE generator seed.", "seed", "42" ) );
+    parser.addOption( QCommandLineOption( "compress-snapshots", "Write and read the binary files as zlib compressed blocks." ) );
+    parser.process( app );
+    const BenchmarkOptions options = BenchmarkReport::ReadCommonOptions( parser );
+
+    SyntheticSdeOptions sdeOptions;
+    sdeOptions.scale = std::max( parser.value( "scale" ).toUInt(), 1u );
+    sdeOptions.seed = parser.value( "seed" ).toUInt();
+    const QString workingDirectory =
+        QDir( QCoreApplication::applicationDirPath() ).filePath( QString( "synthetic-sde-%1-%2" ).arg( sdeOptions.scale ).arg( sdeOptions.seed ) );
+    const QString sourceDirectory = QDir( workingDirectory ).filePath( "source" );
+
+    SyntheticSdeGenerator generator( sdeOptions );
+    const BenchmarkTimer generationTimer;
+    if ( !generator.Generate( sourceDirectory ) || !generator.WriteZip( sourceDirectory, QDir( workingDirectory ).filePath( "sde.zip" ) ) )
+    {
+        std::cerr << generator.GetLastError().toStdString() << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Generated synthetic SDE (scale " << sdeOptions.scale << ", seed " << sdeOptions.seed << ") in "
+              << generationTimer.GetElapsedSeconds() << " s" << std::endl;
+
+    BenchmarkReport report( "SDE loading pipeline" );
+    SdeLoadingBenchmark benchmark( workingDirectory, parser.isSet( "compress-snapshots" ), report );
+    for ( unsigned int i = 0; i < options.iterations; ++i )
+    {
+        if ( !benchmark.RunIteration() )
+            return EXIT_FAILURE;
+    }
+    return report.Finish( options );
+}
@@ -0,0 +1,21 @@
+#include "SyntheticRessourcesLoader.h"
+
+#include "RessourcesManager.h"
+
+#include <QJsonObject>
+#include <QSettings>
+
+#include <iostream>
+
+bool SyntheticRessourcesLoader::Load( const QString& extractedPath, QSettings& settings )
+{
+    RessourcesManager manager( settings );
+    QObject::connect(
+        &manager, &RessourcesManager::ErrorOccured, []( const QString& errorMessage ) { std::cerr << errorMessage.toStdString() << std::endl; } );
+
+    // The synthetic SDE comes without market prices, the stage still runs on an empty set.
+    if ( !manager.BuildMapsFromJsonl( extractedPath, QJsonObject() ) )
+        return false;
+    manager.OnRessourcesReady();
+    return true;
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include <QString>
+
+class QSettings;
+
+class SyntheticRessourcesLoader
+{
+public:
+    // Runs the jsonl stages of RessourcesManager on an extracted SDE directory and publishes the result to GlobalRessources.
+    static bool Load( const QString& extractedPath, QSettings& settings );
+};
@@ -0,0 +1,405 @@
+#include "SyntheticSdeGenerator.h"
+
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+
+#include <algorithm>
+#include <map>
+#include <zip.h>
+
+static constexpr const char* TYPES_JSONL = "types.jsonl";
+static constexpr const char* BLUEPRINTS_JSONL = "blueprints.jsonl";
+static constexpr const char* TYPEMATERIALS_JSONL = "typeMaterials.jsonl";
+static constexpr const char* GROUPS_JSONL = "groups.jsonl";
+
+static constexpr tTypeId FIRST_GENERATED_TYPE_ID = 100000;
+static constexpr tTypeId FIRST_GENERATED_GROUP_ID = 1000;
+static constexpr tTypeId MINERAL_GROUP_ID = 18;
+static constexpr unsigned int MATERIAL_CATEGORY_ID = 4;
+static constexpr unsigned int BLUEPRINT_CATEGORY_ID = 9;
+static constexpr unsigned int ORE_CATEGORY_ID = 25;
+
+static constexpr std::array< tTypeId, 8 > MINERAL_TYPE_IDS = { 34, 35, 36, 37, 38, 39, 40, 11399 };
+static constexpr std::array< unsigned int, 11 > PRODUCT_CATEGORY_IDS = { 6, 7, 8, 17, 18, 22, 23, 32, 65, 66, 87 };
+static constexpr std::array< unsigned int, 12 > FILLER_CATEGORY_IDS = { 1, 2, 3, 5, 11, 14, 16, 20, 24, 30, 63, 91 };
+static constexpr std::array< const char*, 8 > LANGUAGES = { "en", "de", "es", "fr", "ja", "ko", "ru", "zh" };
+static constexpr std::array< const char*, 16 > DESCRIPTION_WORDS = { "capsuleer", "hull",    "module",   "reactor", "shield", "armor",
+                                                                     "capacitor", "thruster", "warp",     "drone",   "cargo",  "scanner",
+                                                                     "tritanium", "isogen",   "frigate",  "titan" };
+
+// Entity counts for scale 1.
+static constexpr unsigned int ORE_GROUPS = 16;
+static constexpr unsigned int ORES_PER_GROUP = 3;
+static constexpr unsigned int BLUEPRINT_GROUPS = 20;
+static constexpr unsigned int PRODUCT_GROUPS = 60;
+static constexpr unsigned int FILLER_GROUPS = 50;
+static constexpr std::array< unsigned int, SyntheticSdeLayout::TIER_COUNT > BLUEPRINTS_PER_TIER = { 200, 150, 100, 50 };
+static constexpr unsigned int UNPUBLISHED_BLUEPRINTS = 25;
+static constexpr unsigned int FILLER_TYPES = 4000;
+
+SyntheticSdeGenerator::SyntheticSdeGenerator( const SyntheticSdeOptions& options )
+    : options_( options )
+    , random_( options.seed )
+{
+    if ( options_.scale == 0 )
+        options_.scale = 1;
+    BuildLayout();
+}
+
+bool SyntheticSdeGenerator::Generate( const QString& directoryPath )
+{
+    if ( !QDir().mkpath( directoryPath ) )
+    {
+        lastError_ = QString( "Could not create directory %1" ).arg( directoryPath );
+        return false;
+    }
+
+    // Reseeded so that every call writes the same bytes, whatever happened before.
+    random_.seed( options_.seed + 1 );
+    const QDir directory( directoryPath );
+    return WriteGroups( directory.filePath( GROUPS_JSONL ) ) && WriteTypes( directory.filePath( TYPES_JSONL ) )
+           && WriteBlueprints( directory.filePath( BLUEPRINTS_JSONL ) ) && WriteTypeMaterials( directory.filePath( TYPEMATERIALS_JSONL ) );
+}
+
+bool SyntheticSdeGenerator::WriteZip( const QString& directoryPath, const QString& zipPath )
+{
+    int zipError = 0;
+    zip_t* archive = zip_open( QFile::encodeName( zipPath ).constData(), ZIP_CREATE | ZIP_TRUNCATE, &zipError );
+    if ( archive == nullptr )
+    {
+        lastError_ = QString( "Could not create zip %1 (err=%2)" ).arg( zipPath ).arg( zipError );
+        return false;
+    }
+
+    const QDir directory( directoryPath );
+    for ( const char* fileName : { GROUPS_JSONL, TYPES_JSONL, BLUEPRINTS_JSONL, TYPEMATERIALS_JSONL } )
+    {
+        const QByteArray filePath = QFile::encodeName( directory.filePath( fileName ) );
+        zip_source_t* source = zip_source_file( archive, filePath.constData(), 0, ZIP_LENGTH_TO_END );
+        if ( source == nullptr || zip_file_add( archive, fileName, source, ZIP_FL_OVERWRITE ) < 0 )
+        {
+            lastError_ = QString( "Could not add %1 to zip: %2" ).arg( fileName, zip_strerror( archive ) );
+            if ( source != nullptr )
+                zip_source_free( source );
+            zip_discard( archive );
+            return false;
+        }
+    }
+
+    // Files are only read and deflated on close.
+    if ( zip_close( archive ) != 0 )
+    {
+        lastError_ = QString( "Could not write zip %1: %2" ).arg( zipPath, zip_strerror( archive ) );
+        zip_discard( archive );
+        return false;
+    }
+    return true;
+}
+
+const SyntheticSdeLayout& SyntheticSdeGenerator::GetLayout() const
+{
+    return layout_;
+}
+
+const QString& SyntheticSdeGenerator::GetLastError() const
+{
+    return lastError_;
+}
+
+void SyntheticSdeGenerator::BuildLayout()
+{
+    const unsigned int scale = options_.scale;
+    nextTypeId_ = FIRST_GENERATED_TYPE_ID;
+    nextGroupId_ = FIRST_GENERATED_GROUP_ID;
+
+    auto addGroups = [ this ]( unsigned int count, auto pickCategory, std::vector< tTypeId >& target )
+    {
+        for ( unsigned int i = 0; i < count; ++i )
+        {
+            groups_.push_back( { nextGroupId_, pickCategory() } );
+            target.push_back( nextGroupId_++ );
+        }
+    };
+    groups_.push_back( { MINERAL_GROUP_ID, MATERIAL_CATEGORY_ID } );
+    addGroups( ORE_GROUPS * scale, []() { return ORE_CATEGORY_ID; }, oreGroups_ );
+    addGroups( BLUEPRINT_GROUPS * scale, []() { return BLUEPRINT_CATEGORY_ID; }, blueprintGroups_ );
+    addGroups(
+        PRODUCT_GROUPS * scale,
+        [ this ]() { return PRODUCT_CATEGORY_IDS[ Uniform( 0, PRODUCT_CATEGORY_IDS.size() - 1 ) ]; },
+        productGroups_ );
+    addGroups(
+        FILLER_GROUPS * scale, [ this ]() { return FILLER_CATEGORY_IDS[ Uniform( 0, FILLER_CATEGORY_IDS.size() - 1 ) ]; }, fillerGroups_ );
+
+    for ( const tTypeId mineralId : MINERAL_TYPE_IDS )
+    {
+        types_.push_back( { mineralId, MINERAL_GROUP_ID, true } );
+        layout_.minerals.push_back( mineralId );
+    }
+
+    for ( const tTypeId groupId : oreGroups_ )
+    {
+        for ( unsigned int i = 0; i < ORES_PER_GROUP; ++i )
+            layout_.ores.push_back( AddType( groupId, true ) );
+    }
+
+    for ( unsigned int tier = 0; tier < SyntheticSdeLayout::TIER_COUNT; ++tier )
+    {
+        for ( unsigned int i = 0; i < BLUEPRINTS_PER_TIER[ tier ] * scale; ++i )
+        {
+            const tTypeId productId = AddType( PickFrom( productGroups_ ), true );
+            const tTypeId blueprintId = AddType( PickFrom( blueprintGroups_ ), true );
+            blueprints_.push_back( { blueprintId, productId, tier + 1 } );
+            layout_.productsByTier[ tier ].push_back( productId );
+            layout_.blueprintsByTier[ tier ].push_back( blueprintId );
+        }
+    }
+    // Every fourth tier 1 blueprint invents a tier 2 one, the tier 1 blueprints come first in blueprints_.
+    for ( size_t i = 0; i < layout_.blueprintsByTier[ 0 ].size() && i / 4 < layout_.blueprintsByTier[ 1 ].size(); i += 4 )
+        blueprints_[ i ].inventedBlueprintId = layout_.blueprintsByTier[ 1 ][ i / 4 ];
+
+    for ( unsigned int i = 0; i < UNPUBLISHED_BLUEPRINTS * scale; ++i )
+    {
+        const tTypeId productId = AddType( PickFrom( productGroups_ ), false );
+        blueprints_.push_back( { AddType( PickFrom( blueprintGroups_ ), false ), productId, 0 } );
+    }
+
+    for ( unsigned int i = 0; i < FILLER_TYPES * scale; ++i )
+    {
+        const tTypeId typeId = AddType( PickFrom( fillerGroups_ ), Uniform( 0, 4 ) != 0 );
+        if ( Uniform( 0, 9 ) == 0 )
+            reprocessableTypes_.push_back( typeId );
+    }
+}
+
+tTypeId SyntheticSdeGenerator::AddType( tTypeId groupId, bool isPublished )
+{
+    types_.push_back( { nextTypeId_, groupId, isPublished } );
+    return nextTypeId_++;
+}
+
+tTypeId SyntheticSdeGenerator::PickFrom( const std::vector< tTypeId >& typeIds )
+{
+    return typeIds[ Uniform( 0, static_cast< unsigned int >( typeIds.size() ) - 1 ) ];
+}
+
+unsigned int SyntheticSdeGenerator::Uniform( unsigned int min, unsigned int max )
+{
+    // std::uniform_int_distribution differs between standard libraries, the raw engine output does not.
+    return min + static_cast< unsigned int >( random_() % ( static_cast< unsigned long long >( max - min ) + 1 ) );
+}
+
+QJsonObject SyntheticSdeGenerator::BuildLocalizedText( const QString& englishText ) const
+{
+    QJsonObject localizedText;
+    for ( const char* language : LANGUAGES )
+        localizedText[ language ] = qstrcmp( language, "en" ) == 0 ? englishText : QString( "[%1] %2" ).arg( language, englishText );
+    return localizedText;
+}
+
+QString SyntheticSdeGenerator::BuildDescription()
+{
+    QStringList words;
+    const unsigned int wordCount = Uniform( 8, 60 );
+    for ( unsigned int i = 0; i < wordCount; ++i )
+        words.append( DESCRIPTION_WORDS[ Uniform( 0, DESCRIPTION_WORDS.size() - 1 ) ] );
+    return words.join( ' ' );
+}
+
+QJsonObject SyntheticSdeGenerator::BuildManufacturing( const GeneratedBlueprint& blueprint )
+{
+    const unsigned int tier = std::max( blueprint.tier, 1u );
+    std::map< tTypeId, unsigned int > materials;
+
+    const unsigned int mineralCount = tier == 1 ? Uniform( 2, 4 ) : Uniform( 1, 3 );
+    for ( unsigned int i = 0; i < mineralCount; ++i )
+        materials[ PickFrom( layout_.minerals ) ] += Uniform( 10, 5000 );
+
+    if ( tier > 1 )
+    {
+        // At least one component from the tier just below, so that the tier is the actual depth.
+        materials[ PickFrom( layout_.productsByTier[ tier - 2 ] ) ] += Uniform( 1, 40 );
+        const unsigned int componentCount = Uniform( 1, 5 );
+        for ( unsigned int i = 0; i < componentCount; ++i )
+            materials[ PickFrom( layout_.productsByTier[ Uniform( 0, tier - 2 ) ] ) ] += Uniform( 1, 40 );
+    }
+
+    QJsonArray materialsArray;
+    for ( const auto& [ typeId, quantity ] : materials )
+    {
+        QJsonObject material;
+        material[ "quantity" ] = static_cast< qint64 >( quantity );
+        material[ "typeID" ] = static_cast< qint64 >( typeId );
+        materialsArray.append( material );
+    }
+
+    QJsonObject product;
+    product[ "quantity" ] = tier == 1 && Uniform( 0, 9 ) == 0 ? 100 : 1;
+    product[ "typeID" ] = static_cast< qint64 >( blueprint.productId );
+
+    QJsonObject manufacturing;
+    manufacturing[ "materials" ] = materialsArray;
+    manufacturing[ "products" ] = QJsonArray{ product };
+    manufacturing[ "time" ] = static_cast< qint64 >( Uniform( 60, 3600 * tier ) );
+    return manufacturing;
+}
+
+QJsonObject SyntheticSdeGenerator::BuildInvention( const GeneratedBlueprint& blueprint )
+{
+    // Minerals stand in for the two datacores.
+    QJsonArray materialsArray;
+    for ( unsigned int i = 0; i < 2; ++i )
+    {
+        QJsonObject material;
+        material[ "quantity" ] = static_cast< qint64 >( Uniform( 1, 8 ) );
+        material[ "typeID" ] = static_cast< qint64 >( PickFrom( layout_.minerals ) );
+        materialsArray.append( material );
+    }
+
+    QJsonObject product;
+    product[ "probability" ] = 0.3;
+    product[ "quantity" ] = 10;
+    product[ "typeID" ] = static_cast< qint64 >( blueprint.inventedBlueprintId );
+
+    QJsonObject invention;
+    invention[ "materials" ] = materialsArray;
+    invention[ "products" ] = QJsonArray{ product };
+    invention[ "time" ] = static_cast< qint64 >( Uniform( 3600, 3600 * 18 ) );
+    return invention;
+}
+
+bool SyntheticSdeGenerator::WriteGroups( const QString& filePath )
+{
+    QFile file;
+    if ( !OpenForWriting( filePath, file ) )
+        return false;
+    for ( const GeneratedGroup& group : groups_ )
+    {
+        QJsonObject line;
+        line[ "_key" ] = static_cast< qint64 >( group.groupId );
+        line[ "anchorable" ] = false;
+        line[ "anchored" ] = false;
+        line[ "categoryID" ] = static_cast< qint64 >( group.categoryId );
+        line[ "fittableNonSingleton" ] = false;
+        line[ "name" ] = BuildLocalizedText( QString( "Synthetic Group %1" ).arg( group.groupId ) );
+        line[ "published" ] = true;
+        line[ "useBasePrice" ] = Uniform( 0, 1 ) == 1;
+        if ( !WriteLine( file, line ) )
+            return false;
+    }
+    return true;
+}
+
+bool SyntheticSdeGenerator::WriteTypes( const QString& filePath )
+{
+    QFile file;
+    if ( !OpenForWriting( filePath, file ) )
+        return false;
+    for ( const GeneratedType& type : types_ )
+    {
+        QJsonObject line;
+        line[ "_key" ] = static_cast< qint64 >( type.typeId );
+        if ( Uniform( 0, 3 ) != 0 )
+            line[ "basePrice" ] = Uniform( 1, 100000000 ) / 100.0;
+        line[ "description" ] = BuildLocalizedText( BuildDescription() );
+        line[ "groupID" ] = static_cast< qint64 >( type.groupId );
+        line[ "iconID" ] = static_cast< qint64 >( Uniform( 1, 25000 ) );
+        line[ "mass" ] = Uniform( 1, 1000000000 ) / 10.0;
+        if ( type.isPublished )
+            line[ "marketGroupID" ] = static_cast< qint64 >( Uniform( 1, 2500 ) );
+        line[ "name" ] = BuildLocalizedText( QString( "Synthetic Type %1" ).arg( type.typeId ) );
+        line[ "portionSize" ] = 1;
+        line[ "published" ] = type.isPublished;
+        line[ "volume" ] = Uniform( 1, 10000000 ) / 100.0;
+        if ( !WriteLine( file, line ) )
+            return false;
+    }
+    return true;
+}
+
+bool SyntheticSdeGenerator::WriteBlueprints( const QString& filePath )
+{
+    QFile file;
+    if ( !OpenForWriting( filePath, file ) )
+        return false;
+    for ( const GeneratedBlueprint& blueprint : blueprints_ )
+    {
+        const qint64 baseTime = Uniform( 60, 3600 );
+        QJsonObject activities;
+        activities[ "copying" ] = QJsonObject{ { "time", baseTime * 4 / 5 } };
+        if ( blueprint.inventedBlueprintId != 0 )
+            activities[ "invention" ] = BuildInvention( blueprint );
+        activities[ "manufacturing" ] = BuildManufacturing( blueprint );
+        activities[ "research_material" ] = QJsonObject{ { "time", baseTime * 2 } };
+        activities[ "research_time" ] = QJsonObject{ { "time", baseTime * 2 } };
+
+        QJsonObject line;
+        line[ "_key" ] = static_cast< qint64 >( blueprint.blueprintId );
+        line[ "activities" ] = activities;
+        line[ "blueprintTypeID" ] = static_cast< qint64 >( blueprint.blueprintId );
+        line[ "maxProductionLimit" ] = static_cast< qint64 >( Uniform( 1, 300 ) );
+        if ( !WriteLine( file, line ) )
+            return false;
+    }
+    return true;
+}
+
+bool SyntheticSdeGenerator::WriteTypeMaterials( const QString& filePath )
+{
+    QFile file;
+    if ( !OpenForWriting( filePath, file ) )
+        return false;
+
+    auto writeMaterials = [ this, &file ]( tTypeId typeId, unsigned int materialCount, unsigned int maxQuantity )
+    {
+        std::map< tTypeId, unsigned int > materials;
+        for ( unsigned int i = 0; i < materialCount; ++i )
+            materials[ PickFrom( layout_.minerals ) ] += Uniform( 1, maxQuantity );
+
+        QJsonArray materialsArray;
+        for ( const auto& [ materialTypeId, quantity ] : materials )
+        {
+            QJsonObject material;
+            material[ "materialTypeID" ] = static_cast< qint64 >( materialTypeId );
+            material[ "quantity" ] = static_cast< qint64 >( quantity );
+            materialsArray.append( material );
+        }
+        QJsonObject line;
+        line[ "_key" ] = static_cast< qint64 >( typeId );
+        line[ "materials" ] = materialsArray;
+        return WriteLine( file, line );
+    };
+
+    for ( const tTypeId oreId : layout_.ores )
+    {
+        if ( !writeMaterials( oreId, Uniform( 2, 4 ), 400 ) )
+            return false;
+    }
+    for ( const tTypeId typeId : reprocessableTypes_ )
+    {
+        if ( !writeMaterials( typeId, Uniform( 1, 3 ), 100 ) )
+            return false;
+    }
+    return true;
+}
+
+bool SyntheticSdeGenerator::OpenForWriting( const QString& filePath, QFile& file )
+{
+    file.setFileName( filePath );
+    if ( file.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+        return true;
+    lastError_ = QString( "Could not open %1 for writing" ).arg( filePath );
+    return false;
+}
+
+bool SyntheticSdeGenerator::WriteLine( QFile& file, const QJsonObject& line )
+{
+    const QByteArray data = QJsonDocument( line ).toJson( QJsonDocument::Compact ) + '\n';
+    if ( file.write( data ) == data.size() )
+        return true;
+    lastError_ = QString( "Could not write to %1" ).arg( file.fileName() );
+    return false;
+}
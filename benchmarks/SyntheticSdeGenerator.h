@@ -0,0 +1,96 @@
+#pragma once
+#include "HelperTypes.h"
+
+#include <QString>
+
+#include <array>
+#include <random>
+#include <vector>
+
+class QFile;
+class QJsonObject;
+
+struct SyntheticSdeOptions
+{
+    unsigned int scale = 1; // 1 is roughly a tenth of the real SDE.
+    unsigned int seed = 42;
+};
+
+// Ids of the generated entities, so benchmarks can pick blueprints of a given depth without parsing the files back.
+struct SyntheticSdeLayout
+{
+    static constexpr unsigned int TIER_COUNT = 4; // Tier 1 only uses minerals, tier 4 is capital-depth.
+
+    std::vector< tTypeId > minerals;
+    std::vector< tTypeId > ores;
+    std::array< std::vector< tTypeId >, TIER_COUNT > blueprintsByTier;
+    std::array< std::vector< tTypeId >, TIER_COUNT > productsByTier;
+};
+
+// Deterministic generator of the SDE subset the loader reads: types, blueprints, typeMaterials and groups in jsonl, zipped like the real one.
+// The same options always produce byte-identical files.
+class SyntheticSdeGenerator
+{
+public:
+    explicit SyntheticSdeGenerator( const SyntheticSdeOptions& options );
+
+    bool Generate( const QString& directoryPath );
+    bool WriteZip( const QString& directoryPath, const QString& zipPath );
+
+    const SyntheticSdeLayout& GetLayout() const;
+    const QString& GetLastError() const;
+
+private:
+    struct GeneratedGroup
+    {
+        tTypeId groupId = 0;
+        unsigned int categoryId = 0;
+    };
+
+    struct GeneratedType
+    {
+        tTypeId typeId = 0;
+        tTypeId groupId = 0;
+        bool isPublished = true;
+    };
+
+    struct GeneratedBlueprint
+    {
+        tTypeId blueprintId = 0;
+        tTypeId productId = 0;
+        unsigned int tier = 0; // 0 for blueprints that the loader filters out.
+        tTypeId inventedBlueprintId = 0;
+    };
+
+    void BuildLayout();
+    tTypeId AddType( tTypeId groupId, bool isPublished );
+    tTypeId PickFrom( const std::vector< tTypeId >& typeIds );
+    unsigned int Uniform( unsigned int min, unsigned int max );
+    QJsonObject BuildLocalizedText( const QString& englishText ) const;
+    QString BuildDescription();
+    QJsonObject BuildManufacturing( const GeneratedBlueprint& blueprint );
+    QJsonObject BuildInvention( const GeneratedBlueprint& blueprint );
+
+    bool WriteGroups( const QString& filePath );
+    bool WriteTypes( const QString& filePath );
+    bool WriteBlueprints( const QString& filePath );
+    bool WriteTypeMaterials( const QString& filePath );
+    bool OpenForWriting( const QString& filePath, QFile& file );
+    bool WriteLine( QFile& file, const QJsonObject& line );
+
+private:
+    SyntheticSdeOptions options_;
+    std::mt19937 random_;
+    SyntheticSdeLayout layout_;
+    std::vector< GeneratedGroup > groups_;
+    std::vector< tTypeId > oreGroups_;
+    std::vector< tTypeId > blueprintGroups_;
+    std::vector< tTypeId > productGroups_;
+    std::vector< tTypeId > fillerGroups_;
+    std::vector< GeneratedType > types_;
+    std::vector< GeneratedBlueprint > blueprints_;
+    std::vector< tTypeId > reprocessableTypes_;
+    tTypeId nextTypeId_ = 0;
+    tTypeId nextGroupId_ = 0;
+    QString lastError_;
+};
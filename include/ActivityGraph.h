@@ -0,0 +1,80 @@
+#pragma once
+#include "HelperTypes.h"
+
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+class Blueprint;
+
+enum class eActivityEdge : uint8_t
+{
+    Blueprint, // The blueprint the activity runs on.
+    Material,
+    Product
+};
+
+struct ActivityEdge
+{
+    uint32_t typeIndex = 0;
+    unsigned int quantity = 0;
+    eActivityEdge kind = eActivityEdge::Material;
+};
+
+struct ActivityNode
+{
+    tTypeId blueprintId = 0;
+    eIndustryActivity activity = eIndustryActivity::Manufacturing;
+    unsigned int timeInSeconds = 0;
+    double probability = 1.0; // Of success, below 1 for invention only.
+};
+
+// Every activity of every blueprint, linked to the types it consumes and produces.
+// Types and activities get dense indexes, all adjacency is stored in CSR form: one offsets array and one flat edge array
+// per direction. A T2 item is reached from its blueprint's manufacturing activity, whose blueprint is in turn the product of
+// the invention activity of the T1 blueprint; composite materials lead to reaction activities the same way.
+// Built once from the final blueprints, read only afterwards and safe to share between threads.
+class ActivityGraph
+{
+public:
+    ActivityGraph() = default;
+    ~ActivityGraph() = default;
+
+    void Build( const TypeIdMap< Blueprint >& blueprints );
+
+    size_t GetTypeCount() const;
+    size_t GetActivityCount() const;
+    std::optional< uint32_t > FindType( tTypeId typeId ) const;
+    tTypeId GetTypeId( uint32_t typeIndex ) const;
+
+    const ActivityNode& GetActivity( uint32_t activityIndex ) const;
+    std::span< const ActivityEdge > GetInputs( uint32_t activityIndex ) const;
+    std::span< const ActivityEdge > GetOutputs( uint32_t activityIndex ) const;
+    // Activities with typeIndex among their outputs, or their inputs.
+    std::span< const uint32_t > GetProducers( uint32_t typeIndex ) const;
+    std::span< const uint32_t > GetConsumers( uint32_t typeIndex ) const;
+
+    std::optional< uint32_t > FindProducer( tTypeId typeId, eIndustryActivity activity ) const;
+    // The manufacturing or reaction activity building typeId, what a BOM expands through.
+    std::optional< uint32_t > FindProductionActivity( tTypeId typeId ) const;
+    // Units of typeIndex one run of the activity gives, 0 when it is not among its outputs.
+    unsigned int GetProducedQuantity( uint32_t activityIndex, uint32_t typeIndex ) const;
+
+private:
+    uint32_t InternType( tTypeId typeId );
+
+private:
+    std::vector< tTypeId > typeIds_;
+    std::unordered_map< tTypeId, uint32_t > typeIndexes_;
+    std::vector< ActivityNode > activities_;
+
+    std::vector< uint32_t > inputOffsets_; // One per activity plus the end of inputs_.
+    std::vector< ActivityEdge > inputs_;
+    std::vector< uint32_t > outputOffsets_;
+    std::vector< ActivityEdge > outputs_;
+    std::vector< uint32_t > producerOffsets_; // One per type plus the end of producers_.
+    std::vector< uint32_t > producers_;
+    std::vector< uint32_t > consumerOffsets_;
+    std::vector< uint32_t > consumers_;
+};
@@ -3,26 +3,33 @@
 #include "JsonEveInterface.h"
 #include "ManufacturingJob.h"
 
+#include <array>
 #include <memory>
 #include <vector>
 
 class QJsonObject;
+struct SdeBlueprintRecord;
 
 class Blueprint : public JsonEveInterface
 {
 public:
     Blueprint() = default;
     Blueprint( const QJsonObject& jsonData );
+    explicit Blueprint( const SdeBlueprintRecord& record );
     ~Blueprint() = default;
 
     void FromJsonObject( const QJsonObject& jsonData ) override;
-    QJsonObject ToJsonObject() const override;
+    void WriteJson( JsonlWriter& writer ) const override;
     void PostLoadingInitialization() override;
 
     const std::shared_ptr< ManufacturingJob > GetManufacturingJob() const;
+    // Manufacturing, or the reaction of a formula. Set on every valid blueprint.
+    const std::shared_ptr< ManufacturingJob > GetProductionJob() const;
+    // nullptr when the blueprint does not support activity.
+    const std::shared_ptr< ManufacturingJob > GetJob( eIndustryActivity activity ) const;
 
 private:
     double matEfficiency_ = 0.0;
     double timeEfficiency_ = 0.0;
-    std::shared_ptr< ManufacturingJob > manufacturingJob_ = nullptr;
+    std::array< std::shared_ptr< ManufacturingJob >, INDUSTRY_ACTIVITY_COUNT > jobs_;
 };
@@ -4,12 +4,10 @@
 
 #include <QGroupBox>
 
-#include <map>
-
-class QTreeWidget;
-class QTreeWidgetItem;
+class QTreeView;
 
 class Blueprint;
+class MaterialTreeModel;
 class RessourcesManager;
 
 class BlueprintMaterialRequirementDisplay : public QGroupBox
@@ -23,8 +21,6 @@ public slots:
     void SetBlueprint( const std::shared_ptr< const Blueprint > blueprint );
 
 private:
-    void AddMaterialsToTree( const std::shared_ptr< const Blueprint > blueprint, QTreeWidgetItem* parent );
-
-private:
-    QTreeWidget* materialsTree_;
+    QTreeView* materialsTree_;
+    MaterialTreeModel* materialsModel_;
 };
@@ -0,0 +1,45 @@
+#pragma once
+#include "HelperTypes.h"
+#include "LPHelper.h"
+#include "OreSolutionCache.h"
+
+#include <QMetaType>
+#include <QObject>
+#include <QThreadPool>
+
+#include <atomic>
+#include <memory>
+
+class Blueprint;
+
+// Runs the BOM expansion and the ore LP of a blueprint away from the GUI thread.
+// Each Submit starts a new generation, results of older generations are dropped and their solves interrupted.
+class BlueprintSolveExecutor : public QObject
+{
+    Q_OBJECT
+public:
+    // Solutions are kept in an LRU cache, persisted to solutionCachePath when it is not empty.
+    explicit BlueprintSolveExecutor( const QString& solutionCachePath = QString(), QObject* parent = nullptr );
+    ~BlueprintSolveExecutor() override;
+
+    quint64 Submit( const std::shared_ptr< const Blueprint > blueprint );
+    bool IsCurrentGeneration( quint64 generation ) const;
+
+signals:
+    void BomReady( quint64 generation, std::shared_ptr< const Blueprint > blueprint );
+    void OreSolutionReady( quint64 generation, const OreSolution& solution );
+    void OreSolveFailed( quint64 generation );
+
+private:
+    void Run( quint64 generation, const std::shared_ptr< const Blueprint > blueprint );
+
+private:
+    std::atomic< quint64 > generation_ = 0;
+    QThreadPool threadPool_;
+    const QString solutionCachePath_;
+    OreSolutionCache solutionCache_;
+    LPHelper blueprintRequirementSolver_; // Only used from the single thread of threadPool_.
+};
+
+Q_DECLARE_METATYPE( OreSolution )
+Q_DECLARE_METATYPE( std::shared_ptr< const Blueprint > )
@@ -0,0 +1,56 @@
+#pragma once
+#include "HelperTypes.h"
+
+#include <optional>
+#include <vector>
+
+class ActivityGraph;
+
+struct BuildOrBuySettings
+{
+    // Job fee = estimated item value of the job * ( systemCostIndex + facilityTax ).
+    double systemCostIndex = 0.05;
+    double facilityTax = 0.0;
+};
+
+struct BuildOrBuyDecision
+{
+    bool isBuilt = true;  // Also when neither the market nor the materials give a price, the BOM then expands as usual.
+    double unitCost = 0.0; // The cheapest of both, infinite when unknown.
+    double marketPrice = 0.0;
+    double buildCost = 0.0; // Per unit, materials at their own unitCost plus the job fee.
+};
+
+// Chooses, for every type of a BOM, between buying it and building it from its cheapest inputs.
+// Bottom-up dynamic programming over the activity graph: a type is solved once all its inputs are, and the result is kept
+// for the lifetime of the optimizer, so components shared across a chain or across requests are only priced once.
+// Not thread safe, one optimizer per thread.
+class BuildOrBuyOptimizer
+{
+public:
+    BuildOrBuyOptimizer( const BuildOrBuySettings& settings, unsigned int materialEfficiency );
+
+    // Solves typeId and everything below it.
+    BuildOrBuyDecision Solve( tTypeId typeId );
+    bool IsBuilt( tTypeId typeId );
+
+private:
+    enum class eNodeState : uint8_t
+    {
+        Unvisited,
+        Visiting,
+        Solved
+    };
+
+    std::optional< uint32_t > FindProductionActivity( uint32_t typeIndex ) const;
+    void SolveFrom( uint32_t rootIndex );
+    void SolveNode( uint32_t typeIndex, std::optional< uint32_t > activityIndex );
+
+private:
+    const ActivityGraph& graph_;
+    BuildOrBuySettings settings_;
+    double materialFactor_ = 1.0;
+    std::vector< eNodeState > states_; // Per type index of the graph.
+    std::vector< BuildOrBuyDecision > decisions_;
+    std::vector< double > adjustedPrices_;
+};
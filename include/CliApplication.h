@@ -0,0 +1,65 @@
+#pragma once
+#include "IndustryCalculator.h"
+#include "JobScheduler.h"
+#include "LPHelper.h"
+
+#include <QObject>
+#include <QSettings>
+
+#include <memory>
+#include <vector>
+
+class RessourcesManager;
+
+// Headless entry point: loads the data snapshot, reads production requests and prints BOMs, ore buy lists and profits.
+class CliApplication : public QObject
+{
+    Q_OBJECT
+public:
+    explicit CliApplication( QObject* parent = nullptr );
+    ~CliApplication() override;
+
+    static bool IsRequested( int argc, char** argv );
+
+public slots:
+    void Start();
+
+private slots:
+    void OnRessourcesReady();
+    void OnErrorOccured( const QString& errorMessage );
+
+private:
+    struct CliResult
+    {
+        ProductionEstimate estimate;
+        bool isOreSolved = false;
+        OreSolution oreSolution;
+        double oreCost = 0.0;
+        std::optional< ProductionSchedule > schedule;
+    };
+
+    bool ParseArguments();
+    bool ParseCharacters( const QString& characters );
+    bool ReadRequests();
+    bool ParseRequestLine( const QString& line, int lineNumber );
+    tTypeId FindBlueprintId( const QString& blueprint ) const;
+    std::vector< CliResult > ComputeResults() const;
+    QByteArray FormatAsJson( const std::vector< CliResult >& results ) const;
+    QByteArray FormatAsCsv( const std::vector< CliResult >& results ) const;
+    bool WriteOutput( const QByteArray& data ) const;
+    void Fail( const QString& errorMessage );
+
+private:
+    QSettings settings_;
+    std::unique_ptr< RessourcesManager > ressourcesManager_;
+    std::vector< QString > requestedBlueprints_;
+    std::vector< ProductionRequest > requests_;
+    QString inputPath_;
+    QString outputPath_;
+    QString outputFormat_;
+    bool isVerbose_ = false;
+    bool isIncludingInvention_ = false;
+    std::optional< BuildOrBuySettings > buildOrBuy_;
+    std::optional< SchedulerSettings > scheduler_;
+    QString inventoryPath_;
+};
@@ -3,8 +3,6 @@
 
 #include <QGroupBox>
 
-class Blueprint;
-
 class QTableWidget;
 
 class CompressedOreWidget : public QGroupBox
@@ -15,11 +13,11 @@ public:
     ~CompressedOreWidget() override = default;
 
 public slots:
-    void SetBlueprint( const std::shared_ptr< Blueprint > blueprint );
+    void Clear();
+    void SetOreSolution( const OreSolution& solution );
+    void SetSolveFailed();
 
 private:
-    const std::shared_ptr< Blueprint > blueprint_;
-    LPHelper blueprintRequirementSolver_;
     QTableWidget* compressedOreTable_;
     QTableWidget* leftoverTable_;
 };
@@ -1,6 +1,7 @@
 #pragma once
 #include "FileDownloader.h"
 #include "HelperTypes.h"
+#include "ProgressReporter.h"
 
 #include <QJsonObject>
 
@@ -20,14 +21,19 @@ public:
     ~DataLoader() override = default;
 
     void StartDataLoading();
+    void SetProgressReporter( std::shared_ptr< ProgressReporter > progress );
 
     QString GetSdeExtractedPath() const;
     QJsonObject&& GetMarketPricesJson();
+    // Milliseconds since epoch when the market prices were received.
+    qint64 GetMarketPricesTimestamp() const;
+    // Build of the SDE this version downloads, snapshots made from another build are rebuilt.
+    static qint64 GetSdeBuildNumber();
 
 signals:
     void MainDataLoadingStepChanged( eDataLoadingSteps step );
-    void SubDataLoadingStepChanged( int currentStep, int maxStep, const QString& description );
     void ErrorOccurred( const QString& errorMessage );
+    void LoadingBytesRead( qint64 bytes ); // Bytes downloaded or read by the current step, for the load telemetry.
     void DataLoadingFinished();
 
     void SdeDownloaded();
@@ -40,6 +46,7 @@ private slots:
     void ExtractSde();
     void ValidateSde();
     void DownloadMarketPrices();
+    void OnDownloadProgress( qint64 current, qint64 total );
 
 private:
     void MarketPricesDownloaded( QByteArray data );
@@ -52,6 +59,8 @@ private:
     FileDownloader* marketPricesDownloader_ = nullptr;
     eDataLoadingSteps currentDataLoadingStep_ = eDataLoadingSteps::Waiting;
     QJsonObject marketPricesJson_;
+    qint64 marketPricesTimestamp_ = 0;
+    std::shared_ptr< ProgressReporter > progress_;
 
     const QString sdeExtractedPath_;
     const QString sdeZipPath_;
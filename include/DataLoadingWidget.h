@@ -1,8 +1,13 @@
 #pragma once
 #include <QGroupBox>
 
+#include <memory>
+
 class QLabel;
 class QProgressBar;
+class QTimer;
+class ProgressReporter;
+struct ProgressSnapshot;
 
 class DataLoadingWidget : public QGroupBox
 {
@@ -11,14 +16,29 @@ public:
     DataLoadingWidget( QWidget* parent = nullptr );
     ~DataLoadingWidget() = default;
 
+    // The reporter is sampled on a timer while the widget is visible, the loading thread never signals progress.
+    void SetProgressReporter( std::shared_ptr< const ProgressReporter > progress );
+
 public slots:
-    void OnMainDataLoadingStepChanged( int currentStep, int maxStep, const QString& description );
-    void OnSubDataLoadingStepChanged( int currentStep, int maxStep, const QString& description );
     void OnErrorOccurred( const QString& errorMessage );
 
+protected:
+    void showEvent( QShowEvent* event ) override;
+    void hideEvent( QHideEvent* event ) override;
+
+private slots:
+    void RefreshProgress();
+
+private:
+    static void SetProgressBar( QProgressBar* progressBar, qint64 current, qint64 total );
+    void ShowThroughput( const ProgressSnapshot& snapshot );
+
 private:
+    std::shared_ptr< const ProgressReporter > progress_;
+    QTimer* refreshTimer_;
     QProgressBar* mainProgressBar_;
     QProgressBar* subProgressBar_;
     QLabel* mainProgressLabel_;
     QLabel* subProgressLabel_;
+    QLabel* throughputLabel_;
 };
@@ -5,6 +5,7 @@
 #include <string>
 
 class QJsonObject;
+struct SdeTypeRecord;
 
 struct MarketPrice
 {
@@ -17,10 +18,11 @@ class EveType : public JsonEveInterface
 public:
     EveType() = default;
     EveType( const QJsonObject& jsonData );
+    explicit EveType( const SdeTypeRecord& record );
     ~EveType() = default;
 
     void FromJsonObject( const QJsonObject& jsonData ) override;
-    QJsonObject ToJsonObject() const override;
+    void WriteJson( JsonlWriter& writer ) const override;
     void PostLoadingInitialization() override;
 
     std::string GetName() const;
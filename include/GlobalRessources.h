@@ -1,4 +1,5 @@
 #pragma once
+#include "ActivityGraph.h"
 #include "HelperTypes.h"
 
 class EveType;
@@ -27,6 +28,7 @@ public:
     static const TypeIdMap< EveType >& GetTypesMap();
     static const TypeIdMap< Blueprint >& GetBlueprintsMap();
     static const TypeIdMap< Ore >& GetOresMap();
+    static const ActivityGraph& GetActivityGraph();
 
     static const std::shared_ptr< EveType > GetTypeById( tTypeId typeId );
     static const std::shared_ptr< Blueprint > GetBlueprintById( tTypeId typeId );
@@ -50,4 +52,5 @@ private:
     TypeIdMap< EveType > types_;
     TypeIdMap< Blueprint > blueprints_;
     TypeIdMap< Ore > ores_;
+    ActivityGraph activityGraph_;
 };
@@ -1,2 +1,29 @@
 #pragma once
 #include "HelperTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+static constexpr uint64_t FNV1A_OFFSET_BASIS = 14695981039346656037ull;
+static constexpr uint64_t FNV1A_PRIME = 1099511628211ull;
+
+// FNV-1a, stable across runs and platforms so hashes can be persisted.
+inline uint64_t HashBytes( const void* data, size_t size, uint64_t seed = FNV1A_OFFSET_BASIS )
+{
+    const unsigned char* bytes = static_cast< const unsigned char* >( data );
+    uint64_t hash = seed;
+    for ( size_t i = 0; i < size; ++i )
+    {
+        hash ^= bytes[ i ];
+        hash *= FNV1A_PRIME;
+    }
+    return hash;
+}
+
+template < typename T >
+    requires std::is_trivially_copyable_v< T >
+inline uint64_t HashValue( const T& value, uint64_t seed = FNV1A_OFFSET_BASIS )
+{
+    return HashBytes( &value, sizeof( T ), seed );
+}
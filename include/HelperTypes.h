@@ -1,5 +1,9 @@
 #pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <string_view>
 #include <unordered_map>
 
 typedef unsigned int tTypeId;
@@ -19,6 +23,22 @@ struct WithQuantity
     }
 };
 
+// What a blueprint can be used for, the keys of its "activities" in the SDE.
+enum class eIndustryActivity : uint8_t
+{
+    Manufacturing,
+    Reaction,
+    Invention,
+    Copying,
+    ResearchMaterial,
+    ResearchTime,
+    Count
+};
+
+inline constexpr size_t INDUSTRY_ACTIVITY_COUNT = static_cast< size_t >( eIndustryActivity::Count );
+inline constexpr std::array< std::string_view, INDUSTRY_ACTIVITY_COUNT > INDUSTRY_ACTIVITY_KEYS = {
+    "manufacturing", "reaction", "invention", "copying", "research_material", "research_time" };
+
 enum class eDataLoadingSteps
 {
     Waiting,
@@ -27,9 +47,9 @@ enum class eDataLoadingSteps
     ValidatingSde,
     FetchingMarketPrices,
     LoadingJsonlFiles,
-    LoadingTypes,
     LoadingBlueprints,
     LoadingOres,
+    LoadingTypes, // After the blueprints and ores, which tell the types worth parsing.
     FilteringIrrelevantData,
     SavingFilteredJson,
     Finalizing,
@@ -0,0 +1,74 @@
+#pragma once
+#include "BuildOrBuyOptimizer.h"
+#include "HelperTypes.h"
+#include "InventionCalculator.h"
+
+#include <map>
+#include <memory>
+#include <optional>
+
+class Blueprint;
+class Inventory;
+
+struct ProductionRequest
+{
+    tTypeId blueprintId = 0;
+    unsigned int runs = 1;
+    unsigned int materialEfficiency = 0; // Percent, applied to the requested blueprint and to every manufactured component.
+    // When set, every invented blueprint of the chain is built from copies invented with its cheapest decryptor: their
+    // efficiency replaces materialEfficiency and the datacores and decryptors expected to be spent are added.
+    std::optional< InventionSkills > invention;
+    // When set, components cheaper on the market than built, job fees included, are bought instead of expanded.
+    std::optional< BuildOrBuySettings > buildOrBuy;
+    // Owned items, drawn from at every level of the chain: an owned component is not expanded, raw materials are only
+    // the deficit. Each estimate draws from its own copy.
+    std::shared_ptr< const Inventory > stock;
+};
+
+struct ProductionEstimate
+{
+    ProductionRequest request;
+    std::map< tTypeId, unsigned long long > rawMaterials;
+    std::map< tTypeId, unsigned long long > products;
+    std::map< tTypeId, unsigned long long > usedStock;
+    double materialCost = 0.0;
+    double productValue = 0.0;
+    std::optional< InventionOption > invention; // Chosen for the requested blueprint, when it is invented.
+
+    double GetProfit() const
+    {
+        return productValue - materialCost;
+    }
+};
+
+// Quantity-aware BOM expansion: components are built in whole runs of their own blueprint.
+class IndustryCalculator
+{
+public:
+    static constexpr unsigned int MAX_MATERIAL_EFFICIENCY = 10;
+    static constexpr unsigned int MAX_TIME_EFFICIENCY = 20;
+
+    static std::map< tTypeId, unsigned long long > ComputeRawMaterials( tTypeId blueprintId,
+                                                                        unsigned long long runs,
+                                                                        unsigned int materialEfficiency,
+                                                                        const std::optional< InventionSkills >& invention = std::nullopt,
+                                                                        BuildOrBuyOptimizer* buildOrBuy = nullptr,
+                                                                        Inventory* stock = nullptr );
+    static ProductionEstimate Estimate( const ProductionRequest& request );
+
+    static unsigned long long ApplyMaterialEfficiency( unsigned int baseQuantity, unsigned long long runs, unsigned int materialEfficiency );
+
+private:
+    // Expands the production job of blueprint, through manufactured and reacted components alike.
+    static void AddRawMaterials( const Blueprint& blueprint,
+                                 unsigned long long runs,
+                                 unsigned int materialEfficiency,
+                                 const std::optional< InventionSkills >& invention,
+                                 BuildOrBuyOptimizer* buildOrBuy,
+                                 Inventory* stock,
+                                 std::map< tTypeId, unsigned long long >& rawMaterials );
+    // Materials of the invention attempts needed for runs of the invented blueprint.
+    static void AddInventionMaterials( const InventionEstimate& estimate,
+                                       unsigned long long runs,
+                                       std::map< tTypeId, unsigned long long >& rawMaterials );
+};
@@ -1,9 +1,14 @@
 #pragma once
 #include <QWidget>
 
+#include <memory>
+
 class RessourcesManager;
+class Blueprint;
 class BlueprintMaterialRequirementDisplay;
+class BlueprintSolveExecutor;
 class CompressedOreWidget;
+struct OreSolution;
 
 class QComboBox;
 
@@ -18,7 +23,13 @@ public:
 private:
     QComboBox* BuildBlueprintsComboBox();
 
+private slots:
+    void OnBomReady( quint64 generation, std::shared_ptr< const Blueprint > blueprint );
+    void OnOreSolutionReady( quint64 generation, const OreSolution& solution );
+    void OnOreSolveFailed( quint64 generation );
+
 private:
     BlueprintMaterialRequirementDisplay* blueprintMaterialRequirementDisplay_;
     CompressedOreWidget* compressedOreWidget_;
+    BlueprintSolveExecutor* solveExecutor_;
 };
@@ -0,0 +1,62 @@
+#pragma once
+#include "HelperTypes.h"
+
+#include <optional>
+#include <span>
+#include <vector>
+
+struct InventionSkills
+{
+    unsigned int encryptionMethods = 5;
+    unsigned int firstScience = 5; // The two science skills required by the invention job.
+    unsigned int secondScience = 5;
+};
+
+// Inventing with one decryptor, or without any.
+struct InventionOption
+{
+    tTypeId decryptorId = 0; // 0 without decryptor.
+    double probability = 0.0;
+    unsigned int runsPerCopy = 0;
+    unsigned int materialEfficiency = 0; // Of the invented copies.
+    unsigned int timeEfficiency = 0;
+    double attemptCost = 0.0;         // Datacores and decryptor of one attempt.
+    double inventionCostPerRun = 0.0; // Expected, the failed attempts included.
+    double materialCostPerRun = 0.0;  // Manufacturing from an invented copy.
+
+    double GetCostPerRun() const
+    {
+        return inventionCostPerRun + materialCostPerRun;
+    }
+};
+
+struct InventionEstimate
+{
+    tTypeId blueprintId = 0;       // The invented T2 blueprint.
+    tTypeId sourceBlueprintId = 0; // The T1 blueprint it is invented from.
+    std::vector< WithQuantity< tTypeId > > attemptMaterials;
+    std::vector< InventionOption > options; // Without decryptor first, then one per decryptor.
+    size_t bestOption = 0;                  // Lowest cost per run.
+
+    const InventionOption& GetBestOption() const
+    {
+        return options[ bestOption ];
+    }
+};
+
+// Expected cost of T2 blueprint copies from the invention jobs of the activity graph and the market prices.
+// Every decryptor is evaluated at once: its modifiers are laid out as arrays, each step of the estimate is a loop over them.
+class InventionCalculator
+{
+public:
+    static constexpr unsigned int BASE_MATERIAL_EFFICIENCY = 2; // Of a copy invented without decryptor.
+    static constexpr unsigned int BASE_TIME_EFFICIENCY = 4;
+
+    // nullopt when blueprintId is not invented.
+    static std::optional< InventionEstimate > Estimate( tTypeId blueprintId, const InventionSkills& skills );
+    // Every invented blueprint, estimated in parallel and sorted by blueprint id.
+    static std::vector< InventionEstimate > EstimateAll( const InventionSkills& skills );
+
+    // Not materials of any activity, their types are kept for their market price.
+    static std::span< const tTypeId > GetDecryptorIds();
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include "HelperTypes.h"
+
+#include <QByteArray>
+#include <QString>
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ActivityGraph;
+
+// Owned quantities per type, what a plan draws from before anything is bought or built.
+// Types of the activity graph are stored densely by their graph index, the few others (ores, unrelated items) in a map.
+class Inventory
+{
+public:
+    Inventory();
+
+    // A .json file holds ESI assets, anything else is read as text.
+    bool LoadFromFile( const QString& filePath, std::string& error );
+    // The array returned by the ESI assets endpoints: objects with at least "type_id" and "quantity".
+    bool ParseEsiAssets( const QByteArray& data, std::string& error );
+    // One item per line, "typeId or name,quantity" or the tab separated lines of an asset list pasted from the game.
+    // Quantities may use thousands separators, a missing quantity counts as 1.
+    bool ParseText( const QString& text, std::string& error );
+
+    void Add( tTypeId typeId, unsigned long long quantity );
+    unsigned long long GetQuantity( tTypeId typeId ) const;
+    // Removes up to quantity of typeId, returns how many were available.
+    unsigned long long Take( tTypeId typeId, unsigned long long quantity );
+    bool IsEmpty() const;
+
+    // What Take removed until the last ClearTakenQuantities.
+    const std::map< tTypeId, unsigned long long >& GetTakenQuantities() const;
+    void ClearTakenQuantities();
+
+private:
+    unsigned long long* FindQuantity( tTypeId typeId );
+
+private:
+    const ActivityGraph* graph_ = nullptr;
+    std::vector< unsigned long long > quantities_; // Per type index of the graph.
+    std::unordered_map< tTypeId, unsigned long long > otherQuantities_;
+    std::map< tTypeId, unsigned long long > takenQuantities_;
+};
@@ -0,0 +1,67 @@
+#pragma once
+#include "HelperTypes.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+struct ProductionRequest;
+
+struct SchedulerCharacter
+{
+    std::string name;
+    unsigned int manufacturingSlots = 10;
+    unsigned int reactionSlots = 10;
+    unsigned int timeEfficiency = 20; // Percent, of the blueprints this character manufactures with.
+};
+
+struct SchedulerSettings
+{
+    std::vector< SchedulerCharacter > characters;
+    bool isRefiningWithMip = false;
+    size_t maxMipJobs = 40; // The MIP grows with the square of the job count, larger plans keep the heuristic schedule.
+    double mipTimeLimitSeconds = 10.0;
+};
+
+// One job of a build plan: every run of one blueprint activity the plan needs.
+struct PlannedJob
+{
+    tTypeId blueprintId = 0;
+    eIndustryActivity activity = eIndustryActivity::Manufacturing;
+    unsigned long long runs = 0;
+    unsigned int timePerRunSeconds = 0;
+    std::vector< size_t > dependencies; // Jobs building the components of this one, always earlier in the plan.
+};
+
+struct ScheduledJob
+{
+    size_t character = 0;
+    size_t slot = 0; // Among the slots of the character for the activity of the job.
+    double startSeconds = 0.0;
+    double endSeconds = 0.0;
+};
+
+struct ProductionSchedule
+{
+    std::vector< PlannedJob > plan;
+    std::vector< ScheduledJob > jobs; // Parallel to plan.
+    double makespanSeconds = 0.0;
+    bool isMipRefined = false;
+};
+
+// Places the jobs of a build plan on the manufacturing and reaction slots of a set of characters.
+// List scheduling: ready jobs are taken longest remaining chain first and each goes on the slot where it finishes earliest.
+// The result can then be refined by a disjunctive MIP, warm started from it, on plans small enough for it.
+class JobScheduler
+{
+public:
+    // The jobs needed to fulfill request, components first. Follows its build or buy settings and its stock, not its invention.
+    static std::vector< PlannedJob > BuildPlan( const ProductionRequest& request );
+    // Empty when a job has no character with a slot for its activity.
+    static std::optional< ProductionSchedule > Schedule( std::vector< PlannedJob > plan, const SchedulerSettings& settings );
+
+    static double GetDuration( const PlannedJob& job, const SchedulerCharacter& character );
+
+private:
+    static bool RefineWithMip( ProductionSchedule& schedule, const SchedulerSettings& settings );
+};
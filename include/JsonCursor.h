@@ -0,0 +1,163 @@
+#pragma once
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Forward only JSON reader working in place on a buffer, nothing is allocated except for strings with escape sequences.
+// Values are read or skipped one at a time, in document order, so no tree is ever built.
+// Read() ignores values of an unexpected type (null included) after consuming them and leaves the target untouched;
+// every method only returns false on malformed JSON, with the reason in GetError().
+// Skipped objects and arrays are only checked for balanced brackets and terminated strings.
+class JsonCursor
+{
+public:
+    explicit JsonCursor( std::string_view text );
+
+    // Next significant character without consuming it, '\0' at the end of the text.
+    char Peek();
+    bool IsNumber();
+    bool IsString();
+    bool IsNull();
+
+    bool Read( bool& value );
+    bool Read( double& value );
+    bool Read( std::string& value );
+    // Views the input, or an internal buffer for strings with escape sequences, only valid until the next string is read.
+    bool Read( std::string_view& value );
+    template < std::integral T >
+    bool Read( T& value );
+    template < typename T >
+    bool Read( std::optional< T >& value );
+    bool SkipValue();
+
+    // onMember( std::string_view key ) must consume the member's value. key is only valid until then.
+    template < typename TOnMember >
+    bool ForEachMember( TOnMember&& onMember );
+    // onElement() must consume the element.
+    template < typename TOnElement >
+    bool ForEachElement( TOnElement&& onElement );
+    // Enters the object and reads its first key, leaving the cursor on that member's value. The rest of the object is not
+    // read, this is for looking at a leading identifier before deciding whether the whole value is worth parsing.
+    // Returns false when the value is not an object or is empty.
+    bool ReadFirstKey( std::string_view& key );
+
+    // Only whitespace left.
+    bool ExpectEnd();
+    std::string GetError() const;
+
+private:
+    void SkipWhitespace();
+    bool Consume( char expected );
+    bool Fail( const char* reason );
+    // Whether the next value is of a type Read( T& ) accepts.
+    template < typename T >
+    bool IsReadable();
+    bool ReadInteger( int64_t& value );
+    bool ReadStringView( std::string_view& text, std::string& buffer );
+    bool ReadUnicodeEscape( std::string& buffer );
+    bool ReadNumberToken( std::string_view& token );
+    bool SkipString();
+    bool SkipContainer();
+    bool SkipLiteral( std::string_view literal );
+
+private:
+    const char* begin_ = nullptr;
+    const char* current_ = nullptr;
+    const char* end_ = nullptr;
+    const char* error_ = nullptr;
+    size_t errorOffset_ = 0;
+    std::string keyBuffer_;
+    std::string stringBuffer_;
+};
+
+template < std::integral T >
+bool JsonCursor::Read( T& value )
+{
+    if ( !IsNumber() )
+        return SkipValue();
+    int64_t integer = 0;
+    if ( !ReadInteger( integer ) )
+        return false;
+    value = static_cast< T >( integer );
+    return true;
+}
+
+template < typename T >
+bool JsonCursor::Read( std::optional< T >& value )
+{
+    if ( !IsReadable< T >() )
+        return SkipValue();
+    T read{};
+    if ( !Read( read ) )
+        return false;
+    value = std::move( read );
+    return true;
+}
+
+template < typename T >
+bool JsonCursor::IsReadable()
+{
+    if constexpr ( std::same_as< T, bool > )
+        return Peek() == 't' || Peek() == 'f';
+    else if constexpr ( std::integral< T > || std::floating_point< T > )
+        return IsNumber();
+    else
+        return IsString();
+}
+
+template < typename TOnMember >
+bool JsonCursor::ForEachMember( TOnMember&& onMember )
+{
+    if ( Peek() != '{' )
+        return SkipValue();
+    ++current_;
+    if ( Peek() == '}' )
+    {
+        ++current_;
+        return true;
+    }
+    while ( true )
+    {
+        std::string_view key;
+        if ( !ReadStringView( key, keyBuffer_ ) || !Consume( ':' ) || !onMember( key ) )
+            return false;
+        const char next = Peek();
+        if ( next == '}' )
+        {
+            ++current_;
+            return true;
+        }
+        if ( next != ',' )
+            return Fail( "Expected ',' or '}'" );
+        ++current_;
+    }
+}
+
+template < typename TOnElement >
+bool JsonCursor::ForEachElement( TOnElement&& onElement )
+{
+    if ( Peek() != '[' )
+        return SkipValue();
+    ++current_;
+    if ( Peek() == ']' )
+    {
+        ++current_;
+        return true;
+    }
+    while ( true )
+    {
+        if ( !onElement() )
+            return false;
+        const char next = Peek();
+        if ( next == ']' )
+        {
+            ++current_;
+            return true;
+        }
+        if ( next != ',' )
+            return Fail( "Expected ',' or ']'" );
+        ++current_;
+    }
+}
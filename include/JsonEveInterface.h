@@ -3,6 +3,7 @@
 
 #include <QString>
 
+class JsonlWriter;
 class QJsonObject;
 
 class JsonEveInterface
@@ -17,7 +18,8 @@ public:
     }
 
     virtual void FromJsonObject( const QJsonObject& obj ) = 0;
-    virtual QJsonObject ToJsonObject() const = 0;
+    // One JSON object that FromJsonObject() reads back, written without building a QJsonObject.
+    virtual void WriteJson( JsonlWriter& writer ) const = 0;
     virtual void PostLoadingInitialization() = 0; // Actions to perform after all json loading is done.
 
     bool IsValid() const;
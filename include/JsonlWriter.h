@@ -0,0 +1,58 @@
+#pragma once
+#include <concepts>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Appends JSON text straight to a buffer, without building a document, the writing counterpart of JsonCursor.
+// Values are written in document order, commas are inserted as needed; the caller is responsible for balancing
+// BeginObject/EndObject and BeginArray/EndArray and for giving a key to every object member.
+class JsonlWriter
+{
+public:
+    explicit JsonlWriter( std::string& buffer );
+
+    void BeginObject();
+    void EndObject();
+    void BeginArray();
+    void EndArray();
+    void Key( std::string_view key );
+
+    void Write( bool value );
+    void Write( double value );
+    void Write( std::string_view value );
+    void Write( const char* value ); // Would otherwise convert to bool.
+    template < std::integral T >
+    void Write( T value );
+
+    template < typename T >
+    void Member( std::string_view key, const T& value );
+
+    // Ends the current top level value, the next one starts a new line.
+    void EndLine();
+
+private:
+    void BeforeValue();
+    void WriteInteger( long long value );
+    void WriteUnsigned( unsigned long long value );
+
+private:
+    std::string& buffer_;
+    bool needsComma_ = false;
+};
+
+template < std::integral T >
+void JsonlWriter::Write( T value )
+{
+    if constexpr ( std::is_signed_v< T > )
+        WriteInteger( value );
+    else
+        WriteUnsigned( value );
+}
+
+template < typename T >
+void JsonlWriter::Member( std::string_view key, const T& value )
+{
+    Key( key );
+    Write( value );
+}
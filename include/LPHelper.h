@@ -1,32 +1,60 @@
 #pragma once
 #include "HelperTypes.h"
 
+#include <functional>
 #include <map>
 
 #include <highs/Highs.h>
 
 class Ore;
 class Blueprint;
+class OreSolutionCache;
+struct OreSolutionKey;
+
+struct OreSolution
+{
+    std::map< tTypeId, unsigned int > compressedOres;
+    std::map< tTypeId, unsigned int > leftover;
+    std::map< tTypeId, unsigned int > ownedOres; // Drawn from the stock, refined along with the bought ones.
+};
 
 class LPHelper
 {
 public:
+    static constexpr double ORE_REFINING_BATCH_SIZE = 100.0;
+    static constexpr double OWNED_ORE_COST = 1e-3; // Token cost per unit, owned ores are used only as far as they are needed.
+
     LPHelper( const TypeIdMap< Ore >& ores );
     ~LPHelper() = default;
 
-    bool SolveForBlueprint( const Blueprint& blueprint );
+    // Solutions are looked up in and stored into the cache when one is set.
+    void SetSolutionCache( OreSolutionCache* solutionCache );
+    // Ores the next solves may refine before buying any, up to the owned quantity. Ores the solver does not know are ignored.
+    void SetOwnedOres( const std::map< tTypeId, unsigned long long >& ownedOres );
+
+    // shouldAbort is polled by the solver, returning true interrupts the solve and makes it fail.
+    bool SolveForBlueprint( const Blueprint& blueprint, const std::function< bool() >& shouldAbort = {} );
+    bool SolveForRequirements( const std::map< tTypeId, unsigned int >& requirements, const std::function< bool() >& shouldAbort = {} );
     const std::map< tTypeId, unsigned int >& GetResult() const;
     const std::map< tTypeId, unsigned int >& GetLeftover() const;
+    OreSolution GetSolution() const;
 
 private:
-    HighsLp BuildHighsLp( const Blueprint& blueprint ) const;
+    OreSolutionKey BuildSolutionKey( const std::map< tTypeId, unsigned int >& oreRequirements ) const;
+    bool RunSolver( const std::map< tTypeId, unsigned int >& oreRequirements, const std::function< bool() >& shouldAbort );
+    HighsLp BuildHighsLp() const;
     std::map< tTypeId, double > ComputeTotalProduced() const;
-    void ComputeLeftover( std::map< tTypeId, double >& produced, const Blueprint& blueprint );
+    void ComputeLeftover( std::map< tTypeId, double >& produced, const std::map< tTypeId, unsigned int >& oreRequirements );
 
 private:
     const TypeIdMap< Ore >& ores_;
+    OreSolutionCache* solutionCache_ = nullptr;
+    uint64_t pricesVersion_ = 0;
+    uint64_t yieldsVersion_ = 0;
     std::map< tTypeId, unsigned int > lpResult_;
     std::map< tTypeId, unsigned int > leftover_;
+    std::map< tTypeId, unsigned long long > ownedOres_;
+    std::map< tTypeId, unsigned int > ownedOresUsed_;
 
     std::vector< double > lowerBounds_;
     std::vector< double > upperBounds_;
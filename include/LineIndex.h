@@ -0,0 +1,59 @@
+#pragma once
+#include <QByteArray>
+#include <QFile>
+
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class QFileInfo;
+
+// Read only view of a whole file, memory mapped when possible and read into memory otherwise.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile( const MappedFile& ) = delete;
+    MappedFile& operator=( const MappedFile& ) = delete;
+
+    // file must be open for reading and outlive the mapping.
+    bool Map( QFile& file );
+    std::string_view GetData() const;
+
+private:
+    QFile* file_ = nullptr;
+    uchar* mapping_ = nullptr;
+    QByteArray buffer_;
+    std::string_view data_;
+};
+
+// Start offsets of every line of a text file, found in a single vectorized pass over its content.
+// Tagged with the size and modification time of the file it was built from, IsUpToDate() tells when it must be rebuilt.
+class LineIndex
+{
+public:
+    using tLineRange = std::pair< qint64, qint64 >; // [first, last) line numbers.
+
+    LineIndex() = default;
+    ~LineIndex() = default;
+
+    // data must be the whole content of the file described by fileInfo.
+    void Build( std::string_view data, const QFileInfo& fileInfo );
+    bool IsUpToDate( const QFileInfo& fileInfo ) const;
+
+    qint64 GetLineCount() const;
+    // Line without its line ending, data must be the content the index was built from.
+    std::string_view GetLine( std::string_view data, qint64 line ) const;
+    // At most chunkCount ranges of consecutive lines holding about the same number of bytes.
+    std::vector< tLineRange > Split( int chunkCount ) const;
+
+    // Appends the offset following every '\n' of data, SSE2 or AVX2 on x86, scalar elsewhere.
+    static void AppendLineBreaks( std::string_view data, std::vector< qint64 >& offsets );
+
+private:
+    qint64 fileSize_ = -1;
+    qint64 lastModifiedMs_ = 0;
+    std::vector< qint64 > lineStarts_; // One per line plus the end of the data.
+};
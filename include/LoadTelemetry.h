@@ -0,0 +1,69 @@
+#pragma once
+#include "HelperTypes.h"
+
+#include <QString>
+
+#include <chrono>
+#include <optional>
+#include <vector>
+
+struct LoadStageMetrics
+{
+    eDataLoadingSteps step = eDataLoadingSteps::Waiting;
+    QString name;
+    double wallSeconds = 0.0;
+    double cpuSeconds = 0.0; // Whole process, a stage waiting on I/O or the network has a low cpu / wall ratio.
+    qint64 bytesRead = 0;
+    qint64 bytesWritten = 0;
+    qint64 recordsParsed = 0;
+    qint64 peakRssBytes = 0;
+};
+
+struct LoadThroughput
+{
+    double bytesPerSecond = 0.0;
+    double recordsPerSecond = 0.0;
+    std::optional< double > etaSeconds; // Empty without a previous load that went through the current stage.
+};
+
+// Records per-stage metrics of one ressources load and keeps the last runs in a JSON lines file, used to estimate the remaining time.
+// Not thread safe, used from the loading thread only.
+class LoadTelemetry
+{
+public:
+    static constexpr int MAX_HISTORY_RUNS = 20;
+    // Stages are stored by their eDataLoadingSteps value: bump this whenever the steps are renumbered, older runs are then dropped.
+    static constexpr int HISTORY_VERSION = 1;
+
+    LoadTelemetry() = default;
+    ~LoadTelemetry() = default;
+
+    LoadTelemetry( const LoadTelemetry& ) = delete;
+    LoadTelemetry& operator=( const LoadTelemetry& ) = delete;
+
+    // Ends the current stage, if any, and starts measuring the given one.
+    void BeginStage( eDataLoadingSteps step, const QString& name );
+    void EndStage();
+    void AddBytesRead( qint64 bytes );
+    void AddBytesWritten( qint64 bytes );
+    void AddRecordsParsed( qint64 records );
+
+    // progress is the completed fraction of the current stage, 0 when unknown. The current stage is extrapolated from it when known,
+    // the stages after it take as long as in the latest run that went through the current stage.
+    LoadThroughput GetThroughput( double progress ) const;
+    const std::vector< LoadStageMetrics >& GetStages() const;
+
+    bool LoadHistory( const QString& filePath );
+    bool AppendToHistory( const QString& filePath ) const;
+    void LogSummary() const;
+
+    static qint64 GetPeakRssBytes();
+    static double GetProcessCpuSeconds();
+
+private:
+    std::vector< LoadStageMetrics > stages_;
+    std::vector< std::vector< LoadStageMetrics > > history_; // Oldest first.
+    std::optional< LoadStageMetrics > currentStage_;
+    std::chrono::steady_clock::time_point stageStartTime_;
+    double stageStartCpuSeconds_ = 0.0;
+};
@@ -1,8 +1,11 @@
 #ifndef LOG_MANAGER_H
 #define LOG_MANAGER_H
 
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
 #include <ctime>
-#include <filesystem>
+#include <deque>
 #include <filesystem>
 #include <fstream>
 #include <functional>
@@ -17,6 +20,10 @@
 #include "fmt/ranges.h"
 #include "fmt/chrono.h"
 
+#include "LogRecord.h"
+#include "MpscQueue.h"
+#include "Profiler.h"
+
 enum class e_Loglevel
 {
     LOG_NONE,
@@ -29,27 +36,14 @@ enum class e_Loglevel
 
 static constexpr unsigned int MICROSECONDS_IN_MINUTE = 60000000;
 
-template< typename T >
-constexpr uint8_t GetDatatype()
-{
-    if constexpr ( std::is_same_v< T, unsigned long > || std::is_same_v< T, unsigned int > )
-        return 1;
-    else if constexpr ( std::is_same_v< T, long > || std::is_same_v< T, int > )
-        return 2;
-    else if constexpr ( std::is_same_v< T, double > || std::is_same_v< T, float > )
-        return 3;
-    else
-        return 0;
-}
-
 inline void
-DeleteOldestFiles( const std::filesystem::path& directoryPath )
+DeleteOldestFiles( const std::filesystem::path& directoryPath, const std::string& extension = ".txt" )
 {
     static constexpr int maxLogFiles = 20;
     std::vector< std::filesystem::directory_entry > files;
     for ( const auto& file : std::filesystem::directory_iterator( directoryPath ) )
     {
-        if ( file.is_regular_file() && file.path().extension() == ".txt" )
+        if ( file.is_regular_file() && file.path().extension() == extension )
             files.push_back( file );
     }
 
@@ -73,14 +67,14 @@ DeleteOldestFiles( const std::filesystem::path& directoryPath )
     }
 }
 
-inline std::string CreateLogFile()
+inline std::string CreateLogFile( const std::string& extension = ".txt" )
 {
     if ( !std::filesystem::is_directory( "Logs" ) || !std::filesystem::exists( "Logs" ) )
         std::filesystem::create_directory( "Logs" );
 
-    DeleteOldestFiles( "Logs/" );
+    DeleteOldestFiles( "Logs/", extension );
     std::time_t currentTime = std::time( nullptr );
-    return fmt::format( "Logs/log_{:%Y-%m-%d_%H-%M}.txt", fmt::localtime( currentTime ) );
+    return fmt::format( "Logs/log_{:%Y-%m-%d_%H-%M}{}", fmt::localtime( currentTime ), extension );
 }
 
 inline constexpr std::string_view RemoveReturnTypeFromFunctionName( const char* functionName )
@@ -105,8 +99,9 @@ inline void ClearAllSeparatorsFromLine( std::string& line, const std::string& se
     size_t pos = 0;
     while ( ( pos = line.find( separator, pos ) ) != std::string::npos )
         line.erase( pos, separator.length() );
+    pos = 0;
     while ( ( pos = line.find( '\n', pos ) ) != std::string::npos )
-        line.erase( pos, separator.length() );
+        line.erase( pos, 1 );
 }
 
 inline std::string LogLevelToString( e_Loglevel level )
@@ -128,10 +123,34 @@ inline std::string LogLevelToString( e_Loglevel level )
     }
 }
 
+// Static description of one LOG macro, registered the first time the macro runs. The id is what the binary log refers to.
+struct LogCallsite
+{
+    uint32_t id = 0;
+    e_Loglevel level = e_Loglevel::LOG_NONE;
+    const char* fullFunctionName = "";
+    int line = 0;
+    std::string_view format; // Points to the literal of the call site.
+};
+
+// One queued message. Either message holds the formatted text, or arguments hold a record formatted by the logging thread.
+struct LogEntry
+{
+    std::atomic< LogEntry* > next = nullptr;
+    std::chrono::system_clock::time_point time;
+    const LogCallsite* callsite = nullptr;
+    std::string arguments;
+    std::string message;
+    bool isFormatted = false;
+};
+
 class LogManager
 {
 public:
-    ~LogManager() = default;
+    ~LogManager()
+    {
+        TerminateThread();
+    }
     LogManager( const LogManager& ) = delete;
     static LogManager& Get()
     {
@@ -142,7 +161,12 @@ public:
 
     inline static void IgnoreLogLevelBelow( e_Loglevel logLevel )
     {
-        Get().LogLevelIgnoredBelow_ = logLevel;
+        Get().LogLevelIgnoredBelow_.store( logLevel, std::memory_order_relaxed );
+    }
+
+    inline static bool IsLevelEnabled( e_Loglevel level )
+    {
+        return level >= Get().LogLevelIgnoredBelow_.load( std::memory_order_relaxed ) || level == e_Loglevel::LOG_LETHAL;
     }
 
     inline static void AddCallbackForLogLevel( e_Loglevel logLevel, std::function< void( std::string ) > function )
@@ -150,16 +174,23 @@ public:
         Get().callbackFunctions_[ static_cast< int >( logLevel ) ] = function;
     }
 
+    // Called once per LOG macro through a function-local static. The returned callsite lives as long as the manager.
+    inline static const LogCallsite* RegisterCallsite( e_Loglevel level, const char* fullFunctionName, int line, std::string_view format )
+    {
+        return Get().IRegisterCallsite( level, fullFunctionName, line, format );
+    }
+
+    // The format string is checked against the arguments at compile time. The macros check the level before anything is formatted or copied.
     template< typename... Args >
-    inline static void LogError( bool condition, const char* fullFunctionName, int line, e_Loglevel level, const char* message, Args&&... args )
+    inline static void LogError( const LogCallsite& callsite, fmt::format_string< Args... > message, Args&&... args )
     {
-        Get().ILogError( condition, fullFunctionName, line, level, message, std::forward< Args >( args )... );
+        Get().ILogError( callsite, message, std::forward< Args >( args )... );
     }
 
     template< typename... Args >
-    inline static std::string FormatToString( const char* stringToFormat, Args&&... args )
+    inline static std::string FormatToString( fmt::format_string< Args... > stringToFormat, Args&&... args )
     {
-        return Get().IFormatToString( stringToFormat, std::forward< Args >( args )... );
+        return fmt::format( stringToFormat, std::forward< Args >( args )... );
     }
 
     inline static std::string GetSeparator()
@@ -167,6 +198,37 @@ public:
         return Get().separator_;
     }
 
+    inline static void SetConsoleOutputEnabled( bool isEnabled )
+    {
+        Get().isConsoleOutputEnabled_ = isEnabled;
+    }
+
+    // Writes Logs/log_<date>.bin instead of the text file, decoded offline by LogDecoder. Also enabled by the EOMULTITOOL_BINARY_LOG environment variable.
+    inline static void SetBinaryOutputEnabled( bool isEnabled )
+    {
+        Get().ISetBinaryOutputEnabled( isEnabled );
+    }
+
+    // Messages are written by a background thread by default. Deactivating drains the queue and goes back to synchronous writes.
+    inline static void SetMultithreadActivate( bool isActivated )
+    {
+        if ( isActivated )
+            Get().StartThread();
+        else
+            Get().TerminateThread();
+    }
+
+    inline static void TerminateThread()
+    {
+        Get().ITerminateThread();
+    }
+
+    // Blocks until every message logged before the call is written and flushed.
+    inline static void Flush()
+    {
+        Get().IFlush();
+    }
+
 private:
     LogManager()
         : LogLevelIgnoredBelow_( e_Loglevel::LOG_NONE )
@@ -176,127 +238,335 @@ private:
         , isMultithreadActivated_( false )
     {
         startTime_ = std::chrono::steady_clock::now();
-        logFile_.open( CreateLogFile() );
+        const char* environmentValue = std::getenv( "EOMULTITOOL_BINARY_LOG" );
+        if ( environmentValue != nullptr && environmentValue[ 0 ] != '\0' && std::string( environmentValue ) != "0" )
+            ISetBinaryOutputEnabled( true );
+        StartThread();
+    }
+
+    const LogCallsite* IRegisterCallsite( e_Loglevel level, const char* fullFunctionName, int line, std::string_view format )
+    {
+        std::lock_guard< std::mutex > guard( callsitesLock_ );
+        LogCallsite& callsite = callsites_.emplace_back();
+        callsite.id = static_cast< uint32_t >( callsites_.size() - 1 );
+        callsite.level = level;
+        callsite.fullFunctionName = fullFunctionName;
+        callsite.line = line;
+        callsite.format = format;
+        return &callsite;
     }
 
     template< typename... Args >
-    void ILogError( bool condition, const char* fullFunctionName, int line, e_Loglevel level, const char* message, Args&&... args )
+    void ILogError( const LogCallsite& callsite, fmt::format_string< Args... > message, Args&&... args )
     {
-        if ( !condition )
-            return;
+        LogEntry* entry = new LogEntry;
+        entry->time = std::chrono::system_clock::now();
+        entry->callsite = &callsite;
 
-        std::string strMessage;
-        std::ostringstream errorMsg;
-        try
+        // Callbacks and LOG_LETHAL need the text right away, other messages are formatted by the logging thread when possible.
+        const auto& callback = callbackFunctions_[ static_cast< int >( callsite.level ) ];
+        if constexpr ( AreLogArgumentsCapturable< Args... >() )
         {
-            if constexpr ( sizeof...( args ) > 0 )
-                strMessage = fmt::format( fmt::runtime( message ), std::forward< Args >( args )... );
-            else
-                strMessage = message;
+            if ( !callback && callsite.level != e_Loglevel::LOG_LETHAL && isMultithreadActivated_.load( std::memory_order_relaxed ) )
+            {
+                EncodeLogArguments( entry->arguments, args... );
+                AddEntry( entry );
+                return;
+            }
         }
-        catch ( const std::exception& logError )
+
+        entry->message = fmt::format( message, std::forward< Args >( args )... );
+        entry->isFormatted = true;
+        const std::string callbackMessage = callback ? entry->message : std::string();
+
+        if ( callsite.level == e_Loglevel::LOG_LETHAL )
         {
-            fmt::print( "LogManager format Error : {}", logError.what() );
-            std::exit( EXIT_FAILURE );
+            const std::string lethalLine = FormatEntry( *entry );
+            AddEntry( entry );
+            IFlush();
+            throw std::runtime_error( lethalLine );
         }
+        AddEntry( entry );
 
-        ClearAllSeparatorsFromLine( strMessage, separator_ );
-        std::string_view fullFunctionNameStr = RemoveReturnTypeFromFunctionName( fullFunctionName );
-
-        std::time_t currentTime = std::time( nullptr );
-        std::string timeString = fmt::format( "{:%H:%M:%S} || ", fmt::localtime( currentTime ) );
+        if ( callback )
+            callback( callbackMessage );
+    }
 
-        errorMsg << timeString << LogLevelToString( level ) << separator_ << fullFunctionNameStr << separator_ << "Line : " << line << separator_ << strMessage;
+    std::string FormatEntry( const LogEntry& entry ) const
+    {
+        std::string message = entry.isFormatted ? entry.message : FormatLogRecord( entry.callsite->format, entry.arguments );
+        ClearAllSeparatorsFromLine( message, separator_ );
+        return fmt::format( "{:%H:%M:%S}{}{}{}{}{}Line : {}{}{}\n",
+                            fmt::localtime( std::chrono::system_clock::to_time_t( entry.time ) ),
+                            separator_,
+                            LogLevelToString( entry.callsite->level ),
+                            separator_,
+                            RemoveReturnTypeFromFunctionName( entry.callsite->fullFunctionName ),
+                            separator_,
+                            entry.callsite->line,
+                            separator_,
+                            message );
+    }
 
-        if ( level >= LogLevelIgnoredBelow_ )
-            AddMessage( errorMsg.str() );
+    // Must be called with writeLock_ held. Callsites are defined in each file before their first message, so every file decodes on its own.
+    void AppendBinaryEntry( const LogEntry& entry, std::string& batch )
+    {
+        const LogCallsite& callsite = *entry.callsite;
+        if ( callsite.id >= writtenCallsites_.size() )
+            writtenCallsites_.resize( callsite.id + 1, false );
+        if ( !writtenCallsites_[ callsite.id ] )
+        {
+            batch.push_back( static_cast< char >( eLogRecordKind::Callsite ) );
+            AppendLogBytes( batch, callsite.id );
+            batch.push_back( static_cast< char >( callsite.level ) );
+            AppendLogBytes( batch, static_cast< uint32_t >( callsite.line ) );
+            AppendLogString( batch, RemoveReturnTypeFromFunctionName( callsite.fullFunctionName ) );
+            AppendLogString( batch, callsite.format );
+            writtenCallsites_[ callsite.id ] = true;
+        }
 
-        if ( level == e_Loglevel::LOG_LETHAL )
-            throw std::runtime_error( errorMsg.str() );
+        const int64_t timestampNs = std::chrono::duration_cast< std::chrono::nanoseconds >( entry.time.time_since_epoch() ).count();
+        batch.push_back( static_cast< char >( entry.isFormatted ? eLogRecordKind::Formatted : eLogRecordKind::Message ) );
+        AppendLogBytes( batch, callsite.id );
+        AppendLogBytes( batch, timestampNs );
+        AppendLogString( batch, entry.isFormatted ? entry.message : entry.arguments );
+    }
 
-        if ( callbackFunctions_[ static_cast< int >( level ) ] )
-            callbackFunctions_[ static_cast< int >( level ) ]( strMessage );
+    // Must be called with writeLock_ held. Text is only formatted when a text sink needs it.
+    void AppendEntry( const LogEntry& entry, std::string& textBatch, std::string& binaryBatch )
+    {
+        const bool isBinaryOutputEnabled = binaryFile_.is_open();
+        if ( isBinaryOutputEnabled )
+            AppendBinaryEntry( entry, binaryBatch );
+        if ( !isBinaryOutputEnabled || isConsoleOutputEnabled_.load( std::memory_order_relaxed ) )
+            textBatch += FormatEntry( entry );
     }
 
-    template< typename... Args >
-    std::string IFormatToString( const char* stringToFormat, Args&&... args )
+    // Must be called with writeLock_ held.
+    void WriteBatches( std::string& textBatch, std::string& binaryBatch )
     {
-        std::string strMessage = stringToFormat;
-        try
+        if ( binaryFile_.is_open() )
         {
-            if constexpr ( sizeof...( args ) > 0 )
-                strMessage = fmt::format( fmt::runtime( strMessage ), std::forward< Args >( args )... );
-            else
-                strMessage = strMessage;
-        } 
-        catch ( const std::exception& logError )
+            binaryFile_.write( binaryBatch.data(), static_cast< std::streamsize >( binaryBatch.size() ) );
+        }
+        else if ( !textBatch.empty() )
         {
-            fmt::print( "LogManager Error : {}", logError.what() );
-            std::exit( EXIT_FAILURE );
+            // Opened on the first text write, a binary only run leaves no empty text file behind to count in the rotation.
+            if ( !logFile_.is_open() )
+                logFile_.open( CreateLogFile() );
+            logFile_ << textBatch;
         }
-        return strMessage;
+        if ( isConsoleOutputEnabled_.load( std::memory_order_relaxed ) )
+            std::cout << textBatch;
+        textBatch.clear();
+        binaryBatch.clear();
     }
 
-    void AddMessage( const std::string& message )
+    // Must be called with writeLock_ held.
+    void FlushFiles()
     {
-        logFile_ << message << "\n";
         logFile_.flush();
+        if ( binaryFile_.is_open() )
+            binaryFile_.flush();
+        std::cout.flush();
+    }
+
+    void ISetBinaryOutputEnabled( bool isEnabled )
+    {
+        std::lock_guard< std::mutex > guard( writeLock_ );
+        if ( isEnabled == binaryFile_.is_open() )
+            return;
+        if ( !isEnabled )
+        {
+            binaryFile_.close();
+            return;
+        }
+
+        binaryFile_.open( CreateLogFile( ".bin" ), std::ios::binary | std::ios::out | std::ios::trunc );
+        if ( !binaryFile_.is_open() )
+            return;
+        writtenCallsites_.clear();
+        std::string header( LOG_BINARY_MAGIC );
+        AppendLogBytes( header, LOG_BINARY_VERSION );
+        AppendLogBytes( header, static_cast< int64_t >( std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::system_clock::now().time_since_epoch() ).count() ) );
+        binaryFile_.write( header.data(), static_cast< std::streamsize >( header.size() ) );
+    }
+
+    void AddEntry( LogEntry* entry )
+    {
+        if ( isMultithreadActivated_.load( std::memory_order_acquire ) )
+        {
+            enqueuedCount_.fetch_add( 1, std::memory_order_relaxed );
+            queue_.Push( entry );
+            return;
+        }
+
+        std::lock_guard< std::mutex > guard( writeLock_ );
+        std::string textBatch;
+        std::string binaryBatch;
+        AppendEntry( *entry, textBatch, binaryBatch );
+        WriteBatches( textBatch, binaryBatch );
+        FlushFiles();
+        delete entry;
+    }
 
+    void StartThread()
+    {
+        std::lock_guard< std::mutex > guard( threadLock_ );
         if ( isMultithreadActivated_ )
+            return;
+        shouldTerminate_ = false;
+        isMultithreadActivated_ = true;
+        logThread_ = std::thread( &LogManager::ProcessQueue, this );
+    }
+
+    void ITerminateThread()
+    {
+        std::lock_guard< std::mutex > guard( threadLock_ );
+        if ( !isMultithreadActivated_ )
+            return;
+        // New messages go through the synchronous path from now on, the thread drains what is already queued.
+        isMultithreadActivated_ = false;
+        shouldTerminate_ = true;
+        if ( logThread_.joinable() )
+            logThread_.join();
+
+        // Producers that saw the thread as active just before the switch may have pushed after it stopped.
+        std::lock_guard< std::mutex > writeGuard( writeLock_ );
+        std::string textBatch;
+        std::string binaryBatch;
+        while ( LogEntry* entry = queue_.Pop() )
         {
-            std::lock_guard< std::mutex > guard( messageVectorLock_ );
-            messages_.push_back( message );
+            AppendEntry( *entry, textBatch, binaryBatch );
+            delete entry;
         }
-        else
+        WriteBatches( textBatch, binaryBatch );
+        FlushFiles();
+    }
+
+    void IFlush()
+    {
+        if ( !isMultithreadActivated_.load( std::memory_order_acquire ) || std::this_thread::get_id() == logThread_.get_id() )
         {
-            std::cout << message << "\n";
+            std::lock_guard< std::mutex > guard( writeLock_ );
+            FlushFiles();
+            return;
+        }
+        const uint64_t target = enqueuedCount_.load( std::memory_order_relaxed );
+        while ( flushedCount_.load( std::memory_order_acquire ) < target && isMultithreadActivated_.load( std::memory_order_acquire ) )
+        {
+            isFlushRequested_ = true;
+            std::this_thread::yield();
+        }
+    }
+
+    // Drains the queue into one buffer per sink and per batch, so the files and the console see one write per batch instead of one per message.
+    void ProcessQueue()
+    {
+        static constexpr auto IDLE_WAIT = std::chrono::milliseconds( 5 );
+        static constexpr size_t MAX_BATCH_SIZE = 1 << 16;
+
+        std::string textBatch;
+        std::string binaryBatch;
+        uint64_t processedCount = 0;
+        bool hasUnflushedData = false;
+        auto lastFlushTime = std::chrono::steady_clock::now();
+        while ( true )
+        {
+            const bool shouldTerminate = shouldTerminate_.load( std::memory_order_acquire );
+            size_t drainedCount = 0;
+            {
+                std::lock_guard< std::mutex > guard( writeLock_ );
+                while ( LogEntry* entry = queue_.Pop() )
+                {
+                    AppendEntry( *entry, textBatch, binaryBatch );
+                    delete entry;
+                    ++drainedCount;
+                    if ( textBatch.size() + binaryBatch.size() >= MAX_BATCH_SIZE )
+                        break;
+                }
+                if ( drainedCount > 0 )
+                {
+                    WriteBatches( textBatch, binaryBatch );
+                    hasUnflushedData = true;
+                }
+            }
+            processedCount += drainedCount;
+
+            const auto now = std::chrono::steady_clock::now();
+            const bool isFlushRequested = isFlushRequested_.exchange( false );
+            if ( isFlushRequested || shouldTerminate || ( hasUnflushedData && now - lastFlushTime >= std::chrono::milliseconds( tickDurationMs_ ) ) )
+            {
+                std::lock_guard< std::mutex > guard( writeLock_ );
+                FlushFiles();
+                hasUnflushedData = false;
+                lastFlushTime = now;
+                flushedCount_.store( processedCount, std::memory_order_release );
+            }
+
+            if ( shouldTerminate && drainedCount == 0 && processedCount == enqueuedCount_.load( std::memory_order_acquire ) )
+                break;
+            if ( drainedCount == 0 )
+                std::this_thread::sleep_for( IDLE_WAIT );
         }
     }
 
 private:
-    e_Loglevel LogLevelIgnoredBelow_;
+    std::atomic< e_Loglevel > LogLevelIgnoredBelow_;
     std::chrono::steady_clock::time_point startTime_;
     std::ofstream logFile_;
+    std::ofstream binaryFile_;
+    std::vector< bool > writtenCallsites_; // Callsites already defined in binaryFile_.
     std::vector< std::function< void( std::string ) > > callbackFunctions_;
-    std::mutex messageVectorLock_;
-    std::vector< std::string > messages_;
-    int tickDurationMs_;
-    int tickNumber_;
-    bool shouldTerminate_;
+    std::mutex callsitesLock_;
+    std::deque< LogCallsite > callsites_; // Deque so registered callsites never move.
+    std::mutex writeLock_;
+    std::mutex threadLock_;
+    MpscQueue< LogEntry > queue_;
+    std::atomic< uint64_t > enqueuedCount_ = 0;
+    std::atomic< uint64_t > flushedCount_ = 0;
+    std::atomic< bool > isFlushRequested_ = false;
+    int tickDurationMs_; // Flush period of the logging thread.
+    std::atomic< bool > shouldTerminate_;
     std::thread logThread_;
-    bool isMultithreadActivated_;
+    std::atomic< bool > isMultithreadActivated_;
+    std::atomic< bool > isConsoleOutputEnabled_ = true;
     const std::string separator_ = " || ";
 };
 
-#ifndef NDEBUG
-#    ifdef __GNUG__
-#        define FULL_FUNCTION_NAME __PRETTY_FUNCTION__
-#    else
-#        define FULL_FUNCTION_NAME __FUNCTION__
-#    endif
-
-#    define LOG_DEBUG( message, ... ) LogManager::LogError( true, FULL_FUNCTION_NAME, __LINE__, e_Loglevel::LOG_DEBUG, message, ##__VA_ARGS__ )
-#    define LOG_NOTICE( message, ... ) LogManager::LogError( true, FULL_FUNCTION_NAME, __LINE__, e_Loglevel::LOG_NOTICE, message, ##__VA_ARGS__ )
-#    define LOG_WARNING( message, ... ) LogManager::LogError( true, FULL_FUNCTION_NAME, __LINE__, e_Loglevel::LOG_WARNING, message, ##__VA_ARGS__ )
-#    define LOG_LETHAL( message, ... ) LogManager::LogError( true, FULL_FUNCTION_NAME, __LINE__, e_Loglevel::LOG_LETHAL, message, ##__VA_ARGS__ )
-#    define LOG_CONDITIONAL_NOTICE( condition, message, ... ) LogManager::LogError( condition, FULL_FUNCTION_NAME, __LINE__, e_Loglevel::LOG_NOTICE, message, ##__VA_ARGS__ )
-#    define LOG_CONDITIONAL_WARNING( condition, message, ... ) LogManager::LogError( condition, FULL_FUNCTION_NAME, __LINE__, e_Loglevel::LOG_WARNING, message, ##__VA_ARGS__ )
-#    define LOG_CONDITIONAL_LETHAL( condition, message, ... ) LogManager::LogError( condition, FULL_FUNCTION_NAME, __LINE__, e_Loglevel::LOG_LETHAL, message, ##__VA_ARGS__ )
-#    define LOG_TERMINATE() LogManager::TerminateThread()
-#    define LOG_ACTIVATE_MULTITHREAD( x ) LogManager::SetMultithreadActivate( x )
-#    define LOG_IGNORE_BELOW( x ) LogManager::IgnoreLogLevelBelow( x )
+#ifdef __GNUG__
+#    define FULL_FUNCTION_NAME __PRETTY_FUNCTION__
+#else
+#    define FULL_FUNCTION_NAME __FUNCTION__
+#endif
 
+// Each macro registers its callsite once, on its first message that passes the level filter.
+#define LOG_AT_LEVEL( condition, level, message, ... )                                                                                          \
+    do                                                                                                                                         \
+    {                                                                                                                                          \
+        if ( ( condition ) && LogManager::IsLevelEnabled( level ) )                                                                            \
+        {                                                                                                                                      \
+            static const LogCallsite* const logCallsite = LogManager::RegisterCallsite( level, FULL_FUNCTION_NAME, __LINE__, message );       \
+            LogManager::LogError( *logCallsite, message, ##__VA_ARGS__ );                                                                     \
+        }                                                                                                                                      \
+    } while ( false )
+
+// Notices, warnings and lethal errors stay in release builds, filtered levels cost one atomic load. Debug messages are debug builds only.
+#ifndef NDEBUG
+#    define LOG_DEBUG( message, ... ) LOG_AT_LEVEL( true, e_Loglevel::LOG_DEBUG, message, ##__VA_ARGS__ )
 #else
 #    define LOG_DEBUG( message, ... )
-#    define LOG_NOTICE( message, ... )
-#    define LOG_WARNING( message, ... )
-#    define LOG_LETHAL( message, ... )
-#    define LOG_CONDITIONAL_NOTICE( condition, message, ... )
-#    define LOG_CONDITIONAL_WARNING( condition, message, ... )
-#    define LOG_CONDITIONAL_LETHAL( condition, message, ... )
-#    define LOG_TERMINATE()
-#    define LOG_ACTIVATE_MULTITHREAD( x )
-#    define LOG_IGNORE_BELOW( x )
 #endif
-
-#endif // !LOG_MANAGER_H
\ No newline at end of file
+#define LOG_NOTICE( message, ... ) LOG_AT_LEVEL( true, e_Loglevel::LOG_NOTICE, message, ##__VA_ARGS__ )
+#define LOG_WARNING( message, ... ) LOG_AT_LEVEL( true, e_Loglevel::LOG_WARNING, message, ##__VA_ARGS__ )
+#define LOG_LETHAL( message, ... ) LOG_AT_LEVEL( true, e_Loglevel::LOG_LETHAL, message, ##__VA_ARGS__ )
+#define LOG_CONDITIONAL_NOTICE( condition, message, ... ) LOG_AT_LEVEL( condition, e_Loglevel::LOG_NOTICE, message, ##__VA_ARGS__ )
+#define LOG_CONDITIONAL_WARNING( condition, message, ... ) LOG_AT_LEVEL( condition, e_Loglevel::LOG_WARNING, message, ##__VA_ARGS__ )
+#define LOG_CONDITIONAL_LETHAL( condition, message, ... ) LOG_AT_LEVEL( condition, e_Loglevel::LOG_LETHAL, message, ##__VA_ARGS__ )
+#define LOG_TERMINATE() LogManager::TerminateThread()
+#define LOG_ACTIVATE_MULTITHREAD( x ) LogManager::SetMultithreadActivate( x )
+#define LOG_IGNORE_BELOW( x ) LogManager::IgnoreLogLevelBelow( x )
+#define LOG_CONSOLE_OUTPUT( x ) LogManager::SetConsoleOutputEnabled( x )
+#define LOG_BINARY_OUTPUT( x ) LogManager::SetBinaryOutputEnabled( x )
+
+#endif // !LOG_MANAGER_H
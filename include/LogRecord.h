@@ -0,0 +1,208 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#define FMT_HEADER_ONLY
+#include "fmt/args.h"
+#include "fmt/format.h"
+
+// Type tags of the arguments captured by the LOG macros, stored in front of each argument of a record.
+enum class eLogArgumentType : uint8_t
+{
+    Other = 0, // Not capturable, the message is formatted on the calling thread instead.
+    Unsigned = 1,
+    Signed = 2,
+    Floating = 3,
+    Float = 4,
+    Bool = 5,
+    Char = 6,
+    String = 7
+};
+
+template< typename T >
+constexpr uint8_t GetDatatype()
+{
+    using tValue = std::remove_cvref_t< T >;
+    if constexpr ( std::is_same_v< tValue, bool > )
+        return static_cast< uint8_t >( eLogArgumentType::Bool );
+    else if constexpr ( std::is_same_v< tValue, char > )
+        return static_cast< uint8_t >( eLogArgumentType::Char );
+    else if constexpr ( std::is_integral_v< tValue > && std::is_unsigned_v< tValue > )
+        return static_cast< uint8_t >( eLogArgumentType::Unsigned );
+    else if constexpr ( std::is_integral_v< tValue > )
+        return static_cast< uint8_t >( eLogArgumentType::Signed );
+    else if constexpr ( std::is_same_v< tValue, double > )
+        return static_cast< uint8_t >( eLogArgumentType::Floating );
+    else if constexpr ( std::is_same_v< tValue, float > )
+        return static_cast< uint8_t >( eLogArgumentType::Float );
+    else if constexpr ( std::is_convertible_v< const tValue&, std::string_view > )
+        return static_cast< uint8_t >( eLogArgumentType::String );
+    else
+        return static_cast< uint8_t >( eLogArgumentType::Other );
+}
+
+// Record kinds of the binary log file (Logs/log_<date>.bin).
+// The file starts with LOG_BINARY_MAGIC, the uint32 LOG_BINARY_VERSION and the int64 creation time in nanoseconds since epoch.
+// A callsite is defined once, before its first message, then messages only refer to its id:
+// Callsite  : [kind][uint32 id][uint8 level][uint32 line][string function][string format]
+// Message   : [kind][uint32 id][int64 ns since epoch][string arguments], arguments encoded as below
+// Formatted : [kind][uint32 id][int64 ns since epoch][string message], for arguments that could not be captured
+enum class eLogRecordKind : uint8_t
+{
+    Callsite = 1,
+    Message = 2,
+    Formatted = 3
+};
+
+static constexpr std::string_view LOG_BINARY_MAGIC = "EOLG";
+static constexpr uint32_t LOG_BINARY_VERSION = 1;
+
+template< typename T >
+void AppendLogBytes( std::string& buffer, const T& value )
+{
+    static_assert( std::is_trivially_copyable_v< T > );
+    const size_t offset = buffer.size();
+    buffer.resize( offset + sizeof( T ) );
+    std::memcpy( buffer.data() + offset, &value, sizeof( T ) );
+}
+
+inline void AppendLogString( std::string& buffer, std::string_view text )
+{
+    AppendLogBytes( buffer, static_cast< uint32_t >( text.size() ) );
+    buffer.append( text );
+}
+
+template< typename... Args >
+constexpr bool AreLogArgumentsCapturable()
+{
+    return ( ( GetDatatype< Args >() != static_cast< uint8_t >( eLogArgumentType::Other ) ) && ... );
+}
+
+// Arguments are stored as [tag][value] in native byte order, strings as [tag][uint32 size][bytes].
+template< typename T >
+void AppendLogArgument( std::string& buffer, const T& value )
+{
+    constexpr uint8_t datatype = GetDatatype< T >();
+    buffer.push_back( static_cast< char >( datatype ) );
+
+    if constexpr ( datatype == static_cast< uint8_t >( eLogArgumentType::Unsigned ) )
+        AppendLogBytes( buffer, static_cast< uint64_t >( value ) );
+    else if constexpr ( datatype == static_cast< uint8_t >( eLogArgumentType::Signed ) )
+        AppendLogBytes( buffer, static_cast< int64_t >( value ) );
+    else if constexpr ( datatype == static_cast< uint8_t >( eLogArgumentType::Floating ) )
+        AppendLogBytes( buffer, value );
+    else if constexpr ( datatype == static_cast< uint8_t >( eLogArgumentType::Float ) )
+        AppendLogBytes( buffer, value );
+    else if constexpr ( datatype == static_cast< uint8_t >( eLogArgumentType::Bool ) || datatype == static_cast< uint8_t >( eLogArgumentType::Char ) )
+        buffer.push_back( static_cast< char >( value ) );
+    else if constexpr ( datatype == static_cast< uint8_t >( eLogArgumentType::String ) )
+        AppendLogString( buffer, std::string_view( value ) );
+    else
+        static_assert( datatype != static_cast< uint8_t >( eLogArgumentType::Other ), "Argument type cannot be captured in a log record" );
+}
+
+template< typename... Args >
+void EncodeLogArguments( std::string& buffer, const Args&... args )
+{
+    ( AppendLogArgument( buffer, args ), ... );
+}
+
+// Calls visitor( value ) for each argument of an encoded record, with the type it was captured as.
+// Returns false if the buffer is truncated or holds an unknown tag.
+template< typename Visitor >
+bool VisitLogArguments( std::string_view arguments, Visitor&& visitor )
+{
+    size_t offset = 0;
+    auto readBytes = [ & ]( auto& rawValue )
+    {
+        if ( offset + sizeof( rawValue ) > arguments.size() )
+            return false;
+        std::memcpy( &rawValue, arguments.data() + offset, sizeof( rawValue ) );
+        offset += sizeof( rawValue );
+        return true;
+    };
+
+    while ( offset < arguments.size() )
+    {
+        const auto datatype = static_cast< eLogArgumentType >( arguments[ offset++ ] );
+        switch ( datatype )
+        {
+            case eLogArgumentType::Unsigned:
+            {
+                uint64_t value = 0;
+                if ( !readBytes( value ) )
+                    return false;
+                visitor( value );
+                break;
+            }
+            case eLogArgumentType::Signed:
+            {
+                int64_t value = 0;
+                if ( !readBytes( value ) )
+                    return false;
+                visitor( value );
+                break;
+            }
+            case eLogArgumentType::Floating:
+            {
+                double value = 0;
+                if ( !readBytes( value ) )
+                    return false;
+                visitor( value );
+                break;
+            }
+            case eLogArgumentType::Float:
+            {
+                float value = 0;
+                if ( !readBytes( value ) )
+                    return false;
+                visitor( value );
+                break;
+            }
+            case eLogArgumentType::Bool:
+            case eLogArgumentType::Char:
+            {
+                char value = 0;
+                if ( !readBytes( value ) )
+                    return false;
+                if ( datatype == eLogArgumentType::Bool )
+                    visitor( value != 0 );
+                else
+                    visitor( value );
+                break;
+            }
+            case eLogArgumentType::String:
+            {
+                uint32_t size = 0;
+                if ( !readBytes( size ) || offset + size > arguments.size() )
+                    return false;
+                visitor( arguments.substr( offset, size ) );
+                offset += size;
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+// Formats a captured record. The format string was checked at compile time against the original argument types,
+// so errors here only come from a corrupted buffer; they are reported inside the returned message.
+inline std::string FormatLogRecord( std::string_view format, std::string_view arguments )
+{
+    fmt::dynamic_format_arg_store< fmt::format_context > store;
+    if ( !VisitLogArguments( arguments, [ &store ]( const auto& value ) { store.push_back( value ); } ) )
+        return fmt::format( "{} <corrupted log arguments>", format );
+    try
+    {
+        return fmt::vformat( format, store );
+    }
+    catch ( const std::exception& formatError )
+    {
+        return fmt::format( "{} <format error : {}>", format, formatError.what() );
+    }
+}
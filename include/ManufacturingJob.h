@@ -2,36 +2,56 @@
 #include "HelperTypes.h"
 
 #include <map>
+#include <mutex>
+#include <optional>
+#include <vector>
 
+class JsonlWriter;
 class QJsonObject;
+struct SdeActivityRecord;
 
+// One activity of a blueprint: manufacturing, but also reactions, invention, copying and research.
 class ManufacturingJob
 {
 public:
     ManufacturingJob() = default;
-    ManufacturingJob( const QJsonObject& jsonData );
+    ManufacturingJob( eIndustryActivity activity, const QJsonObject& jsonData );
+    ManufacturingJob( eIndustryActivity activity, const SdeActivityRecord& record );
     ~ManufacturingJob() = default;
 
     void FromJsonObject( const QJsonObject& jsonData );
-    QJsonObject ToJsonObject() const;
+    void WriteJson( JsonlWriter& writer ) const;
+
+    eIndustryActivity GetActivity() const;
+    unsigned int GetTimeInSeconds() const;
+    double GetProbability() const; // Of success, 1 unless the SDE gives one, as it does for invention.
 
     const std::vector< WithQuantity< tTypeId > >& GetComponents() const;
     const std::vector< WithQuantity< tTypeId > >& GetRawMaterials() const;
     const std::vector< WithQuantity< tTypeId > >& GetManufacturedProducts() const;
     const std::vector< WithQuantity< tTypeId > >& GetFullMaterialList() const;
 
-    std::map< tTypeId, unsigned int > GetRecursedRawMaterialList() const;
+    // Computed once per job after components are filtered, then shared by every caller.
+    const std::map< tTypeId, unsigned int >& GetRecursedRawMaterialList() const;
 
     bool IsValid() const;
 
     void FilterComponents();
 
 private:
+    std::map< tTypeId, unsigned int > BuildRecursedRawMaterialList() const;
+
+private:
+    eIndustryActivity activity_ = eIndustryActivity::Manufacturing;
     bool isValid_ = false;
     bool componentsFiltered_ = false;
     unsigned int timeInSeconds_ = 0;
+    std::optional< double > probability_;
     std::vector< WithQuantity< tTypeId > > manufacturedProducts_;
     std::vector< WithQuantity< tTypeId > > matRequirements_;
     std::vector< WithQuantity< tTypeId > > components_;
     std::vector< WithQuantity< tTypeId > > rawMaterials_;
+
+    mutable std::once_flag recursedRawMaterialsFlag_;
+    mutable std::map< tTypeId, unsigned int > recursedRawMaterials_;
 };
@@ -0,0 +1,65 @@
+#pragma once
+#include "HelperTypes.h"
+
+#include <QAbstractItemModel>
+
+#include <memory>
+#include <vector>
+
+class Blueprint;
+
+// Tree model of a blueprint's material requirements.
+// Only the top level is built on SetBlueprint, every other level is computed when the view expands it.
+class MaterialTreeModel : public QAbstractItemModel
+{
+    Q_OBJECT
+public:
+    explicit MaterialTreeModel( QObject* parent = nullptr );
+    ~MaterialTreeModel() override = default;
+
+    void SetBlueprint( const std::shared_ptr< const Blueprint > blueprint );
+    void Clear();
+
+    QModelIndex index( int row, int column, const QModelIndex& parent = QModelIndex() ) const override;
+    QModelIndex parent( const QModelIndex& child ) const override;
+    int rowCount( const QModelIndex& parent = QModelIndex() ) const override;
+    int columnCount( const QModelIndex& parent = QModelIndex() ) const override;
+    QVariant data( const QModelIndex& index, int role = Qt::DisplayRole ) const override;
+    QVariant headerData( int section, Qt::Orientation orientation, int role = Qt::DisplayRole ) const override;
+    bool hasChildren( const QModelIndex& parent = QModelIndex() ) const override;
+    bool canFetchMore( const QModelIndex& parent ) const override;
+    void fetchMore( const QModelIndex& parent ) override;
+
+private:
+    enum class eNodeKind
+    {
+        Root,
+        Blueprint,
+        TotalRawMaterials,
+        Details,
+        RawMaterial,
+        RecursedRawMaterial,
+        Component
+    };
+
+    struct Node
+    {
+        eNodeKind kind = eNodeKind::Root;
+        tTypeId typeId = 0;
+        tTypeId blueprintId = 0; // Blueprint expanded under this node, 0 for leaves.
+        unsigned int quantity = 0;
+        Node* parent = nullptr;
+        int row = 0;
+        bool areChildrenFetched = false;
+        std::vector< std::unique_ptr< Node > > children;
+    };
+
+    Node* NodeFromIndex( const QModelIndex& index ) const;
+    bool CanHaveChildren( const Node& node ) const;
+    std::vector< std::unique_ptr< Node > > BuildChildren( Node& node ) const;
+    QString GetTypeName( tTypeId typeId ) const;
+
+private:
+    std::unique_ptr< Node > root_;
+    QString blueprintName_; // Label of the blueprint row.
+};
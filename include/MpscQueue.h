@@ -0,0 +1,62 @@
+#pragma once
+#include <atomic>
+
+// Intrusive multi-producer single-consumer queue (Dmitry Vyukov's design).
+// Push is wait-free and can be called from any thread; Pop must only be called from the consumer thread.
+// Node must expose a std::atomic< Node* > next member. Popped nodes belong to the caller.
+template < typename Node >
+class MpscQueue
+{
+public:
+    MpscQueue()
+        : head_( &stub_ )
+        , tail_( &stub_ )
+    {
+    }
+
+    MpscQueue( const MpscQueue& ) = delete;
+    MpscQueue& operator=( const MpscQueue& ) = delete;
+
+    void Push( Node* node )
+    {
+        node->next.store( nullptr, std::memory_order_relaxed );
+        Node* previous = head_.exchange( node, std::memory_order_acq_rel );
+        previous->next.store( node, std::memory_order_release );
+    }
+
+    // Returns nullptr when the queue is empty, or when a producer is between its exchange and its link and the node is not reachable yet.
+    Node* Pop()
+    {
+        Node* tail = tail_;
+        Node* next = tail->next.load( std::memory_order_acquire );
+        if ( tail == &stub_ )
+        {
+            if ( next == nullptr )
+                return nullptr;
+            tail_ = next;
+            tail = next;
+            next = next->next.load( std::memory_order_acquire );
+        }
+        if ( next != nullptr )
+        {
+            tail_ = next;
+            return tail;
+        }
+        if ( tail != head_.load( std::memory_order_acquire ) )
+            return nullptr;
+
+        Push( &stub_ );
+        next = tail->next.load( std::memory_order_acquire );
+        if ( next != nullptr )
+        {
+            tail_ = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+private:
+    std::atomic< Node* > head_;
+    Node* tail_;
+    Node stub_;
+};
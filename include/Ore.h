@@ -5,6 +5,7 @@
 #include <vector>
 
 class QJsonObject;
+struct SdeOreRecord;
 
 class Ore : public JsonEveInterface
 {
@@ -12,9 +13,10 @@ public:
     Ore() = default;
     ~Ore() = default;
     Ore( const QJsonObject& jsonData );
+    explicit Ore( const SdeOreRecord& record );
 
     void FromJsonObject( const QJsonObject& jsonData );
-    QJsonObject ToJsonObject() const override;
+    void WriteJson( JsonlWriter& writer ) const override;
     void PostLoadingInitialization() override;
 
     const std::vector< WithQuantity< tTypeId > >& GetRefinedProducts() const;
@@ -0,0 +1,58 @@
+#pragma once
+#include "HelperTypes.h"
+#include "LPHelper.h"
+
+#include <QString>
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+struct OreSolutionKey
+{
+    std::vector< WithQuantity< tTypeId > > requirements; // Sorted by typeId, no zero quantities.
+    uint64_t pricesVersion = 0;
+    uint64_t yieldsVersion = 0;
+
+    uint64_t Hash() const;
+    bool operator==( const OreSolutionKey& other ) const;
+};
+
+// Bounded LRU of ore LP solutions, optionally persisted next to the data snapshot.
+class OreSolutionCache
+{
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 64;
+
+    explicit OreSolutionCache( size_t capacity = DEFAULT_CAPACITY );
+    ~OreSolutionCache() = default;
+
+    OreSolutionCache( const OreSolutionCache& ) = delete;
+    OreSolutionCache& operator=( const OreSolutionCache& ) = delete;
+
+    std::optional< OreSolution > Find( const OreSolutionKey& key );
+    void Insert( const OreSolutionKey& key, const OreSolution& solution );
+    void Clear();
+    size_t GetSize() const;
+
+    bool LoadFromFile( const QString& filePath );
+    bool SaveToFile( const QString& filePath ) const;
+
+private:
+    struct Entry
+    {
+        uint64_t hash = 0;
+        OreSolutionKey key;
+        OreSolution solution;
+    };
+
+    void InsertLocked( uint64_t hash, const OreSolutionKey& key, const OreSolution& solution );
+
+private:
+    const size_t capacity_;
+    std::list< Entry > entries_; // Most recently used first.
+    std::unordered_map< uint64_t, std::list< Entry >::iterator > entriesByHash_;
+    mutable std::mutex mutex_;
+};
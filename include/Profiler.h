@@ -0,0 +1,293 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define FMT_HEADER_ONLY
+#include "fmt/chrono.h"
+#include "fmt/format.h"
+
+struct ProfileZoneRecord
+{
+    const char* name = nullptr; // Must have static storage duration, zones only keep the pointer.
+    int64_t startNs = 0;
+    int64_t durationNs = 0;
+};
+
+// Written by its owning thread only, read by the exporter. When full, the oldest zones are overwritten.
+class ProfileRingBuffer
+{
+public:
+    static constexpr size_t CAPACITY = 1 << 14;
+
+    ProfileRingBuffer( uint32_t threadId, const std::string& threadName )
+        : threadId_( threadId )
+        , threadName_( threadName )
+        , records_( CAPACITY )
+    {
+    }
+
+    void Push( const ProfileZoneRecord& record )
+    {
+        const uint64_t index = writeIndex_.load( std::memory_order_relaxed );
+        records_[ index & ( CAPACITY - 1 ) ] = record;
+        writeIndex_.store( index + 1, std::memory_order_release );
+    }
+
+    // Zones recorded while the snapshot is taken may be torn, export once the traced work is done.
+    std::vector< ProfileZoneRecord > GetSnapshot() const
+    {
+        const uint64_t end = writeIndex_.load( std::memory_order_acquire );
+        const uint64_t begin = end > CAPACITY ? end - CAPACITY : 0;
+        std::vector< ProfileZoneRecord > snapshot;
+        snapshot.reserve( static_cast< size_t >( end - begin ) );
+        for ( uint64_t index = begin; index < end; ++index )
+            snapshot.push_back( records_[ index & ( CAPACITY - 1 ) ] );
+        return snapshot;
+    }
+
+    uint32_t GetThreadId() const
+    {
+        return threadId_;
+    }
+
+    const std::string& GetThreadName() const
+    {
+        return threadName_;
+    }
+
+    void SetThreadName( const std::string& threadName )
+    {
+        threadName_ = threadName;
+    }
+
+private:
+    const uint32_t threadId_;
+    std::string threadName_;
+    std::vector< ProfileZoneRecord > records_;
+    std::atomic< uint64_t > writeIndex_ = 0;
+};
+
+// Collects scoped timing zones of every thread and exports them in the Chrome trace event format (chrome://tracing, Perfetto).
+// Disabled unless EOMULTITOOL_PROFILE is set in the environment or SetEnabled( true ) is called; a disabled zone costs one relaxed load.
+class Profiler
+{
+public:
+    ~Profiler() = default;
+    Profiler( const Profiler& ) = delete;
+    static Profiler& Get()
+    {
+        static Profiler instance;
+
+        return instance;
+    }
+
+    inline static bool IsEnabled()
+    {
+        return Get().isEnabled_.load( std::memory_order_relaxed );
+    }
+
+    inline static void SetEnabled( bool isEnabled )
+    {
+        Get().isEnabled_.store( isEnabled, std::memory_order_relaxed );
+    }
+
+    // --profile on the command line enables the zones as well.
+    inline static void EnableFromArguments( int argc, char** argv )
+    {
+        for ( int i = 1; i < argc; ++i )
+        {
+            if ( std::string( argv[ i ] ) == "--profile" )
+                SetEnabled( true );
+        }
+    }
+
+    inline static int64_t GetElapsedNs()
+    {
+        return std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - Get().startTime_ ).count();
+    }
+
+    inline static void AddZone( const ProfileZoneRecord& record )
+    {
+        GetThreadBuffer().Push( record );
+    }
+
+    inline static void SetThreadName( const std::string& threadName )
+    {
+        // Naming registers the thread buffer, which is never released: threads are only named while zones are recorded.
+        if ( !IsEnabled() )
+            return;
+        ProfileRingBuffer& threadBuffer = GetThreadBuffer();
+        std::lock_guard< std::mutex > guard( Get().buffersLock_ );
+        threadBuffer.SetThreadName( threadName );
+    }
+
+    inline static bool ExportChromeTrace( const std::string& filePath )
+    {
+        return Get().IExportChromeTrace( filePath );
+    }
+
+    // Writes Logs/trace_<date>.json next to the text logs, returns the path or an empty string on failure.
+    inline static std::string ExportToLogDirectory()
+    {
+        std::error_code error;
+        std::filesystem::create_directories( "Logs", error );
+        const std::string filePath = fmt::format( "Logs/trace_{:%Y-%m-%d_%H-%M-%S}.json", fmt::localtime( std::time( nullptr ) ) );
+        return ExportChromeTrace( filePath ) ? filePath : std::string();
+    }
+
+private:
+    Profiler()
+        : startTime_( std::chrono::steady_clock::now() )
+    {
+        const char* environmentValue = std::getenv( "EOMULTITOOL_PROFILE" );
+        isEnabled_ = environmentValue != nullptr && environmentValue[ 0 ] != '\0' && std::string( environmentValue ) != "0";
+    }
+
+    // Hands the buffer of a thread back to the profiler when the thread exits.
+    struct ThreadBufferLease
+    {
+        ThreadBufferLease()
+            : buffer( Get().AcquireBuffer() )
+        {
+        }
+        ~ThreadBufferLease()
+        {
+            Get().ReleaseBuffer( buffer );
+        }
+
+        ProfileRingBuffer* const buffer;
+    };
+
+    // Buffers are owned by the profiler so zones of finished threads can still be exported.
+    static ProfileRingBuffer& GetThreadBuffer()
+    {
+        thread_local ThreadBufferLease lease;
+        return *lease.buffer;
+    }
+
+    // Thread pools retire idle threads and start new ones: a buffer released by an exited thread is continued by the next thread
+    // instead of allocating one more. Its zones are kept, on the same track of the trace.
+    ProfileRingBuffer* AcquireBuffer()
+    {
+        std::lock_guard< std::mutex > guard( buffersLock_ );
+        if ( !releasedBuffers_.empty() )
+        {
+            ProfileRingBuffer* buffer = releasedBuffers_.back();
+            releasedBuffers_.pop_back();
+            buffer->SetThreadName( fmt::format( "Thread {}", buffer->GetThreadId() ) );
+            return buffer;
+        }
+        const uint32_t threadId = static_cast< uint32_t >( buffers_.size() + 1 );
+        buffers_.push_back( std::make_unique< ProfileRingBuffer >( threadId, fmt::format( "Thread {}", threadId ) ) );
+        return buffers_.back().get();
+    }
+
+    void ReleaseBuffer( ProfileRingBuffer* buffer )
+    {
+        std::lock_guard< std::mutex > guard( buffersLock_ );
+        releasedBuffers_.push_back( buffer );
+    }
+
+    bool IExportChromeTrace( const std::string& filePath )
+    {
+        std::ofstream file( filePath, std::ios::out | std::ios::trunc );
+        if ( !file.is_open() )
+            return false;
+
+        std::lock_guard< std::mutex > guard( buffersLock_ );
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool isFirstEvent = true;
+        auto writeEvent = [ & ]( const std::string& event )
+        {
+            file << ( isFirstEvent ? "\n" : ",\n" ) << event;
+            isFirstEvent = false;
+        };
+        for ( const auto& buffer : buffers_ )
+        {
+            writeEvent( fmt::format( "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}",
+                                     buffer->GetThreadId(),
+                                     EscapeJson( buffer->GetThreadName() ) ) );
+            for ( const ProfileZoneRecord& record : buffer->GetSnapshot() )
+            {
+                // Chrome trace timestamps are in microseconds.
+                writeEvent( fmt::format( "{{\"name\":\"{}\",\"cat\":\"zone\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                                         EscapeJson( record.name ),
+                                         buffer->GetThreadId(),
+                                         record.startNs / 1000.0,
+                                         record.durationNs / 1000.0 ) );
+            }
+        }
+        file << "\n]}\n";
+        return file.good();
+    }
+
+    static std::string EscapeJson( const std::string& text )
+    {
+        std::string escaped;
+        escaped.reserve( text.size() );
+        for ( const char character : text )
+        {
+            if ( character == '"' || character == '\\' )
+                escaped.push_back( '\\' );
+            if ( static_cast< unsigned char >( character ) >= 0x20 )
+                escaped.push_back( character );
+        }
+        return escaped;
+    }
+
+private:
+    std::atomic< bool > isEnabled_ = false;
+    const std::chrono::steady_clock::time_point startTime_;
+    std::mutex buffersLock_;
+    std::vector< std::unique_ptr< ProfileRingBuffer > > buffers_;
+    std::vector< ProfileRingBuffer* > releasedBuffers_; // Of exited threads, reused before any new buffer is allocated.
+};
+
+class ProfileZone
+{
+public:
+    explicit ProfileZone( const char* name )
+    {
+        if ( !Profiler::IsEnabled() )
+            return;
+        name_ = name;
+        startNs_ = Profiler::GetElapsedNs();
+    }
+
+    ~ProfileZone()
+    {
+        if ( name_ != nullptr )
+            Profiler::AddZone( { name_, startNs_, Profiler::GetElapsedNs() - startNs_ } );
+    }
+
+    ProfileZone( const ProfileZone& ) = delete;
+    ProfileZone& operator=( const ProfileZone& ) = delete;
+
+private:
+    const char* name_ = nullptr;
+    int64_t startNs_ = 0;
+};
+
+// Zones stay compiled in release builds, they are toggled at runtime. Define EOMULTITOOL_DISABLE_PROFILER to remove them.
+#ifndef EOMULTITOOL_DISABLE_PROFILER
+#    define PROFILE_CONCAT_IMPL( a, b ) a##b
+#    define PROFILE_CONCAT( a, b ) PROFILE_CONCAT_IMPL( a, b )
+#    define PROFILE_ZONE( name ) ProfileZone PROFILE_CONCAT( profileZone_, __LINE__ )( name )
+#    define PROFILE_FUNCTION() PROFILE_ZONE( __FUNCTION__ )
+#    define PROFILE_THREAD_NAME( name ) Profiler::SetThreadName( name )
+#    define PROFILE_ENABLE( x ) Profiler::SetEnabled( x )
+#else
+#    define PROFILE_ZONE( name )
+#    define PROFILE_FUNCTION()
+#    define PROFILE_THREAD_NAME( name )
+#    define PROFILE_ENABLE( x )
+#endif
@@ -0,0 +1,65 @@
+#pragma once
+#include <QString>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string_view>
+
+struct ProgressSnapshot
+{
+    int mainStep = 0;
+    int mainStepCount = 0;
+    QString mainDescription;
+    qint64 subCurrent = 0;
+    qint64 subTotal = 0;
+    QString subDescription;
+    double bytesPerSecond = 0.0;
+    double recordsPerSecond = 0.0;
+    double etaSeconds = -1.0; // Negative when unknown.
+};
+
+// Loading progress shared between the workers and the interface.
+// Workers update plain atomics, as often as they like and without signals; the interface samples it on a timer.
+// Descriptions are static strings plus an optional detail (a file name), QStrings are only built by Sample().
+class ProgressReporter
+{
+public:
+    ProgressReporter() = default;
+    ~ProgressReporter() = default;
+
+    ProgressReporter( const ProgressReporter& ) = delete;
+    ProgressReporter& operator=( const ProgressReporter& ) = delete;
+
+    // description must have static storage duration.
+    void SetMainStep( int step, int stepCount, const char* description );
+    // Replaces the sub task and clears the detail. description must have static storage duration.
+    void SetSubTask( const char* description, qint64 total, qint64 current = 0 );
+    // Copied into a fixed buffer, truncated to MAX_DETAIL_SIZE bytes. Meant for per-file changes, not per-record.
+    void SetSubDetail( std::string_view detail );
+    void SetSubTotal( qint64 total );
+    void SetSubProgress( qint64 current );
+    void AdvanceSubProgress( qint64 count = 1 );
+    void SetThroughput( double bytesPerSecond, double recordsPerSecond, double etaSeconds );
+
+    // Completed fraction of the sub task, 0 when its total is unknown.
+    double GetSubProgressFraction() const;
+    ProgressSnapshot Sample() const;
+
+    static constexpr size_t MAX_DETAIL_SIZE = 255;
+
+private:
+    std::atomic< int > mainStep_ = 0;
+    std::atomic< int > mainStepCount_ = 0;
+    std::atomic< const char* > mainDescription_ = "";
+    std::atomic< qint64 > subCurrent_ = 0;
+    std::atomic< qint64 > subTotal_ = 0;
+    std::atomic< const char* > subDescription_ = "";
+    std::atomic< double > bytesPerSecond_ = 0.0;
+    std::atomic< double > recordsPerSecond_ = 0.0;
+    std::atomic< double > etaSeconds_ = -1.0;
+
+    mutable std::mutex detailLock_;
+    std::array< char, MAX_DETAIL_SIZE + 1 > detail_ = {};
+    size_t detailSize_ = 0;
+};
@@ -2,16 +2,25 @@
 #include "Blueprint.h"
 #include "DataLoader.h"
 #include "HelperTypes.h"
+#include "LineIndex.h"
+#include "LoadTelemetry.h"
+#include "ProgressReporter.h"
+#include "SdeImport.h"
+#include "SnapshotFile.h"
 
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <qobject.h>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 
 class QFile;
 class QJsonObject;
 class QSettings;
+class QThreadPool;
 class EveType;
 class Ore;
 
@@ -21,6 +30,9 @@ concept JsonEveChild = std::is_base_of_v< JsonEveInterface, T >;
 class RessourcesManager : public QObject
 {
     Q_OBJECT
+    // Benchmarks drive the private loading stages directly, without DataLoader and the network.
+    friend class SdeLoadingBenchmark;
+    friend class SyntheticRessourcesLoader;
 
 public:
     RessourcesManager( QSettings& settings, QObject* parent = nullptr );
@@ -29,35 +41,57 @@ public:
     RessourcesManager( const RessourcesManager& ) = delete;
     RessourcesManager& operator=( const RessourcesManager& ) = delete;
 
+    static QString GetBinaryDataDirectoryPath();
+    // Sampled by the interface while loading, stays valid after the manager is deleted.
+    std::shared_ptr< const ProgressReporter > GetProgressReporter() const;
+
 public slots:
     void LoadRessources();
 
 signals:
     void RessourcesReady();
     void RessourcesLoadingMainStepChanged( int current, int total, const QString& progressDescription );
-    void RessourcesLoadingSubStepChanged( int current, int total, const QString& progressDescription );
     void MarketPricesUpdated();
     void ErrorOccured( const QString& errorMessage );
 
 private:
     void SetLoadingStep( eDataLoadingSteps step );
+    void ReportThroughput();
+    // Keeps the throughput up to date until every parse worker of threadPool is done.
+    void WaitForParseWorkers( QThreadPool& threadPool, const std::atomic< qint64 >& parsedLines );
     bool OpenFile( const QString& filePath, QFile& target, bool isBinary );
 
-    template < JsonEveChild T >
-    bool BuildMapFromJsonlFile( const QString& filePath, TypeIdMap< T >& targetMap, eDataLoadingSteps step );
-    void RemoveNonOreMaterials( const QString& groupFilepath );
-    void FilterIrrelevantTypes( const QString& groupFilepath );
+    // Parses an SDE file into records of import_, see CompactRecords(). With a keyFilter, only the records it lists are kept
+    // and the other lines are skipped after their key.
+    template < typename TRecord >
+    bool StageJsonlFile( const QString& filePath,
+                         SdeRecordMap< TRecord >& targetMap,
+                         eDataLoadingSteps step,
+                         const std::unordered_set< tTypeId >* keyFilter = nullptr );
+    bool ReadOreGroupIds( const QString& groupFilePath, std::unordered_set< unsigned int >& oreGroupIds );
+    // Every type the staged blueprints and ores refer to, the only ones worth parsing from the types file.
+    std::unordered_set< tTypeId > CollectReferencedTypeIds() const;
+    void RemoveNonOreMaterials( const std::unordered_set< unsigned int >& oreGroupIds );
+    // Drops the irrelevant records of import_, then builds types_, blueprints_ and ores_ from the others.
+    void FilterIrrelevantTypes( const std::unordered_set< unsigned int >& oreGroupIds );
+    // Builds the final objects of the surviving records in one pass and releases import_ with all its arenas.
+    void CompactRecords( const std::unordered_set< tTypeId >& relevantTypeIds );
     void SetManufacturableTypes();
+    // Every stage from the extracted SDE files to the final types_, blueprints_ and ores_, short of the snapshots.
+    bool BuildMapsFromJsonl( const QString& extractedSdePath, const QJsonObject& marketPricesJson );
     bool SaveToBinaryFile();
 
+    // One JSON object per line, the payload of a snapshot.
     template < JsonEveChild T >
-    QJsonObject GetJsonFromMap( const TypeIdMap< T >& ) const;
-    bool SaveJsonObjectToBinaryFile( const QJsonObject& jsonObject, const QString& binaryFilepath );
-    bool LoadMapsFromBinaryFiles();
+    std::string GetJsonlFromMap( const TypeIdMap< T >& ) const;
+    // Checks every snapshot before decoding any, the valid ones are remembered in validSnapshots_.
+    // Missing when some snapshot was never written and none is invalid.
+    eSnapshotStatus LoadMapsFromBinaryFiles();
 
     template < JsonEveChild T >
-    bool BuildMapFromBinaryFile( const QString& filePath, TypeIdMap< T >& targetMap );
-    unsigned int GetNumberOfLinesInFile( QFile& file );
+    bool BuildMapFromSnapshot( const QString& filePath, const QByteArray& payload, TypeIdMap< T >& targetMap );
+    // Built on first use for each file, rebuilt when its size or modification time changed.
+    const LineIndex& GetLineIndex( const QFile& file, std::string_view data );
 
     void AddMarketPricesToTypes( const QJsonObject& marketPricesJson );
     void AddReprocessedFromOreDataToTypes();
@@ -75,11 +109,18 @@ private:
 
     std::unique_ptr< DataLoader > dataLoader_ = nullptr;
     std::unique_ptr< FileDownloader > fileDownloader_ = nullptr;
+    std::unique_ptr< SdeImport > import_ = nullptr; // Only while importing the SDE.
     bool isRessourcesReady_ = false;
+    LoadTelemetry telemetry_;
+    std::shared_ptr< ProgressReporter > progress_;
+    std::unordered_map< QString, LineIndex > lineIndexes_;
+    std::unordered_set< QString > validSnapshots_; // Not rewritten by the next import unless they depend on the prices.
+    qint64 marketPricesTimestamp_ = 0;
 
     const QString BINARY_DATA_DIRECTORY_PATH_;
     const QString BINARY_TYPES_FILEPATH_;
     const QString BINARY_BLUEPRINTS_FILEPATH_;
     const QString BINARY_ORES_FILEPATH_;
+    const QString LOAD_METRICS_FILEPATH_;
     const QString MARKET_PRICES_URL_ = "https://esi.evetech.net/latest/markets/prices/?datasource=tranquility";
 };
@@ -0,0 +1,125 @@
+#pragma once
+#include "HelperTypes.h"
+
+#include <array>
+#include <deque>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+using tRecordQuantities = std::span< const WithQuantity< tTypeId > >;
+
+// Records of the SDE as parsed, before filtering. They live in the arenas of an SdeImport and are never destroyed one by one,
+// strings and lists point into the same arenas. Only the records surviving the filtering become EveType, Blueprint and Ore.
+struct SdeTypeRecord
+{
+    tTypeId typeId = 0;
+    unsigned int groupId = 0;
+    bool isPublished = false;
+    bool isValid = false;
+    std::optional< unsigned int > categoryId;
+    std::optional< unsigned int > marketGroupId;
+    std::optional< unsigned int > iconId;
+    std::optional< double > basePrice;
+    std::optional< double > volume;
+    std::string_view name;
+    std::optional< std::string_view > description;
+};
+
+struct SdeActivityRecord
+{
+    unsigned int timeInSeconds = 0;
+    std::optional< double > probability; // Of success, only given for invention.
+    tRecordQuantities materials;
+    tRecordQuantities products;
+};
+
+struct SdeBlueprintRecord
+{
+    tTypeId typeId = 0;
+    bool isValid = false;
+    std::array< std::optional< SdeActivityRecord >, INDUSTRY_ACTIVITY_COUNT > activities;
+
+    const SdeActivityRecord* GetActivity( eIndustryActivity activity ) const
+    {
+        const std::optional< SdeActivityRecord >& record = activities[ static_cast< size_t >( activity ) ];
+        return record ? &*record : nullptr;
+    }
+    // Manufacturing, or the reaction of a formula. Every kept blueprint has one.
+    const SdeActivityRecord* GetProductionActivity() const
+    {
+        const SdeActivityRecord* manufacturing = GetActivity( eIndustryActivity::Manufacturing );
+        return manufacturing != nullptr ? manufacturing : GetActivity( eIndustryActivity::Reaction );
+    }
+};
+
+struct SdeOreRecord
+{
+    tTypeId typeId = 0;
+    bool isValid = false;
+    tRecordQuantities materials;
+};
+
+template < typename TRecord >
+using SdeRecordMap = std::pmr::unordered_map< tTypeId, const TRecord* >;
+
+// Bump allocator for the records of one parse worker, freed all at once with its SdeImport.
+class SdeImportArena
+{
+public:
+    explicit SdeImportArena( size_t initialSize );
+    ~SdeImportArena() = default;
+
+    SdeImportArena( const SdeImportArena& ) = delete;
+    SdeImportArena& operator=( const SdeImportArena& ) = delete;
+
+    template < typename TRecord >
+    TRecord* New();
+    std::string_view CopyString( std::string_view text );
+    tRecordQuantities CopyQuantities( const std::vector< WithQuantity< tTypeId > >& quantities );
+    size_t GetBytesAllocated() const;
+
+private:
+    void* Allocate( size_t size, size_t alignment );
+
+private:
+    std::pmr::monotonic_buffer_resource resource_;
+    size_t bytesAllocated_ = 0;
+};
+
+template < typename TRecord >
+TRecord* SdeImportArena::New()
+{
+    static_assert( std::is_trivially_destructible_v< TRecord >, "Arena records are never destroyed." );
+    return new ( Allocate( sizeof( TRecord ), alignof( TRecord ) ) ) TRecord();
+}
+
+// Everything parsed from the SDE files during one import. Released wholesale once the surviving records are built.
+class SdeImport
+{
+public:
+    SdeImport();
+    ~SdeImport() = default;
+
+    SdeImport( const SdeImport& ) = delete;
+    SdeImport& operator=( const SdeImport& ) = delete;
+
+    // Each parse worker needs its own, arenas are not thread safe. Not thread safe either, call before starting the workers.
+    SdeImportArena& AddArena( size_t initialSize );
+    size_t GetBytesAllocated() const;
+
+    SdeRecordMap< SdeTypeRecord >& GetTypes();
+    SdeRecordMap< SdeBlueprintRecord >& GetBlueprints();
+    SdeRecordMap< SdeOreRecord >& GetOres();
+
+private:
+    std::pmr::monotonic_buffer_resource mapResource_; // Nodes and buckets of the maps below, filled from the loading thread only.
+    std::deque< SdeImportArena > arenas_;
+    SdeRecordMap< SdeTypeRecord > types_;
+    SdeRecordMap< SdeBlueprintRecord > blueprints_;
+    SdeRecordMap< SdeOreRecord > ores_;
+};
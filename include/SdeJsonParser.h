@@ -0,0 +1,27 @@
+#pragma once
+#include "HelperTypes.h"
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+class SdeImportArena;
+struct SdeBlueprintRecord;
+struct SdeOreRecord;
+struct SdeTypeRecord;
+
+// Reads one SDE JSON lines record straight into its import record, without building a QJsonDocument.
+// Each record type has a compile time table of the fields it keeps. Any other member, like translated names or the skills
+// required by blueprint activities, is skipped without being decoded. Strings and lists are copied into the arena.
+class SdeJsonParser
+{
+public:
+    // Returns false with the reason in error when the line is not valid JSON.
+    // Fields of an unexpected type are ignored, whether the record itself is usable is told by its isValid.
+    static bool Parse( std::string_view line, SdeTypeRecord& target, SdeImportArena& arena, std::string& error );
+    static bool Parse( std::string_view line, SdeBlueprintRecord& target, SdeImportArena& arena, std::string& error );
+    static bool Parse( std::string_view line, SdeOreRecord& target, SdeImportArena& arena, std::string& error );
+    // The "_key" of the record when it is its first member, which is how the SDE writes them, without reading further.
+    // Nothing when the line starts otherwise, the caller then has to parse it to know.
+    static std::optional< tTypeId > ReadKey( std::string_view line );
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include <QByteArray>
+#include <QString>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+enum class eSnapshotCompression : uint32_t
+{
+    None = 0,
+    ZlibBlocks = 1 // Independently deflated blocks, inflated in parallel.
+};
+
+enum class eSnapshotStatus
+{
+    Valid,
+    Missing, // Not written yet, nothing to warn about.
+    Invalid  // Truncated, corrupted or outdated.
+};
+
+// What a snapshot was built from, checked before its content is trusted.
+struct SnapshotMetadata
+{
+    int64_t sdeBuildNumber = 0;
+    int64_t marketPricesTimestampMs = 0; // When the prices baked into the snapshot were fetched, 0 if unknown.
+};
+
+// A cache file of the filtered SDE data (types.bin, blueprints.bin, ores.bin), its payload holds one JSON object per line.
+// Layout: [magic "EOSN"][uint32 format version][int64 SDE build][int64 prices timestamp ms][uint32 compression][uint32 block count]
+//         [uint64 raw size][uint64 stored size][uint32 stored crc32][uint32 header crc32][stored payload]
+// The header alone tells a truncated, foreign or outdated file without reading the payload, the crc32 then covers the stored bytes.
+// A ZlibBlocks payload starts with a table of [uint32 compressed size][uint32 raw size] per block, followed by the blocks.
+class SnapshotFile
+{
+public:
+    static constexpr std::string_view MAGIC = "EOSN";
+    static constexpr uint32_t FORMAT_VERSION = 5; // Bump when the payload or the filtering producing it changes.
+
+    // Written to a temporary file next to filePath, flushed to disk and renamed over filePath only once complete,
+    // a crash while saving leaves the previous snapshot untouched.
+    static bool Write( const QString& filePath,
+                       const SnapshotMetadata& metadata,
+                       const QByteArray& payload,
+                       eSnapshotCompression compression,
+                       std::string& error );
+    // Invalid with the reason in error when the file is unreadable, truncated, corrupted or was built from another SDE build.
+    // payload is always the uncompressed content, whatever the file was written with.
+    static eSnapshotStatus Read(
+        const QString& filePath, int64_t expectedSdeBuildNumber, SnapshotMetadata& metadata, QByteArray& payload, std::string& error );
+};
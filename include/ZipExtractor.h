@@ -1,6 +1,8 @@
 #pragma once
 #include <qobject.h>
 
+class ProgressReporter;
+
 class ZipExtractor : public QObject
 {
     Q_OBJECT
@@ -11,9 +13,12 @@ public:
 
     bool ExtractZip( const QString& zipPath, const QString& destPath );
     bool ValidateExtractedData( const QString& zipPath, const QString& destPath );
+    // Optional, receives the processed file count and the current file name. Must outlive the extraction.
+    void SetProgressReporter( ProgressReporter* progress );
 
 signals:
-    void ExtractionProgress( uint extractedFiles, uint totalFiles, const QString& fileName );
-    void ValidationProgress( uint validatedFiles, uint totalFiles, const QString& fileName );
     void ErrorOccurred( const QString& errorMessage );
+
+private:
+    ProgressReporter* progress_ = nullptr;
 };
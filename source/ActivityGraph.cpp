@@ -0,0 +1,167 @@
+#include "ActivityGraph.h"
+#include "Blueprint.h"
+#include "LogManager.h"
+
+#include <algorithm>
+#include <utility>
+
+// Counting sort of ( node, value ) pairs into CSR offsets and values, values keep their order within a node.
+static void BuildAdjacency( size_t nodeCount,
+                            const std::vector< std::pair< uint32_t, uint32_t > >& pairs,
+                            std::vector< uint32_t >& offsets,
+                            std::vector< uint32_t >& values )
+{
+    offsets.assign( nodeCount + 1, 0 );
+    for ( const auto& [ node, value ] : pairs )
+        ++offsets[ node + 1 ];
+    for ( size_t index = 1; index < offsets.size(); ++index )
+        offsets[ index ] += offsets[ index - 1 ];
+    std::vector< uint32_t > cursors( offsets.begin(), offsets.end() - 1 );
+    values.resize( pairs.size() );
+    for ( const auto& [ node, value ] : pairs )
+        values[ cursors[ node ]++ ] = value;
+}
+
+void ActivityGraph::Build( const TypeIdMap< Blueprint >& blueprints )
+{
+    PROFILE_FUNCTION();
+    *this = ActivityGraph();
+
+    // Sorted so that indexes do not depend on the hashing of the map.
+    std::vector< tTypeId > blueprintIds;
+    blueprintIds.reserve( blueprints.size() );
+    for ( const auto& [ blueprintId, blueprint ] : blueprints )
+        blueprintIds.push_back( blueprintId );
+    std::sort( blueprintIds.begin(), blueprintIds.end() );
+
+    std::vector< std::pair< uint32_t, uint32_t > > producedBy;
+    std::vector< std::pair< uint32_t, uint32_t > > consumedBy;
+    inputOffsets_.push_back( 0 );
+    outputOffsets_.push_back( 0 );
+    for ( const tTypeId blueprintId : blueprintIds )
+    {
+        const Blueprint& blueprint = *blueprints.at( blueprintId );
+        for ( size_t activity = 0; activity < INDUSTRY_ACTIVITY_COUNT; ++activity )
+        {
+            const auto job = blueprint.GetJob( static_cast< eIndustryActivity >( activity ) );
+            if ( job == nullptr || !job->IsValid() )
+                continue;
+
+            const uint32_t activityIndex = static_cast< uint32_t >( activities_.size() );
+            activities_.push_back(
+                { blueprintId, static_cast< eIndustryActivity >( activity ), job->GetTimeInSeconds(), job->GetProbability() } );
+            const uint32_t blueprintIndex = InternType( blueprintId );
+            inputs_.push_back( { blueprintIndex, 1, eActivityEdge::Blueprint } );
+            consumedBy.emplace_back( blueprintIndex, activityIndex );
+            for ( const auto& [ materialId, quantity ] : job->GetFullMaterialList() )
+            {
+                const uint32_t materialIndex = InternType( materialId );
+                inputs_.push_back( { materialIndex, quantity, eActivityEdge::Material } );
+                consumedBy.emplace_back( materialIndex, activityIndex );
+            }
+            for ( const auto& [ productId, quantity ] : job->GetManufacturedProducts() )
+            {
+                const uint32_t productIndex = InternType( productId );
+                outputs_.push_back( { productIndex, quantity, eActivityEdge::Product } );
+                producedBy.emplace_back( productIndex, activityIndex );
+            }
+            inputOffsets_.push_back( static_cast< uint32_t >( inputs_.size() ) );
+            outputOffsets_.push_back( static_cast< uint32_t >( outputs_.size() ) );
+        }
+    }
+    BuildAdjacency( typeIds_.size(), producedBy, producerOffsets_, producers_ );
+    BuildAdjacency( typeIds_.size(), consumedBy, consumerOffsets_, consumers_ );
+    LOG_NOTICE( "Built the activity graph: {} types, {} activities, {} edges",
+                typeIds_.size(),
+                activities_.size(),
+                inputs_.size() + outputs_.size() );
+}
+
+size_t ActivityGraph::GetTypeCount() const
+{
+    return typeIds_.size();
+}
+
+size_t ActivityGraph::GetActivityCount() const
+{
+    return activities_.size();
+}
+
+std::optional< uint32_t > ActivityGraph::FindType( tTypeId typeId ) const
+{
+    const auto typeIndex = typeIndexes_.find( typeId );
+    if ( typeIndex == typeIndexes_.end() )
+        return std::nullopt;
+    return typeIndex->second;
+}
+
+tTypeId ActivityGraph::GetTypeId( uint32_t typeIndex ) const
+{
+    return typeIds_[ typeIndex ];
+}
+
+const ActivityNode& ActivityGraph::GetActivity( uint32_t activityIndex ) const
+{
+    return activities_[ activityIndex ];
+}
+
+std::span< const ActivityEdge > ActivityGraph::GetInputs( uint32_t activityIndex ) const
+{
+    return std::span< const ActivityEdge >( inputs_ ).subspan( inputOffsets_[ activityIndex ],
+                                                               inputOffsets_[ activityIndex + 1 ] - inputOffsets_[ activityIndex ] );
+}
+
+std::span< const ActivityEdge > ActivityGraph::GetOutputs( uint32_t activityIndex ) const
+{
+    return std::span< const ActivityEdge >( outputs_ ).subspan( outputOffsets_[ activityIndex ],
+                                                                outputOffsets_[ activityIndex + 1 ] - outputOffsets_[ activityIndex ] );
+}
+
+std::span< const uint32_t > ActivityGraph::GetProducers( uint32_t typeIndex ) const
+{
+    return std::span< const uint32_t >( producers_ ).subspan( producerOffsets_[ typeIndex ],
+                                                              producerOffsets_[ typeIndex + 1 ] - producerOffsets_[ typeIndex ] );
+}
+
+std::span< const uint32_t > ActivityGraph::GetConsumers( uint32_t typeIndex ) const
+{
+    return std::span< const uint32_t >( consumers_ ).subspan( consumerOffsets_[ typeIndex ],
+                                                              consumerOffsets_[ typeIndex + 1 ] - consumerOffsets_[ typeIndex ] );
+}
+
+std::optional< uint32_t > ActivityGraph::FindProducer( tTypeId typeId, eIndustryActivity activity ) const
+{
+    const std::optional< uint32_t > typeIndex = FindType( typeId );
+    if ( !typeIndex )
+        return std::nullopt;
+    for ( const uint32_t activityIndex : GetProducers( *typeIndex ) )
+    {
+        if ( activities_[ activityIndex ].activity == activity )
+            return activityIndex;
+    }
+    return std::nullopt;
+}
+
+std::optional< uint32_t > ActivityGraph::FindProductionActivity( tTypeId typeId ) const
+{
+    const std::optional< uint32_t > manufacturing = FindProducer( typeId, eIndustryActivity::Manufacturing );
+    return manufacturing ? manufacturing : FindProducer( typeId, eIndustryActivity::Reaction );
+}
+
+unsigned int ActivityGraph::GetProducedQuantity( uint32_t activityIndex, uint32_t typeIndex ) const
+{
+    for ( const ActivityEdge& output : GetOutputs( activityIndex ) )
+    {
+        if ( output.typeIndex == typeIndex )
+            return output.quantity;
+    }
+    return 0;
+}
+
+uint32_t ActivityGraph::InternType( tTypeId typeId )
+{
+    const auto [ typeIndex, isInserted ] = typeIndexes_.try_emplace( typeId, static_cast< uint32_t >( typeIds_.size() ) );
+    if ( isInserted )
+        typeIds_.push_back( typeId );
+    return typeIndex->second;
+}
@@ -1,5 +1,7 @@
 #include "Blueprint.h"
+#include "JsonlWriter.h"
 #include "LogManager.h"
+#include "SdeImport.h"
 
 #include <QJsonObject>
 #include <QJsonarray>
@@ -9,6 +11,20 @@ Blueprint::Blueprint( const QJsonObject& jsonData )
     FromJsonObject( jsonData );
 }
 
+Blueprint::Blueprint( const SdeBlueprintRecord& record )
+{
+    typeId_ = record.typeId;
+    if ( !record.isValid )
+        return;
+    for ( size_t activity = 0; activity < INDUSTRY_ACTIVITY_COUNT; ++activity )
+    {
+        if ( record.activities[ activity ] )
+            jobs_[ activity ] =
+                std::make_shared< ManufacturingJob >( static_cast< eIndustryActivity >( activity ), *record.activities[ activity ] );
+    }
+    isValid_ = GetProductionJob() != nullptr && GetProductionJob()->IsValid();
+}
+
 void Blueprint::FromJsonObject( const QJsonObject& jsonData )
 {
     typeId_ = jsonData.value( "_key" ).toInt();
@@ -18,20 +34,20 @@ void Blueprint::FromJsonObject( const QJsonObject& jsonData )
         return;
     }
 
-    if ( jsonData.contains( "activities" ) && !jsonData.value( "activities" ).isNull() )
+    const QJsonObject activitiesObj = jsonData.value( "activities" ).toObject();
+    for ( size_t activity = 0; activity < INDUSTRY_ACTIVITY_COUNT; ++activity )
     {
-        QJsonObject activitiesObj = jsonData.value( "activities" ).toObject();
-        if ( activitiesObj.contains( "manufacturing" ) && !activitiesObj.value( "manufacturing" ).isNull() )
-        {
-            manufacturingJob_ = std::make_shared< ManufacturingJob >( activitiesObj.value( "manufacturing" ).toObject() );
-        }
-        else
-        {
-            LOG_NOTICE( "Blueprint id {} does not contain manufacturing job data.", typeId_ );
-            return;
-        }
+        const QString key = QString::fromUtf8( INDUSTRY_ACTIVITY_KEYS[ activity ].data(), INDUSTRY_ACTIVITY_KEYS[ activity ].size() );
+        if ( activitiesObj.contains( key ) && activitiesObj.value( key ).isObject() )
+            jobs_[ activity ] =
+                std::make_shared< ManufacturingJob >( static_cast< eIndustryActivity >( activity ), activitiesObj.value( key ).toObject() );
     }
-    if ( !manufacturingJob_->IsValid() )
+    if ( GetProductionJob() == nullptr )
+    {
+        LOG_NOTICE( "Blueprint id {} does not contain manufacturing or reaction job data.", typeId_ );
+        return;
+    }
+    if ( !GetProductionJob()->IsValid() )
     {
         LOG_WARNING( "Blueprint id {}'s manufacturing job is invalid", typeId_ );
         return;
@@ -39,27 +55,44 @@ void Blueprint::FromJsonObject( const QJsonObject& jsonData )
     isValid_ = true;
 }
 
-QJsonObject Blueprint::ToJsonObject() const
+void Blueprint::WriteJson( JsonlWriter& writer ) const
 {
-    QJsonObject obj;
-
-    if ( manufacturingJob_ == nullptr || !manufacturingJob_->IsValid() )
-        return QJsonObject();
-
-    obj[ "_key" ] = QString::number( typeId_ );
-    QJsonObject activitiesObj;
-    activitiesObj[ "manufacturing" ] = manufacturingJob_->ToJsonObject();
-    obj[ "activities" ] = activitiesObj;
-
-    return obj;
+    writer.BeginObject();
+    writer.Member( "_key", typeId_ );
+    writer.Key( "activities" );
+    writer.BeginObject();
+    for ( size_t activity = 0; activity < INDUSTRY_ACTIVITY_COUNT; ++activity )
+    {
+        if ( jobs_[ activity ] == nullptr || !jobs_[ activity ]->IsValid() )
+            continue;
+        writer.Key( INDUSTRY_ACTIVITY_KEYS[ activity ] );
+        jobs_[ activity ]->WriteJson( writer );
+    }
+    writer.EndObject();
+    writer.EndObject();
 }
 
 void Blueprint::PostLoadingInitialization()
 {
-    manufacturingJob_->FilterComponents();
+    for ( const auto& job : jobs_ )
+    {
+        if ( job != nullptr )
+            job->FilterComponents();
+    }
 }
 
 const std::shared_ptr< ManufacturingJob > Blueprint::GetManufacturingJob() const
 {
-    return manufacturingJob_;
+    return GetJob( eIndustryActivity::Manufacturing );
+}
+
+const std::shared_ptr< ManufacturingJob > Blueprint::GetProductionJob() const
+{
+    const auto manufacturingJob = GetJob( eIndustryActivity::Manufacturing );
+    return manufacturingJob != nullptr ? manufacturingJob : GetJob( eIndustryActivity::Reaction );
+}
+
+const std::shared_ptr< ManufacturingJob > Blueprint::GetJob( eIndustryActivity activity ) const
+{
+    return jobs_[ static_cast< size_t >( activity ) ];
 }
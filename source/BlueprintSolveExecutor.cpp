@@ -0,0 +1,74 @@
+#include "BlueprintSolveExecutor.h"
+#include "Blueprint.h"
+#include "GlobalRessources.h"
+#include "LogManager.h"
+
+BlueprintSolveExecutor::BlueprintSolveExecutor( const QString& solutionCachePath, QObject* parent )
+    : QObject( parent )
+    , solutionCachePath_( solutionCachePath )
+    , blueprintRequirementSolver_( GlobalRessources::GetOresMap() )
+{
+    if ( !solutionCachePath_.isEmpty() )
+        solutionCache_.LoadFromFile( solutionCachePath_ );
+    blueprintRequirementSolver_.SetSolutionCache( &solutionCache_ );
+    qRegisterMetaType< OreSolution >();
+    qRegisterMetaType< std::shared_ptr< const Blueprint > >();
+    // A single worker keeps the solver state unshared, superseded requests are skipped instead of queued behind.
+    threadPool_.setMaxThreadCount( 1 );
+    // Keep that worker for the whole lifetime of the executor, instead of a new thread after every idle period.
+    threadPool_.setExpiryTimeout( -1 );
+}
+
+BlueprintSolveExecutor::~BlueprintSolveExecutor()
+{
+    ++generation_;
+    threadPool_.clear();
+    threadPool_.waitForDone();
+    if ( !solutionCachePath_.isEmpty() )
+        solutionCache_.SaveToFile( solutionCachePath_ );
+}
+
+quint64 BlueprintSolveExecutor::Submit( const std::shared_ptr< const Blueprint > blueprint )
+{
+    const quint64 generation = ++generation_;
+    threadPool_.clear();
+    threadPool_.start( [ this, generation, blueprint ]() { Run( generation, blueprint ); } );
+    return generation;
+}
+
+bool BlueprintSolveExecutor::IsCurrentGeneration( quint64 generation ) const
+{
+    return generation_.load( std::memory_order_acquire ) == generation;
+}
+
+void BlueprintSolveExecutor::Run( quint64 generation, const std::shared_ptr< const Blueprint > blueprint )
+{
+    thread_local bool isThreadNamed = false;
+    if ( !isThreadNamed )
+    {
+        PROFILE_THREAD_NAME( "Blueprint solver" );
+        isThreadNamed = true;
+    }
+    PROFILE_FUNCTION();
+    auto isSuperseded = [ this, generation ]() { return !IsCurrentGeneration( generation ); };
+    if ( isSuperseded() || blueprint == nullptr || blueprint->GetProductionJob() == nullptr )
+        return;
+
+    blueprint->GetProductionJob()->GetRecursedRawMaterialList();
+    if ( isSuperseded() )
+        return;
+    emit BomReady( generation, blueprint );
+
+    if ( !blueprintRequirementSolver_.SolveForBlueprint( *blueprint, isSuperseded ) )
+    {
+        if ( !isSuperseded() )
+            emit OreSolveFailed( generation );
+        return;
+    }
+    if ( isSuperseded() )
+    {
+        LOG_NOTICE( "Dropping ore solution of superseded request {}", generation );
+        return;
+    }
+    emit OreSolutionReady( generation, blueprintRequirementSolver_.GetSolution() );
+}
@@ -0,0 +1,135 @@
+#include "BuildOrBuyOptimizer.h"
+#include "ActivityGraph.h"
+#include "EveType.h"
+#include "GlobalRessources.h"
+#include "IndustryCalculator.h"
+#include "LogManager.h"
+
+#include <algorithm>
+#include <limits>
+
+static constexpr double UNKNOWN_COST = std::numeric_limits< double >::infinity();
+
+static double GetMarketPrice( const std::shared_ptr< const EveType >& type )
+{
+    return type != nullptr && type->GetMarketPrice().averagePrice > 0.0 ? type->GetMarketPrice().averagePrice : UNKNOWN_COST;
+}
+
+BuildOrBuyOptimizer::BuildOrBuyOptimizer( const BuildOrBuySettings& settings, unsigned int materialEfficiency )
+    : graph_( GlobalRessources::GetActivityGraph() )
+    , settings_( settings )
+    , materialFactor_( 1.0 - static_cast< double >( std::min( materialEfficiency, IndustryCalculator::MAX_MATERIAL_EFFICIENCY ) ) / 100.0 )
+    , states_( graph_.GetTypeCount(), eNodeState::Unvisited )
+    , decisions_( graph_.GetTypeCount() )
+    , adjustedPrices_( graph_.GetTypeCount(), 0.0 )
+{
+}
+
+BuildOrBuyDecision BuildOrBuyOptimizer::Solve( tTypeId typeId )
+{
+    const std::optional< uint32_t > typeIndex = graph_.FindType( typeId );
+    if ( !typeIndex )
+    {
+        // Not part of any activity: it can only be bought.
+        const double marketPrice = GetMarketPrice( GlobalRessources::GetTypeById( typeId ) );
+        return { marketPrice == UNKNOWN_COST, marketPrice, marketPrice, UNKNOWN_COST };
+    }
+    if ( states_[ *typeIndex ] != eNodeState::Solved )
+        SolveFrom( *typeIndex );
+    return decisions_[ *typeIndex ];
+}
+
+bool BuildOrBuyOptimizer::IsBuilt( tTypeId typeId )
+{
+    return Solve( typeId ).isBuilt;
+}
+
+std::optional< uint32_t > BuildOrBuyOptimizer::FindProductionActivity( uint32_t typeIndex ) const
+{
+    std::optional< uint32_t > reaction;
+    for ( const uint32_t activityIndex : graph_.GetProducers( typeIndex ) )
+    {
+        const eIndustryActivity activity = graph_.GetActivity( activityIndex ).activity;
+        if ( activity == eIndustryActivity::Manufacturing )
+            return activityIndex;
+        if ( activity == eIndustryActivity::Reaction && !reaction )
+            reaction = activityIndex;
+    }
+    return reaction;
+}
+
+void BuildOrBuyOptimizer::SolveFrom( uint32_t rootIndex )
+{
+    PROFILE_FUNCTION();
+    struct Frame
+    {
+        uint32_t typeIndex = 0;
+        std::optional< uint32_t > activityIndex;
+        size_t nextInput = 0;
+    };
+
+    // Iterative post-order walk, capital chains are deep enough to make recursion a concern.
+    std::vector< Frame > stack;
+    states_[ rootIndex ] = eNodeState::Visiting;
+    stack.push_back( { rootIndex, FindProductionActivity( rootIndex ) } );
+    while ( !stack.empty() )
+    {
+        Frame& frame = stack.back();
+        std::optional< uint32_t > unvisitedInput;
+        if ( frame.activityIndex )
+        {
+            const std::span< const ActivityEdge > inputs = graph_.GetInputs( *frame.activityIndex );
+            while ( frame.nextInput < inputs.size() && !unvisitedInput )
+            {
+                const ActivityEdge& input = inputs[ frame.nextInput++ ];
+                if ( input.kind == eActivityEdge::Material && states_[ input.typeIndex ] == eNodeState::Unvisited )
+                    unvisitedInput = input.typeIndex;
+            }
+        }
+        if ( unvisitedInput )
+        {
+            states_[ *unvisitedInput ] = eNodeState::Visiting;
+            stack.push_back( { *unvisitedInput, FindProductionActivity( *unvisitedInput ) } );
+            continue;
+        }
+
+        SolveNode( frame.typeIndex, frame.activityIndex );
+        states_[ frame.typeIndex ] = eNodeState::Solved;
+        stack.pop_back();
+    }
+}
+
+void BuildOrBuyOptimizer::SolveNode( uint32_t typeIndex, std::optional< uint32_t > activityIndex )
+{
+    BuildOrBuyDecision& decision = decisions_[ typeIndex ];
+    const auto type = GlobalRessources::GetTypeById( graph_.GetTypeId( typeIndex ) );
+    if ( type != nullptr )
+        adjustedPrices_[ typeIndex ] = type->GetMarketPrice().adjustedPrice;
+    decision.marketPrice = GetMarketPrice( type );
+    decision.buildCost = UNKNOWN_COST;
+
+    const unsigned int producedQuantity = activityIndex ? graph_.GetProducedQuantity( *activityIndex, typeIndex ) : 0;
+    if ( producedQuantity > 0 )
+    {
+        // Reaction formulas cannot be researched. The efficiency is applied per unit, without the rounding of whole runs.
+        const double materialFactor =
+            graph_.GetActivity( *activityIndex ).activity == eIndustryActivity::Manufacturing ? materialFactor_ : 1.0;
+        double materialCost = 0.0;
+        double estimatedItemValue = 0.0;
+        for ( const ActivityEdge& input : graph_.GetInputs( *activityIndex ) )
+        {
+            if ( input.kind != eActivityEdge::Material )
+                continue;
+            // An input still being visited is a cycle back to this type, it cannot be built through it.
+            const bool isSolved = states_[ input.typeIndex ] == eNodeState::Solved;
+            const double inputCost = isSolved ? decisions_[ input.typeIndex ].unitCost : UNKNOWN_COST;
+            materialCost += inputCost * static_cast< double >( input.quantity ) * materialFactor;
+            estimatedItemValue += adjustedPrices_[ input.typeIndex ] * static_cast< double >( input.quantity );
+        }
+        const double jobFee = estimatedItemValue * ( settings_.systemCostIndex + settings_.facilityTax );
+        decision.buildCost = ( materialCost + jobFee ) / static_cast< double >( producedQuantity );
+    }
+
+    decision.isBuilt = decision.buildCost <= decision.marketPrice;
+    decision.unitCost = std::min( decision.buildCost, decision.marketPrice );
+}
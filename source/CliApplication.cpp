@@ -0,0 +1,501 @@
+#include "CliApplication.h"
+#include "Blueprint.h"
+#include "EveType.h"
+#include "GlobalRessources.h"
+#include "Inventory.h"
+#include "LogManager.h"
+#include "RessourcesManager.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <iostream>
+
+static constexpr const char* CLI_FLAG = "--cli";
+static constexpr const char* STDIO_PATH = "-";
+
+CliApplication::CliApplication( QObject* parent )
+    : QObject( parent )
+    , settings_( QDir( QCoreApplication::applicationDirPath() ).filePath( "settings.ini" ), QSettings::IniFormat )
+{
+}
+
+CliApplication::~CliApplication() = default;
+
+bool CliApplication::IsRequested( int argc, char** argv )
+{
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( qstrcmp( argv[ i ], CLI_FLAG ) == 0 )
+            return true;
+    }
+    return false;
+}
+
+void CliApplication::Start()
+{
+    if ( !ParseArguments() || !ReadRequests() )
+        return;
+
+    LOG_CONSOLE_OUTPUT( false );
+    ressourcesManager_ = std::make_unique< RessourcesManager >( settings_ );
+    connect( ressourcesManager_.get(), &RessourcesManager::RessourcesReady, this, &CliApplication::OnRessourcesReady );
+    connect( ressourcesManager_.get(), &RessourcesManager::ErrorOccured, this, &CliApplication::OnErrorOccured );
+    if ( isVerbose_ )
+    {
+        connect( ressourcesManager_.get(),
+                 &RessourcesManager::RessourcesLoadingMainStepChanged,
+                 this,
+                 []( int current, int total, const QString& description )
+                 { std::cerr << QString( "[%1/%2] %3" ).arg( current ).arg( total ).arg( description ).toStdString() << std::endl; } );
+    }
+    ressourcesManager_->LoadRessources();
+}
+
+bool CliApplication::ParseArguments()
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Batch industry computations. Each input line is \"blueprint[,runs[,materialEfficiency]]\" where blueprint is a type id or a "
+        "blueprint name. Empty lines and lines starting with # are ignored." );
+    parser.addHelpOption();
+    parser.addOption( QCommandLineOption( "cli", "Run without user interface." ) );
+    parser.addOption( QCommandLineOption( { "i", "input" }, "Requests file, - for stdin.", "file", STDIO_PATH ) );
+    parser.addOption( QCommandLineOption( { "o", "output" }, "Output file, - for stdout.", "file", STDIO_PATH ) );
+    parser.addOption( QCommandLineOption( { "f", "format" }, "Output format: json or csv.", "format", "json" ) );
+    parser.addOption(
+        QCommandLineOption( "invention",
+                            "Build the T2 blueprints of each chain from invented copies, with the decryptor giving the lowest cost "
+                            "per run, and add the datacores and decryptors expected to be spent." ) );
+    parser.addOption( QCommandLineOption(
+        "build-or-buy", "Buy the components whose market price is below their build cost, job fees included, instead of building them." ) );
+    parser.addOption( QCommandLineOption( "cost-index", "System cost index of the jobs, for --build-or-buy.", "index", "0.05" ) );
+    parser.addOption( QCommandLineOption( "schedule",
+                                          "Schedule the jobs of each request on characters given as "
+                                          "\"manufacturingSlots:reactionSlots:timeEfficiency\", separated by commas.",
+                                          "characters" ) );
+    parser.addOption( QCommandLineOption( "schedule-mip", "Refine small schedules with a MIP, for --schedule." ) );
+    parser.addOption( QCommandLineOption( "inventory",
+                                          "Owned items to draw from before building or buying: ESI assets in a .json file, or one "
+                                          "\"item,quantity\" or pasted asset line per line. Owned ores are refined before any is "
+                                          "bought. Requests draw from it in order, each from what the previous ones left.",
+                                          "file" ) );
+    parser.addOption( QCommandLineOption( "verbose", "Print loading steps to stderr." ) );
+    parser.addOption( QCommandLineOption( "profile", "Record timing zones and write a Chrome trace to the Logs directory." ) );
+    parser.process( *QCoreApplication::instance() );
+
+    inputPath_ = parser.value( "input" );
+    outputPath_ = parser.value( "output" );
+    outputFormat_ = parser.value( "format" ).toLower();
+    isVerbose_ = parser.isSet( "verbose" );
+    isIncludingInvention_ = parser.isSet( "invention" );
+    inventoryPath_ = parser.value( "inventory" );
+    if ( parser.isSet( "build-or-buy" ) )
+    {
+        bool isValid = false;
+        BuildOrBuySettings buildOrBuy;
+        buildOrBuy.systemCostIndex = parser.value( "cost-index" ).toDouble( &isValid );
+        if ( !isValid || buildOrBuy.systemCostIndex < 0.0 )
+        {
+            Fail( tr( "Invalid cost index %1" ).arg( parser.value( "cost-index" ) ) );
+            return false;
+        }
+        buildOrBuy_ = buildOrBuy;
+    }
+    if ( parser.isSet( "schedule" ) )
+    {
+        if ( !ParseCharacters( parser.value( "schedule" ) ) )
+            return false;
+        scheduler_->isRefiningWithMip = parser.isSet( "schedule-mip" );
+    }
+    if ( outputFormat_ != "json" && outputFormat_ != "csv" )
+    {
+        Fail( tr( "Unknown output format %1, expected json or csv." ).arg( outputFormat_ ) );
+        return false;
+    }
+    return true;
+}
+
+bool CliApplication::ParseCharacters( const QString& characters )
+{
+    SchedulerSettings scheduler;
+    for ( const QString& character : characters.split( ',', Qt::SkipEmptyParts ) )
+    {
+        const QStringList fields = character.split( ':' );
+        bool isValid = fields.size() == 3;
+        SchedulerCharacter& schedulerCharacter = scheduler.characters.emplace_back();
+        schedulerCharacter.name = QString( "Character %1" ).arg( scheduler.characters.size() ).toStdString();
+        if ( isValid )
+            schedulerCharacter.manufacturingSlots = fields[ 0 ].trimmed().toUInt( &isValid );
+        if ( isValid )
+            schedulerCharacter.reactionSlots = fields[ 1 ].trimmed().toUInt( &isValid );
+        if ( isValid )
+            schedulerCharacter.timeEfficiency = fields[ 2 ].trimmed().toUInt( &isValid );
+        if ( !isValid || schedulerCharacter.timeEfficiency > IndustryCalculator::MAX_TIME_EFFICIENCY )
+        {
+            Fail( tr( "Invalid character %1, expected manufacturingSlots:reactionSlots:timeEfficiency" ).arg( character ) );
+            return false;
+        }
+    }
+    if ( scheduler.characters.empty() )
+    {
+        Fail( tr( "No character to schedule on" ) );
+        return false;
+    }
+    scheduler_ = std::move( scheduler );
+    return true;
+}
+
+bool CliApplication::ReadRequests()
+{
+    QFile inputFile;
+    bool isOpen = false;
+    if ( inputPath_ == STDIO_PATH )
+        isOpen = inputFile.open( stdin, QIODevice::ReadOnly | QIODevice::Text );
+    else
+    {
+        inputFile.setFileName( inputPath_ );
+        isOpen = inputFile.open( QIODevice::ReadOnly | QIODevice::Text );
+    }
+    if ( !isOpen )
+    {
+        Fail( tr( "Could not open requests from %1" ).arg( inputPath_ ) );
+        return false;
+    }
+
+    QTextStream input( &inputFile );
+    int lineNumber = 0;
+    while ( !input.atEnd() )
+    {
+        const QString line = input.readLine().trimmed();
+        ++lineNumber;
+        if ( line.isEmpty() || line.startsWith( '#' ) )
+            continue;
+        if ( !ParseRequestLine( line, lineNumber ) )
+            return false;
+    }
+    if ( requests_.empty() )
+    {
+        Fail( tr( "No production request found in %1" ).arg( inputPath_ ) );
+        return false;
+    }
+    return true;
+}
+
+bool CliApplication::ParseRequestLine( const QString& line, int lineNumber )
+{
+    const QStringList fields = line.split( ',' );
+    if ( fields.size() > 3 )
+    {
+        Fail( tr( "Line %1: expected blueprint[,runs[,materialEfficiency]]" ).arg( lineNumber ) );
+        return false;
+    }
+
+    ProductionRequest request;
+    if ( isIncludingInvention_ )
+        request.invention = InventionSkills();
+    request.buildOrBuy = buildOrBuy_;
+    bool isValid = true;
+    if ( fields.size() > 1 )
+        request.runs = fields[ 1 ].trimmed().toUInt( &isValid );
+    if ( isValid && fields.size() > 2 )
+        request.materialEfficiency = fields[ 2 ].trimmed().toUInt( &isValid );
+    if ( !isValid || request.runs == 0 || request.materialEfficiency > IndustryCalculator::MAX_MATERIAL_EFFICIENCY )
+    {
+        Fail( tr( "Line %1: invalid runs or material efficiency" ).arg( lineNumber ) );
+        return false;
+    }
+
+    requestedBlueprints_.push_back( fields[ 0 ].trimmed() );
+    requests_.push_back( request );
+    return true;
+}
+
+tTypeId CliApplication::FindBlueprintId( const QString& blueprint ) const
+{
+    bool isNumber = false;
+    const tTypeId typeId = blueprint.toUInt( &isNumber );
+    if ( isNumber )
+        return GlobalRessources::IsBlueprint( typeId ) ? typeId : 0;
+
+    for ( const auto& [ blueprintId, blueprintPtr ] : GlobalRessources::GetBlueprintsMap() )
+    {
+        if ( blueprintPtr->GetName().compare( blueprint, Qt::CaseInsensitive ) == 0 )
+            return blueprintId;
+    }
+    return 0;
+}
+
+void CliApplication::OnRessourcesReady()
+{
+    for ( size_t i = 0; i < requests_.size(); ++i )
+    {
+        requests_[ i ].blueprintId = FindBlueprintId( requestedBlueprints_[ i ] );
+        if ( requests_[ i ].blueprintId == 0 )
+        {
+            Fail( tr( "Unknown blueprint %1" ).arg( requestedBlueprints_[ i ] ) );
+            return;
+        }
+    }
+
+    if ( !inventoryPath_.isEmpty() )
+    {
+        // Read once the types are known, items can be given by name. The requests draw from it in order, see ComputeResults.
+        auto inventory = std::make_shared< Inventory >();
+        std::string error;
+        if ( !inventory->LoadFromFile( inventoryPath_, error ) )
+        {
+            Fail( tr( "Could not read the inventory %1: %2" ).arg( inventoryPath_, QString::fromStdString( error ) ) );
+            return;
+        }
+        for ( ProductionRequest& request : requests_ )
+            request.stock = inventory;
+    }
+
+    const std::vector< CliResult > results = ComputeResults();
+    const QByteArray output = outputFormat_ == "csv" ? FormatAsCsv( results ) : FormatAsJson( results );
+    if ( !WriteOutput( output ) )
+    {
+        Fail( tr( "Could not write results to %1" ).arg( outputPath_ ) );
+        return;
+    }
+    QCoreApplication::exit( EXIT_SUCCESS );
+}
+
+void CliApplication::OnErrorOccured( const QString& errorMessage )
+{
+    Fail( errorMessage );
+}
+
+std::vector< CliApplication::CliResult > CliApplication::ComputeResults() const
+{
+    std::vector< CliResult > results;
+    LPHelper oreSolver( GlobalRessources::GetOresMap() );
+    // One inventory for all the requests: what a request draws, owned ores included, is gone for the next ones.
+    std::optional< Inventory > stock;
+    if ( !requests_.empty() && requests_.front().stock != nullptr )
+        stock.emplace( *requests_.front().stock );
+    for ( ProductionRequest request : requests_ )
+    {
+        CliResult result;
+        if ( stock )
+            request.stock = std::make_shared< const Inventory >( *stock );
+        result.estimate = IndustryCalculator::Estimate( request );
+
+        std::map< tTypeId, unsigned int > oreRequirements;
+        for ( const auto& [ materialId, quantity ] : result.estimate.rawMaterials )
+            oreRequirements[ materialId ] = static_cast< unsigned int >( std::min< unsigned long long >( quantity, UINT_MAX ) );
+        if ( stock )
+        {
+            std::map< tTypeId, unsigned long long > ownedOres;
+            for ( const auto& [ typeId, quantity ] : result.estimate.usedStock )
+                stock->Take( typeId, quantity );
+            for ( const auto& [ oreId, orePtr ] : GlobalRessources::GetOresMap() )
+                ownedOres[ oreId ] = stock->GetQuantity( oreId );
+            oreSolver.SetOwnedOres( ownedOres );
+        }
+        result.isOreSolved = oreSolver.SolveForRequirements( oreRequirements );
+        if ( result.isOreSolved )
+        {
+            result.oreSolution = oreSolver.GetSolution();
+            for ( const auto& [ oreId, quantity ] : result.oreSolution.compressedOres )
+            {
+                const auto oreType = GlobalRessources::GetTypeById( oreId );
+                if ( oreType != nullptr )
+                    result.oreCost += oreType->GetMarketPrice().averagePrice * quantity;
+            }
+            for ( const auto& [ oreId, quantity ] : result.oreSolution.ownedOres )
+                result.estimate.usedStock[ oreId ] += stock->Take( oreId, quantity );
+        }
+        if ( scheduler_ )
+            result.schedule = JobScheduler::Schedule( JobScheduler::BuildPlan( request ), *scheduler_ );
+        results.push_back( std::move( result ) );
+    }
+    return results;
+}
+
+static QString GetTypeName( tTypeId typeId )
+{
+    const auto type = GlobalRessources::GetTypeById( typeId );
+    return type != nullptr ? QString::fromStdString( type->GetName() ) : QString();
+}
+
+static double GetAveragePrice( tTypeId typeId )
+{
+    const auto type = GlobalRessources::GetTypeById( typeId );
+    return type != nullptr ? type->GetMarketPrice().averagePrice : 0.0;
+}
+
+template < typename Quantity >
+static QJsonArray QuantitiesToJson( const std::map< tTypeId, Quantity >& quantities )
+{
+    QJsonArray array;
+    for ( const auto& [ typeId, quantity ] : quantities )
+    {
+        QJsonObject entry;
+        entry[ "typeId" ] = static_cast< qint64 >( typeId );
+        entry[ "name" ] = GetTypeName( typeId );
+        entry[ "quantity" ] = static_cast< qint64 >( quantity );
+        entry[ "totalPrice" ] = GetAveragePrice( typeId ) * static_cast< double >( quantity );
+        array.append( entry );
+    }
+    return array;
+}
+
+static QJsonObject ScheduleToJson( const ProductionSchedule& schedule )
+{
+    QJsonArray jobsArray;
+    for ( size_t job = 0; job < schedule.plan.size(); ++job )
+    {
+        const PlannedJob& plannedJob = schedule.plan[ job ];
+        const ScheduledJob& scheduledJob = schedule.jobs[ job ];
+        QJsonObject jobObj;
+        jobObj[ "blueprintId" ] = static_cast< qint64 >( plannedJob.blueprintId );
+        jobObj[ "blueprint" ] = GetTypeName( plannedJob.blueprintId );
+        const std::string_view activityKey = INDUSTRY_ACTIVITY_KEYS[ static_cast< size_t >( plannedJob.activity ) ];
+        jobObj[ "activity" ] = QString::fromUtf8( activityKey.data(), activityKey.size() );
+        jobObj[ "runs" ] = static_cast< qint64 >( plannedJob.runs );
+        jobObj[ "character" ] = static_cast< qint64 >( scheduledJob.character );
+        jobObj[ "slot" ] = static_cast< qint64 >( scheduledJob.slot );
+        jobObj[ "startSeconds" ] = scheduledJob.startSeconds;
+        jobObj[ "endSeconds" ] = scheduledJob.endSeconds;
+        QJsonArray dependencies;
+        for ( const size_t dependency : plannedJob.dependencies )
+            dependencies.append( static_cast< qint64 >( dependency ) );
+        jobObj[ "dependencies" ] = dependencies;
+        jobsArray.append( jobObj );
+    }
+    QJsonObject scheduleObj;
+    scheduleObj[ "makespanSeconds" ] = schedule.makespanSeconds;
+    scheduleObj[ "isMipRefined" ] = schedule.isMipRefined;
+    scheduleObj[ "jobs" ] = jobsArray;
+    return scheduleObj;
+}
+
+QByteArray CliApplication::FormatAsJson( const std::vector< CliResult >& results ) const
+{
+    QJsonArray resultsArray;
+    for ( const CliResult& result : results )
+    {
+        const ProductionEstimate& estimate = result.estimate;
+        QJsonObject resultObj;
+        resultObj[ "blueprintId" ] = static_cast< qint64 >( estimate.request.blueprintId );
+        resultObj[ "blueprint" ] = GetTypeName( estimate.request.blueprintId );
+        resultObj[ "runs" ] = static_cast< qint64 >( estimate.request.runs );
+        resultObj[ "materialEfficiency" ] = static_cast< qint64 >( estimate.request.materialEfficiency );
+        resultObj[ "materials" ] = QuantitiesToJson( estimate.rawMaterials );
+        resultObj[ "products" ] = QuantitiesToJson( estimate.products );
+        resultObj[ "stock" ] = QuantitiesToJson( estimate.usedStock );
+        resultObj[ "oreSolved" ] = result.isOreSolved;
+        resultObj[ "ores" ] = QuantitiesToJson( result.oreSolution.compressedOres );
+        resultObj[ "leftover" ] = QuantitiesToJson( result.oreSolution.leftover );
+        resultObj[ "materialCost" ] = estimate.materialCost;
+        resultObj[ "oreCost" ] = result.oreCost;
+        resultObj[ "productValue" ] = estimate.productValue;
+        resultObj[ "profit" ] = estimate.GetProfit();
+        if ( estimate.invention )
+        {
+            QJsonObject inventionObj;
+            inventionObj[ "decryptorId" ] = static_cast< qint64 >( estimate.invention->decryptorId );
+            if ( estimate.invention->decryptorId != 0 )
+                inventionObj[ "decryptor" ] = GetTypeName( estimate.invention->decryptorId );
+            inventionObj[ "probability" ] = estimate.invention->probability;
+            inventionObj[ "runsPerCopy" ] = static_cast< qint64 >( estimate.invention->runsPerCopy );
+            inventionObj[ "materialEfficiency" ] = static_cast< qint64 >( estimate.invention->materialEfficiency );
+            inventionObj[ "inventionCostPerRun" ] = estimate.invention->inventionCostPerRun;
+            inventionObj[ "materialCostPerRun" ] = estimate.invention->materialCostPerRun;
+            resultObj[ "invention" ] = inventionObj;
+        }
+        if ( result.schedule )
+            resultObj[ "schedule" ] = ScheduleToJson( *result.schedule );
+        resultsArray.append( resultObj );
+    }
+    QJsonObject root;
+    root[ "results" ] = resultsArray;
+    return QJsonDocument( root ).toJson( QJsonDocument::Indented );
+}
+
+static QString EscapeCsvField( const QString& field )
+{
+    if ( !field.contains( ',' ) && !field.contains( '"' ) && !field.contains( '\n' ) )
+        return field;
+    QString escaped = field;
+    escaped.replace( "\"", "\"\"" );
+    return "\"" + escaped + "\"";
+}
+
+template < typename Quantity >
+static void AppendCsvRows( QTextStream& stream, const QString& prefix, const char* section, const std::map< tTypeId, Quantity >& quantities )
+{
+    for ( const auto& [ typeId, quantity ] : quantities )
+    {
+        stream << prefix << section << ',' << typeId << ',' << EscapeCsvField( GetTypeName( typeId ) ) << ',' << quantity << ','
+               << QString::number( GetAveragePrice( typeId ) * static_cast< double >( quantity ), 'f', 2 ) << '\n';
+    }
+}
+
+QByteArray CliApplication::FormatAsCsv( const std::vector< CliResult >& results ) const
+{
+    QByteArray data;
+    QTextStream stream( &data );
+    stream << "blueprintId,blueprint,runs,materialEfficiency,section,typeId,name,quantity,totalPrice\n";
+    for ( const CliResult& result : results )
+    {
+        const ProductionEstimate& estimate = result.estimate;
+        const QString prefix = QString( "%1,%2,%3,%4," )
+                                   .arg( estimate.request.blueprintId )
+                                   .arg( EscapeCsvField( GetTypeName( estimate.request.blueprintId ) ) )
+                                   .arg( estimate.request.runs )
+                                   .arg( estimate.request.materialEfficiency );
+        AppendCsvRows( stream, prefix, "material", estimate.rawMaterials );
+        AppendCsvRows( stream, prefix, "product", estimate.products );
+        AppendCsvRows( stream, prefix, "stock", estimate.usedStock );
+        AppendCsvRows( stream, prefix, "ore", result.oreSolution.compressedOres );
+        AppendCsvRows( stream, prefix, "leftover", result.oreSolution.leftover );
+        stream << prefix << "summary,,materialCost,," << QString::number( estimate.materialCost, 'f', 2 ) << '\n';
+        stream << prefix << "summary,,oreCost,," << QString::number( result.oreCost, 'f', 2 ) << '\n';
+        stream << prefix << "summary,,productValue,," << QString::number( estimate.productValue, 'f', 2 ) << '\n';
+        stream << prefix << "summary,,profit,," << QString::number( estimate.GetProfit(), 'f', 2 ) << '\n';
+        if ( estimate.invention )
+        {
+            stream << prefix << "summary,,inventionCostPerRun,," << QString::number( estimate.invention->inventionCostPerRun, 'f', 2 )
+                   << '\n';
+        }
+        if ( result.schedule )
+            stream << prefix << "summary,,makespanSeconds,," << QString::number( result.schedule->makespanSeconds, 'f', 0 ) << '\n';
+    }
+    stream.flush();
+    return data;
+}
+
+bool CliApplication::WriteOutput( const QByteArray& data ) const
+{
+    QFile outputFile;
+    bool isOpen = false;
+    if ( outputPath_ == STDIO_PATH )
+        isOpen = outputFile.open( stdout, QIODevice::WriteOnly );
+    else
+    {
+        outputFile.setFileName( outputPath_ );
+        isOpen = outputFile.open( QIODevice::WriteOnly | QIODevice::Truncate );
+    }
+    if ( !isOpen )
+        return false;
+    return outputFile.write( data ) == data.size();
+}
+
+void CliApplication::Fail( const QString& errorMessage )
+{
+    LOG_WARNING( "{}", errorMessage.toStdString() );
+    std::cerr << errorMessage.toStdString() << std::endl;
+    QCoreApplication::exit( EXIT_FAILURE );
+}
@@ -0,0 +1,23 @@
+#include "CliApplication.h"
+#include "LogManager.h"
+#include <qcoreapplication.h>
+#include <qtimer.h>
+
+
+int main( int argc, char** argv )
+{
+    Profiler::EnableFromArguments( argc, argv );
+    PROFILE_THREAD_NAME( "Main" );
+
+    QCoreApplication app( argc, argv );
+    CliApplication cliApplication;
+    QTimer::singleShot( 0, &cliApplication, &CliApplication::Start );
+    const int rc = app.exec();
+
+    if ( Profiler::IsEnabled() )
+    {
+        const std::string tracePath = Profiler::ExportToLogDirectory();
+        LOG_NOTICE( "Profile written to {}", tracePath );
+    }
+    return rc;
+}
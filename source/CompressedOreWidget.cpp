@@ -1,6 +1,7 @@
 #include "CompressedOreWidget.h"
 #include "EveType.h"
 #include "GlobalRessources.h"
+#include "Profiler.h"
 
 #include <QTableWidget>
 #include <QVBoxLayout>
@@ -9,7 +10,6 @@ CompressedOreWidget::CompressedOreWidget( QWidget* parent )
     : QGroupBox( parent )
     , compressedOreTable_( new QTableWidget( this ) )
     , leftoverTable_( new QTableWidget( this ) )
-    , blueprintRequirementSolver_( LPHelper( GlobalRessources::GetOresMap() ) )
 {
     QVBoxLayout* mainLayout = new QVBoxLayout( this );
 
@@ -22,19 +22,28 @@ CompressedOreWidget::CompressedOreWidget( QWidget* parent )
     mainLayout->addWidget( leftoverTable_ );
 }
 
-void CompressedOreWidget::SetBlueprint( const std::shared_ptr< Blueprint > blueprint )
+void CompressedOreWidget::Clear()
 {
-    compressedOreTable_->clear();
-    leftoverTable_->clear();
+    compressedOreTable_->clearContents();
+    compressedOreTable_->setRowCount( 0 );
+    leftoverTable_->clearContents();
+    leftoverTable_->setRowCount( 0 );
+}
 
-    if ( !blueprintRequirementSolver_.SolveForBlueprint( *blueprint ) )
-    {
-        QTableWidgetItem* errorIrem = new QTableWidgetItem( "Failed to solve the blueprint" );
-        compressedOreTable_->setItem( 0, 0, errorIrem );
-        return;
-    }
+void CompressedOreWidget::SetSolveFailed()
+{
+    Clear();
+    compressedOreTable_->setRowCount( 1 );
+    QTableWidgetItem* errorIrem = new QTableWidgetItem( "Failed to solve the blueprint" );
+    compressedOreTable_->setItem( 0, 0, errorIrem );
+}
+
+void CompressedOreWidget::SetOreSolution( const OreSolution& solution )
+{
+    PROFILE_FUNCTION();
+    Clear();
 
-    const auto& compressedOres = blueprintRequirementSolver_.GetResult();
+    const auto& compressedOres = solution.compressedOres;
     compressedOreTable_->setRowCount( static_cast< int >( compressedOres.size() ) );
     int row = 0;
     for ( const auto& [ oreTypeId, quantity ] : compressedOres )
@@ -51,7 +60,7 @@ void CompressedOreWidget::SetBlueprint( const std::shared_ptr< Blueprint > bluep
         row++;
     }
 
-    const auto& leftovers = blueprintRequirementSolver_.GetLeftover();
+    const auto& leftovers = solution.leftover;
     leftoverTable_->setRowCount( static_cast< int >( leftovers.size() ) );
     row = 0;
     for ( const auto& [ mineralTypeId, quantity ] : leftovers )
@@ -3,6 +3,8 @@
 #include "RessourcesManager.h"
 #include "ZipExtractor.h"
 
+#include <QDateTime>
+#include <QFileInfo>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonParseError>
@@ -12,7 +14,9 @@
 #include <qdir.h>
 #include <zip.h>
 
-static constexpr const char* SDE_URL = "https://developers.eveonline.com/static-data/tranquility/eve-online-static-data-3031812-jsonl.zip";
+static constexpr qint64 SDE_BUILD_NUMBER = 3031812;
+static constexpr const char* SDE_URL_FORMAT =
+    "https://developers.eveonline.com/static-data/tranquility/eve-online-static-data-%1-jsonl.zip";
 static constexpr const char* MARKET_PRICES_URL = "https://esi.evetech.net/latest/markets/prices/?datasource=tranquility";
 
 DataLoader::DataLoader( QObject* parent )
@@ -33,6 +37,11 @@ void DataLoader::StartDataLoading()
     DownloadSde();
 }
 
+void DataLoader::SetProgressReporter( std::shared_ptr< ProgressReporter > progress )
+{
+    progress_ = std::move( progress );
+}
+
 QString DataLoader::GetSdeExtractedPath() const
 {
     return sdeExtractedPath_;
@@ -43,6 +52,16 @@ QJsonObject&& DataLoader::GetMarketPricesJson()
     return std::move( marketPricesJson_ );
 }
 
+qint64 DataLoader::GetMarketPricesTimestamp() const
+{
+    return marketPricesTimestamp_;
+}
+
+qint64 DataLoader::GetSdeBuildNumber()
+{
+    return SDE_BUILD_NUMBER;
+}
+
 void DataLoader::OnSdeDownloadFinished( bool isSuccess )
 {
     if ( !isSuccess )
@@ -51,6 +70,7 @@ void DataLoader::OnSdeDownloadFinished( bool isSuccess )
         return;
     }
     LOG_NOTICE( "SDE downloaded successfully." );
+    emit LoadingBytesRead( QFileInfo( sdeZipPath_ ).size() );
     sdeDownloader_->deleteLater();
     emit SdeDownloaded();
 }
@@ -58,6 +78,7 @@ void DataLoader::OnSdeDownloadFinished( bool isSuccess )
 void DataLoader::MarketPricesDownloaded( QByteArray data )
 {
     marketPricesDownloader_->deleteLater();
+    emit LoadingBytesRead( data.size() );
     if ( data.isEmpty() )
     {
         TriggerError( "Failed to download market prices." );
@@ -100,6 +121,7 @@ void DataLoader::MarketPricesDownloaded( QByteArray data )
         priceObj[ "adjusted_price" ] = adjustedPrice;
         marketPricesJson_[ QString::number( typeId ) ] = priceObj;
     }
+    marketPricesTimestamp_ = QDateTime::currentMSecsSinceEpoch();
     LOG_NOTICE( "Market prices downloaded and parsed successfully." );
     emit MarketPricesReady();
 }
@@ -107,12 +129,20 @@ void DataLoader::MarketPricesDownloaded( QByteArray data )
 void DataLoader::DownloadSde()
 {
     sdeDownloader_ = new FileDownloader( this );
-    connect( sdeDownloader_,
-             &FileDownloader::DownloadProgress,
-             [ this ]( qint64 current, qint64 total ) { emit SubDataLoadingStepChanged( current, total, "Downloading SDE" ); } );
+    connect( sdeDownloader_, &FileDownloader::DownloadProgress, this, &DataLoader::OnDownloadProgress );
     connect( sdeDownloader_, &FileDownloader::DownloadFinished, this, &DataLoader::OnSdeDownloadFinished );
     SetLoadingStep( eDataLoadingSteps::DownloadingSde );
-    sdeDownloader_->Start( sdeZipPath_, SDE_URL );
+    if ( progress_ )
+        progress_->SetSubTask( "Downloading SDE", 0 );
+    sdeDownloader_->Start( sdeZipPath_, QString( SDE_URL_FORMAT ).arg( SDE_BUILD_NUMBER ) );
+}
+
+void DataLoader::OnDownloadProgress( qint64 current, qint64 total )
+{
+    if ( !progress_ )
+        return;
+    progress_->SetSubTotal( total );
+    progress_->SetSubProgress( current );
 }
 
 void DataLoader::SetLoadingStep( eDataLoadingSteps step )
@@ -128,14 +158,12 @@ void DataLoader::ExtractSde()
     SetLoadingStep( eDataLoadingSteps::ExtractingSde );
 
     ZipExtractor zipExtractor;
-    connect( &zipExtractor,
-             &ZipExtractor::ExtractionProgress,
-             [ this ]( uint current, uint total, const QString& fileName )
-             { emit SubDataLoadingStepChanged( current, total, fileName ); } );
+    zipExtractor.SetProgressReporter( progress_.get() );
     connect( &zipExtractor, &ZipExtractor::ErrorOccurred, this, &DataLoader::TriggerError );
     const bool isSuccess = zipExtractor.ExtractZip( sdeZipPath_.toStdString().c_str(), sdeExtractedPath_.toStdString().c_str() );
     if ( !isSuccess )
         return;
+    emit LoadingBytesRead( QFileInfo( sdeZipPath_ ).size() );
     LOG_NOTICE( "SDE extracted successfully." );
     emit SdeExtracted();
 }
@@ -144,10 +172,7 @@ void DataLoader::ValidateSde()
 {
     SetLoadingStep( eDataLoadingSteps::ValidatingSde );
     ZipExtractor zipExtractor;
-    connect( &zipExtractor,
-             &ZipExtractor::ValidationProgress,
-             [ this ]( uint current, uint total, const QString& fileName )
-             { emit SubDataLoadingStepChanged( current, total, fileName ); } );
+    zipExtractor.SetProgressReporter( progress_.get() );
     connect( &zipExtractor, &ZipExtractor::ErrorOccurred, this, &DataLoader::TriggerError );
     const bool isSuccess = zipExtractor.ValidateExtractedData( sdeZipPath_.toStdString().c_str(), sdeExtractedPath_.toStdString().c_str() );
     if ( !isSuccess )
@@ -159,11 +184,11 @@ void DataLoader::ValidateSde()
 void DataLoader::DownloadMarketPrices()
 {
     marketPricesDownloader_ = new FileDownloader( this );
-    connect( marketPricesDownloader_,
-             &FileDownloader::DownloadProgress,
-             [ this ]( qint64 current, qint64 total ) { emit SubDataLoadingStepChanged( current, total, "Downloading Market prices" ); } );
+    connect( marketPricesDownloader_, &FileDownloader::DownloadProgress, this, &DataLoader::OnDownloadProgress );
     connect( marketPricesDownloader_, &FileDownloader::DownloadFinishedWithData, this, &DataLoader::MarketPricesDownloaded );
     SetLoadingStep( eDataLoadingSteps::FetchingMarketPrices );
+    if ( progress_ )
+        progress_->SetSubTask( "Downloading Market prices", 0 );
     marketPricesDownloader_->Start( MARKET_PRICES_URL );
 }
 
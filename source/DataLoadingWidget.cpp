@@ -1,37 +1,100 @@
 #include "DataLoadingWidget.h"
 #include "LogManager.h"
+#include "ProgressReporter.h"
 
 #include <QLabel>
 #include <QProgressBar>
+#include <QTimer>
 #include <QVBoxLayout>
 
+#include <algorithm>
+#include <limits>
+
+static constexpr int REFRESH_INTERVAL_MS = 33; // About 30 refreshes per second, whatever the loaders' pace.
+
 DataLoadingWidget::DataLoadingWidget( QWidget* parent )
     : QGroupBox( parent )
+    , refreshTimer_( new QTimer( this ) )
     , mainProgressBar_( new QProgressBar )
     , subProgressBar_( new QProgressBar )
     , mainProgressLabel_( new QLabel( "Main Progress" ) )
     , subProgressLabel_( new QLabel( "Sub Progress" ) )
+    , throughputLabel_( new QLabel )
 {
     QVBoxLayout* mainLayout = new QVBoxLayout;
     mainLayout->addWidget( mainProgressLabel_, Qt::AlignHCenter | Qt::AlignBottom );
     mainLayout->addWidget( mainProgressBar_ );
     mainLayout->addWidget( subProgressBar_ );
     mainLayout->addWidget( subProgressLabel_, Qt::AlignHCenter | Qt::AlignTop );
+    mainLayout->addWidget( throughputLabel_, Qt::AlignHCenter | Qt::AlignTop );
     setLayout( mainLayout );
+
+    refreshTimer_->setInterval( REFRESH_INTERVAL_MS );
+    connect( refreshTimer_, &QTimer::timeout, this, &DataLoadingWidget::RefreshProgress );
+}
+
+void DataLoadingWidget::SetProgressReporter( std::shared_ptr< const ProgressReporter > progress )
+{
+    progress_ = std::move( progress );
+    if ( progress_ && isVisible() )
+        refreshTimer_->start();
+}
+
+void DataLoadingWidget::showEvent( QShowEvent* event )
+{
+    QGroupBox::showEvent( event );
+    if ( progress_ )
+        refreshTimer_->start();
+}
+
+void DataLoadingWidget::hideEvent( QHideEvent* event )
+{
+    QGroupBox::hideEvent( event );
+    refreshTimer_->stop();
+}
+
+void DataLoadingWidget::RefreshProgress()
+{
+    if ( !progress_ )
+        return;
+
+    const ProgressSnapshot snapshot = progress_->Sample();
+    SetProgressBar( mainProgressBar_, snapshot.mainStep, snapshot.mainStepCount );
+    mainProgressLabel_->setText(
+        QString( "%1 : %2/%3" ).arg( snapshot.mainDescription ).arg( snapshot.mainStep ).arg( snapshot.mainStepCount ) );
+    SetProgressBar( subProgressBar_, snapshot.subCurrent, snapshot.subTotal );
+    if ( snapshot.subTotal > 0 )
+        subProgressLabel_->setText(
+            QString( "%1 : %2/%3" ).arg( snapshot.subDescription ).arg( snapshot.subCurrent ).arg( snapshot.subTotal ) );
+    else
+        subProgressLabel_->setText( snapshot.subDescription );
+    ShowThroughput( snapshot );
 }
 
-void DataLoadingWidget::OnMainDataLoadingStepChanged( int currentStep, int maxStep, const QString& description )
+void DataLoadingWidget::SetProgressBar( QProgressBar* progressBar, qint64 current, qint64 total )
 {
-    mainProgressBar_->setMaximum( maxStep );
-    mainProgressBar_->setValue( currentStep );
-    mainProgressLabel_->setText( QString( "%1 : %2/%3" ).arg( description ).arg( currentStep ).arg( maxStep ) );
+    // Byte counts of downloads can overflow the int range of QProgressBar.
+    int shift = 0;
+    while ( ( total >> shift ) > std::numeric_limits< int >::max() )
+        ++shift;
+    progressBar->setMaximum( static_cast< int >( total >> shift ) );
+    progressBar->setValue( static_cast< int >( std::min( current, total ) >> shift ) );
 }
 
-void DataLoadingWidget::OnSubDataLoadingStepChanged( int currentStep, int maxStep, const QString& description )
+void DataLoadingWidget::ShowThroughput( const ProgressSnapshot& snapshot )
 {
-    subProgressBar_->setMaximum( maxStep );
-    subProgressBar_->setValue( currentStep );
-    subProgressLabel_->setText( QString( "%1 : %2/%3" ).arg( description ).arg( currentStep ).arg( maxStep ) );
+    QStringList parts;
+    if ( snapshot.bytesPerSecond > 0.0 )
+        parts.append( tr( "%1 MiB/s" ).arg( snapshot.bytesPerSecond / ( 1024.0 * 1024.0 ), 0, 'f', 1 ) );
+    if ( snapshot.recordsPerSecond > 0.0 )
+        parts.append( tr( "%1 records/s" ).arg( static_cast< qint64 >( snapshot.recordsPerSecond ) ) );
+    // The estimate comes from the previous loads on this machine, the first load has none.
+    if ( snapshot.etaSeconds >= 0.0 )
+    {
+        const int totalSeconds = static_cast< int >( snapshot.etaSeconds + 0.5 );
+        parts.append( tr( "about %1:%2 remaining" ).arg( totalSeconds / 60 ).arg( totalSeconds % 60, 2, 10, QChar( '0' ) ) );
+    }
+    throughputLabel_->setText( parts.join( " - " ) );
 }
 
 void DataLoadingWidget::OnErrorOccurred( const QString& errorMessage )
@@ -41,4 +104,7 @@ void DataLoadingWidget::OnErrorOccurred( const QString& errorMessage )
     mainProgressBar_->hide();
     subProgressBar_->hide();
     subProgressLabel_->hide();
+    throughputLabel_->hide();
+    refreshTimer_->stop();
+    progress_.reset();
 }
@@ -1,4 +1,6 @@
 #include "EveType.h"
+#include "JsonlWriter.h"
+#include "SdeImport.h"
 
 #include <QJsonObject>
 
@@ -7,6 +9,27 @@ EveType::EveType( const QJsonObject& jsonData )
     FromJsonObject( jsonData );
 }
 
+EveType::EveType( const SdeTypeRecord& record )
+{
+    typeId_ = record.typeId;
+    isValid_ = record.isValid;
+    isPublished_ = record.isPublished;
+    groupId_ = record.groupId;
+    if ( record.categoryId.has_value() )
+        categoryId_ = record.categoryId;
+    if ( record.marketGroupId.has_value() )
+        marketGroupId_ = record.marketGroupId;
+    if ( record.iconId.has_value() )
+        iconId_ = record.iconId;
+    if ( record.basePrice.has_value() )
+        basePrice_ = record.basePrice;
+    if ( record.volume.has_value() )
+        volume_ = record.volume;
+    name_ = record.name;
+    if ( record.description.has_value() )
+        description_ = std::string( *record.description );
+}
+
 void EveType::FromJsonObject( const QJsonObject& jsonData )
 {
     if ( jsonData.isEmpty() )
@@ -53,47 +76,40 @@ void EveType::FromJsonObject( const QJsonObject& jsonData )
     isValid_ = true;
 }
 
-QJsonObject EveType::ToJsonObject() const
+void EveType::WriteJson( JsonlWriter& writer ) const
 {
-    QJsonObject obj;
-
-    obj[ "_key" ] = QString::number( typeId_ );
-    obj[ "groupID" ] = QString::number( groupId_ );
-
+    writer.BeginObject();
+    writer.Member( "_key", typeId_ );
+    writer.Member( "published", isPublished_ );
+    writer.Member( "groupID", groupId_ );
     if ( categoryId_.has_value() )
-        obj[ "categoryID" ] = QString::number( categoryId_.value() );
-
+        writer.Member( "categoryID", categoryId_.value() );
     if ( marketGroupId_.has_value() )
-        obj[ "marketGroupID" ] = QString::number( marketGroupId_.value() );
-
+        writer.Member( "marketGroupID", marketGroupId_.value() );
     if ( iconId_.has_value() )
-        obj[ "iconID" ] = QString::number( iconId_.value() );
-
+        writer.Member( "iconID", iconId_.value() );
     if ( !name_.empty() )
     {
-        QJsonObject nameObj;
-        nameObj[ "en" ] = QString::fromStdString( name_ );
-        obj[ "name" ] = nameObj;
+        writer.Key( "name" );
+        writer.BeginObject();
+        writer.Member( "en", name_ );
+        writer.EndObject();
     }
-
     if ( description_.has_value() )
-        obj[ "description" ] = QString::fromStdString( description_.value() );
-
+        writer.Member( "description", description_.value() );
     if ( basePrice_.has_value() )
-        obj[ "basePrice" ] = basePrice_.value();
-
+        writer.Member( "basePrice", basePrice_.value() );
     if ( volume_.has_value() )
-        obj[ "volume" ] = volume_.value();
-
-    obj[ "isManufacturable" ] = isManufacturable_;
-    obj[ "sourceBlueprintId" ] = static_cast< qint64 >( sourceBlueprintId_ );
-
-    QJsonObject marketPriceObj;
-    marketPriceObj[ "averagePrice" ] = marketPrice_.averagePrice;
-    marketPriceObj[ "adjustedPrice" ] = marketPrice_.adjustedPrice;
-    obj[ "marketPrice" ] = marketPriceObj;
-    obj[ "reprocessedFromOre" ] = isReprocessedFromOre_;
-    return obj;
+        writer.Member( "volume", volume_.value() );
+    writer.Member( "isManufacturable", isManufacturable_ );
+    writer.Member( "sourceBlueprintId", sourceBlueprintId_ );
+    writer.Key( "marketPrice" );
+    writer.BeginObject();
+    writer.Member( "averagePrice", marketPrice_.averagePrice );
+    writer.Member( "adjustedPrice", marketPrice_.adjustedPrice );
+    writer.EndObject();
+    writer.Member( "reprocessedFromOre", isReprocessedFromOre_ );
+    writer.EndObject();
 }
 
 void EveType::PostLoadingInitialization()
@@ -39,6 +39,15 @@ const TypeIdMap< Ore >& GlobalRessources::GetOresMap()
     return Get().ores_;
 }
 
+const ActivityGraph& GlobalRessources::GetActivityGraph()
+{
+    if ( !Get().areRessourcesReady_ )
+    {
+        throw std::runtime_error( "Ressources are not ready yet." );
+    }
+    return Get().activityGraph_;
+}
+
 const std::shared_ptr< EveType > GlobalRessources::GetTypeById( tTypeId typeId )
 {
     if ( !Get().GetTypesMap().contains( typeId ) )
@@ -57,16 +66,10 @@ const std::shared_ptr< Blueprint > GlobalRessources::GetBlueprintById( tTypeId t
 
 const std::shared_ptr< Blueprint > GlobalRessources::GetBlueprintByProductId( tTypeId productId )
 {
-    for ( const auto& [ _, blueprint ] : Get().blueprints_ )
-    {
-        const auto& products = blueprint->GetManufacturingJob()->GetManufacturedProducts();
-        for ( const auto& [ typeId, _ ] : products )
-        {
-            if ( typeId == productId )
-                return blueprint;
-        }
-    }
-    return nullptr;
+    const std::optional< uint32_t > activityIndex = GetActivityGraph().FindProductionActivity( productId );
+    if ( !activityIndex )
+        return nullptr;
+    return GetBlueprintById( GetActivityGraph().GetActivity( *activityIndex ).blueprintId );
 }
 
 void GlobalRessources::ISetRessources( TypeIdMap< EveType >&& types, TypeIdMap< Blueprint >&& blueprints, TypeIdMap< Ore >&& ores )
@@ -76,6 +79,7 @@ void GlobalRessources::ISetRessources( TypeIdMap< EveType >&& types, TypeIdMap<
     types_ = std::move( types );
     blueprints_ = std::move( blueprints );
     ores_ = std::move( ores );
+    activityGraph_.Build( blueprints_ );
     areRessourcesReady_ = true;
 
     for ( auto& type : types_ )
@@ -0,0 +1,162 @@
+#include "IndustryCalculator.h"
+#include "Blueprint.h"
+#include "EveType.h"
+#include "GlobalRessources.h"
+#include "Inventory.h"
+#include "LogManager.h"
+
+#include <algorithm>
+#include <cmath>
+
+std::map< tTypeId, unsigned long long > IndustryCalculator::ComputeRawMaterials( tTypeId blueprintId,
+                                                                                unsigned long long runs,
+                                                                                unsigned int materialEfficiency,
+                                                                                const std::optional< InventionSkills >& invention,
+                                                                                BuildOrBuyOptimizer* buildOrBuy,
+                                                                                Inventory* stock )
+{
+    std::map< tTypeId, unsigned long long > rawMaterials;
+    const auto blueprint = GlobalRessources::GetBlueprintById( blueprintId );
+    if ( blueprint == nullptr || blueprint->GetProductionJob() == nullptr )
+    {
+        LOG_WARNING( "Blueprint {} has no manufacturing job to expand.", blueprintId );
+        return rawMaterials;
+    }
+    AddRawMaterials( *blueprint, runs, materialEfficiency, invention, buildOrBuy, stock, rawMaterials );
+    if ( stock == nullptr )
+        return rawMaterials;
+
+    // Components were drawn from the stock level by level, raw materials are leaves and can be drawn from at once.
+    for ( auto it = rawMaterials.begin(); it != rawMaterials.end(); )
+    {
+        it->second -= stock->Take( it->first, it->second );
+        it = it->second == 0 ? rawMaterials.erase( it ) : std::next( it );
+    }
+    return rawMaterials;
+}
+
+ProductionEstimate IndustryCalculator::Estimate( const ProductionRequest& request )
+{
+    ProductionEstimate estimate;
+    estimate.request = request;
+    std::optional< BuildOrBuyOptimizer > buildOrBuy;
+    if ( request.buildOrBuy )
+        buildOrBuy.emplace( *request.buildOrBuy, request.materialEfficiency );
+    std::optional< Inventory > stock;
+    if ( request.stock != nullptr )
+    {
+        stock.emplace( *request.stock );
+        stock->ClearTakenQuantities();
+    }
+    estimate.rawMaterials = ComputeRawMaterials( request.blueprintId,
+                                                 request.runs,
+                                                 request.materialEfficiency,
+                                                 request.invention,
+                                                 buildOrBuy ? &*buildOrBuy : nullptr,
+                                                 stock ? &*stock : nullptr );
+    if ( stock )
+        estimate.usedStock = stock->GetTakenQuantities();
+    if ( request.invention )
+    {
+        const std::optional< InventionEstimate > invention = InventionCalculator::Estimate( request.blueprintId, *request.invention );
+        if ( invention )
+            estimate.invention = invention->GetBestOption();
+    }
+
+    const auto blueprint = GlobalRessources::GetBlueprintById( request.blueprintId );
+    if ( blueprint != nullptr && blueprint->GetProductionJob() != nullptr )
+    {
+        for ( const auto& [ productId, quantity ] : blueprint->GetProductionJob()->GetManufacturedProducts() )
+            estimate.products[ productId ] += static_cast< unsigned long long >( quantity ) * request.runs;
+    }
+
+    for ( const auto& [ materialId, quantity ] : estimate.rawMaterials )
+    {
+        const auto type = GlobalRessources::GetTypeById( materialId );
+        if ( type != nullptr )
+            estimate.materialCost += type->GetMarketPrice().averagePrice * static_cast< double >( quantity );
+    }
+    for ( const auto& [ productId, quantity ] : estimate.products )
+    {
+        const auto type = GlobalRessources::GetTypeById( productId );
+        if ( type != nullptr )
+            estimate.productValue += type->GetMarketPrice().averagePrice * static_cast< double >( quantity );
+    }
+    return estimate;
+}
+
+unsigned long long IndustryCalculator::ApplyMaterialEfficiency( unsigned int baseQuantity, unsigned long long runs, unsigned int materialEfficiency )
+{
+    const double efficiency = 1.0 - static_cast< double >( std::min( materialEfficiency, MAX_MATERIAL_EFFICIENCY ) ) / 100.0;
+    const double quantity = std::ceil( static_cast< double >( baseQuantity ) * static_cast< double >( runs ) * efficiency );
+    return std::max( runs, static_cast< unsigned long long >( quantity ) );
+}
+
+void IndustryCalculator::AddRawMaterials( const Blueprint& blueprint,
+                                          unsigned long long runs,
+                                          unsigned int materialEfficiency,
+                                          const std::optional< InventionSkills >& invention,
+                                          BuildOrBuyOptimizer* buildOrBuy,
+                                          Inventory* stock,
+                                          std::map< tTypeId, unsigned long long >& rawMaterials )
+{
+    const ManufacturingJob& job = *blueprint.GetProductionJob();
+    // Reaction formulas cannot be researched.
+    unsigned int efficiency = job.GetActivity() == eIndustryActivity::Manufacturing ? materialEfficiency : 0;
+    if ( invention )
+    {
+        // Invented copies come with the efficiency of the decryptor, not a researched one.
+        const std::optional< InventionEstimate > inventionEstimate = InventionCalculator::Estimate( blueprint.GetTypeId(), *invention );
+        if ( inventionEstimate && !inventionEstimate->options.empty() )
+        {
+            efficiency = inventionEstimate->GetBestOption().materialEfficiency;
+            AddInventionMaterials( *inventionEstimate, runs, rawMaterials );
+        }
+    }
+    for ( const auto& [ materialId, quantity ] : job.GetRawMaterials() )
+        rawMaterials[ materialId ] += ApplyMaterialEfficiency( quantity, runs, efficiency );
+
+    const ActivityGraph& graph = GlobalRessources::GetActivityGraph();
+    for ( const auto& [ componentId, quantity ] : job.GetComponents() )
+    {
+        unsigned long long needed = ApplyMaterialEfficiency( quantity, runs, efficiency );
+        if ( stock != nullptr )
+        {
+            needed -= stock->Take( componentId, needed );
+            if ( needed == 0 )
+                continue;
+        }
+        const std::optional< uint32_t > componentActivity = graph.FindProductionActivity( componentId );
+        const auto componentBlueprint =
+            componentActivity ? GlobalRessources::GetBlueprintById( graph.GetActivity( *componentActivity ).blueprintId ) : nullptr;
+        if ( componentBlueprint == nullptr || componentBlueprint->GetProductionJob() == nullptr
+             || ( buildOrBuy != nullptr && !buildOrBuy->IsBuilt( componentId ) ) )
+        {
+            rawMaterials[ componentId ] += needed;
+            continue;
+        }
+
+        const unsigned long long producedPerRun =
+            std::max( graph.GetProducedQuantity( *componentActivity, *graph.FindType( componentId ) ), 1u );
+        const unsigned long long componentRuns = ( needed + producedPerRun - 1 ) / producedPerRun;
+        AddRawMaterials( *componentBlueprint, componentRuns, materialEfficiency, invention, buildOrBuy, stock, rawMaterials );
+    }
+}
+
+void IndustryCalculator::AddInventionMaterials( const InventionEstimate& estimate,
+                                                unsigned long long runs,
+                                                std::map< tTypeId, unsigned long long >& rawMaterials )
+{
+    const InventionOption& option = estimate.GetBestOption();
+    if ( option.runsPerCopy == 0 || option.probability <= 0.0 )
+        return;
+
+    // Whole attempts, each succeeding with the invention probability and giving a copy of runsPerCopy runs.
+    // The T1 copies consumed by the attempts are not materials and are left out.
+    const unsigned long long attempts =
+        static_cast< unsigned long long >( std::ceil( static_cast< double >( runs ) / ( option.probability * option.runsPerCopy ) ) );
+    for ( const auto& [ materialId, quantity ] : estimate.attemptMaterials )
+        rawMaterials[ materialId ] += static_cast< unsigned long long >( quantity ) * attempts;
+    if ( option.decryptorId != 0 )
+        rawMaterials[ option.decryptorId ] += attempts;
+}
@@ -1,20 +1,29 @@
 #include "IndustryPage.h"
 #include "Blueprint.h"
 #include "BlueprintMaterialRequirementDisplay.h"
+#include "BlueprintSolveExecutor.h"
 #include "CompressedOreWidget.h"
 #include "EveType.h"
 #include "GlobalRessources.h"
+#include "Profiler.h"
 #include "RessourcesManager.h"
 
 #include <QComboBox>
 #include <QGridLayout>
 #include <QVBoxLayout>
 
+static constexpr const char* ORE_SOLUTION_CACHE_FILENAME = "oreSolutions.bin";
+
 IndustryPage::IndustryPage( QWidget* parent )
     : QWidget( parent )
     , blueprintMaterialRequirementDisplay_( new BlueprintMaterialRequirementDisplay( this ) )
     , compressedOreWidget_( new CompressedOreWidget( this ) )
+    , solveExecutor_( new BlueprintSolveExecutor( RessourcesManager::GetBinaryDataDirectoryPath() + ORE_SOLUTION_CACHE_FILENAME, this ) )
 {
+    connect( solveExecutor_, &BlueprintSolveExecutor::BomReady, this, &IndustryPage::OnBomReady, Qt::QueuedConnection );
+    connect( solveExecutor_, &BlueprintSolveExecutor::OreSolutionReady, this, &IndustryPage::OnOreSolutionReady, Qt::QueuedConnection );
+    connect( solveExecutor_, &BlueprintSolveExecutor::OreSolveFailed, this, &IndustryPage::OnOreSolveFailed, Qt::QueuedConnection );
+
     QGridLayout* mainLayout = new QGridLayout( this );
     QComboBox* blueprintSelectionCombobox = BuildBlueprintsComboBox();
     mainLayout->addWidget( blueprintSelectionCombobox, 0, 0, 1, 2 );
@@ -38,16 +47,42 @@ QComboBox* IndustryPage::BuildBlueprintsComboBox()
              this,
              [ this, result ]( int index )
              {
+                 PROFILE_ZONE( "IndustryPage::OnBlueprintSelected" );
                  if ( index < 0 )
                      return;
                  tTypeId typeId = result->currentData().toUInt();
                  const std::shared_ptr< Blueprint > blueprint = GlobalRessources::GetBlueprintById( typeId );
                  if ( blueprint != nullptr )
                  {
-                     blueprintMaterialRequirementDisplay_->SetBlueprint( blueprint );
-                     compressedOreWidget_->SetBlueprint( blueprint );
+                     blueprintMaterialRequirementDisplay_->SetBlueprint( nullptr );
+                     compressedOreWidget_->Clear();
+                     solveExecutor_->Submit( blueprint );
                  }
              } );
 
     return result;
 }
+
+void IndustryPage::OnBomReady( quint64 generation, std::shared_ptr< const Blueprint > blueprint )
+{
+    PROFILE_FUNCTION();
+    if ( !solveExecutor_->IsCurrentGeneration( generation ) )
+        return;
+    blueprintMaterialRequirementDisplay_->SetBlueprint( blueprint );
+}
+
+void IndustryPage::OnOreSolutionReady( quint64 generation, const OreSolution& solution )
+{
+    PROFILE_FUNCTION();
+    if ( !solveExecutor_->IsCurrentGeneration( generation ) )
+        return;
+    compressedOreWidget_->SetOreSolution( solution );
+}
+
+void IndustryPage::OnOreSolveFailed( quint64 generation )
+{
+    PROFILE_FUNCTION();
+    if ( !solveExecutor_->IsCurrentGeneration( generation ) )
+        return;
+    compressedOreWidget_->SetSolveFailed();
+}
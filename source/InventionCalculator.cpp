@@ -0,0 +1,175 @@
+#include "InventionCalculator.h"
+#include "ActivityGraph.h"
+#include "EveType.h"
+#include "GlobalRessources.h"
+#include "IndustryCalculator.h"
+#include "LogManager.h"
+
+#include <QThread>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <set>
+
+static constexpr size_t OPTION_COUNT = 9;
+
+// Modifiers of every decryptor as parallel arrays, the first entry is inventing without one.
+struct DecryptorTable
+{
+    std::array< tTypeId, OPTION_COUNT > typeIds;
+    std::array< double, OPTION_COUNT > probabilityMultipliers;
+    std::array< int, OPTION_COUNT > runModifiers;
+    std::array< int, OPTION_COUNT > materialEfficiencyModifiers;
+    std::array< int, OPTION_COUNT > timeEfficiencyModifiers;
+};
+
+// Accelerant, Attainment, Augmentation, Parity, Process, Symmetry, Optimized Attainment and Optimized Augmentation.
+static constexpr DecryptorTable DECRYPTORS = {
+    { 0, 34201, 34202, 34203, 34204, 34205, 34206, 34207, 34208 },
+    { 1.0, 1.2, 1.8, 0.6, 1.5, 1.1, 1.0, 1.9, 0.9 },
+    { 0, 1, 4, 9, 3, 0, 2, 2, 7 },
+    { 0, 2, -1, -2, 1, 3, 1, 1, 2 },
+    { 0, 10, 4, 2, -2, 6, 8, -2, 0 },
+};
+
+static double GetAveragePrice( tTypeId typeId )
+{
+    const auto type = GlobalRessources::GetTypeById( typeId );
+    return type != nullptr ? type->GetMarketPrice().averagePrice : 0.0;
+}
+
+static double GetMaterialCostPerRun( tTypeId blueprintId, unsigned int runs, unsigned int materialEfficiency )
+{
+    double cost = 0.0;
+    for ( const auto& [ materialId, quantity ] : IndustryCalculator::ComputeRawMaterials( blueprintId, runs, materialEfficiency ) )
+        cost += GetAveragePrice( materialId ) * static_cast< double >( quantity );
+    return cost / static_cast< double >( runs );
+}
+
+std::optional< InventionEstimate > InventionCalculator::Estimate( tTypeId blueprintId, const InventionSkills& skills )
+{
+    PROFILE_FUNCTION();
+    const ActivityGraph& graph = GlobalRessources::GetActivityGraph();
+    const std::optional< uint32_t > invention = graph.FindProducer( blueprintId, eIndustryActivity::Invention );
+    if ( !invention )
+        return std::nullopt;
+    const ActivityNode& node = graph.GetActivity( *invention );
+    const unsigned int baseRuns = graph.GetProducedQuantity( *invention, *graph.FindType( blueprintId ) );
+    if ( baseRuns == 0 || node.probability <= 0.0 )
+        return std::nullopt;
+
+    InventionEstimate estimate;
+    estimate.blueprintId = blueprintId;
+    estimate.sourceBlueprintId = node.blueprintId;
+    double datacoresCost = 0.0;
+    for ( const ActivityEdge& input : graph.GetInputs( *invention ) )
+    {
+        if ( input.kind != eActivityEdge::Material )
+            continue;
+        const tTypeId materialId = graph.GetTypeId( input.typeIndex );
+        estimate.attemptMaterials.push_back( { materialId, input.quantity } );
+        datacoresCost += GetAveragePrice( materialId ) * static_cast< double >( input.quantity );
+    }
+
+    std::array< double, OPTION_COUNT > decryptorPrices = {};
+    for ( size_t option = 1; option < OPTION_COUNT; ++option )
+        decryptorPrices[ option ] = GetAveragePrice( DECRYPTORS.typeIds[ option ] );
+
+    const double skillMultiplier = 1.0 + static_cast< double >( skills.encryptionMethods ) / 40.0
+                                   + static_cast< double >( skills.firstScience + skills.secondScience ) / 30.0;
+    std::array< double, OPTION_COUNT > probabilities;
+    std::array< double, OPTION_COUNT > runs;
+    std::array< double, OPTION_COUNT > inventionCosts;
+    std::array< int, OPTION_COUNT > materialEfficiencies;
+    std::array< int, OPTION_COUNT > timeEfficiencies;
+    for ( size_t option = 0; option < OPTION_COUNT; ++option )
+        probabilities[ option ] = std::min( 1.0, node.probability * skillMultiplier * DECRYPTORS.probabilityMultipliers[ option ] );
+    for ( size_t option = 0; option < OPTION_COUNT; ++option )
+        runs[ option ] = static_cast< double >( static_cast< int >( baseRuns ) + DECRYPTORS.runModifiers[ option ] );
+    for ( size_t option = 0; option < OPTION_COUNT; ++option )
+        inventionCosts[ option ] = ( datacoresCost + decryptorPrices[ option ] ) / ( probabilities[ option ] * runs[ option ] );
+    constexpr int baseMaterialEfficiency = static_cast< int >( BASE_MATERIAL_EFFICIENCY );
+    constexpr int maxMaterialEfficiency = static_cast< int >( IndustryCalculator::MAX_MATERIAL_EFFICIENCY );
+    constexpr int baseTimeEfficiency = static_cast< int >( BASE_TIME_EFFICIENCY );
+    for ( size_t option = 0; option < OPTION_COUNT; ++option )
+        materialEfficiencies[ option ] =
+            std::clamp( baseMaterialEfficiency + DECRYPTORS.materialEfficiencyModifiers[ option ], 0, maxMaterialEfficiency );
+    for ( size_t option = 0; option < OPTION_COUNT; ++option )
+        timeEfficiencies[ option ] = std::max( 0, baseTimeEfficiency + DECRYPTORS.timeEfficiencyModifiers[ option ] );
+
+    // The BOM expansion is the expensive part, decryptors sharing a copy size and efficiency share it.
+    std::map< std::pair< unsigned int, unsigned int >, double > materialCosts;
+    for ( size_t option = 0; option < OPTION_COUNT; ++option )
+    {
+        // Without a market price the decryptor cannot be bought, and would look free.
+        if ( option > 0 && decryptorPrices[ option ] <= 0.0 )
+            continue;
+        InventionOption& result = estimate.options.emplace_back();
+        result.decryptorId = DECRYPTORS.typeIds[ option ];
+        result.probability = probabilities[ option ];
+        result.runsPerCopy = static_cast< unsigned int >( runs[ option ] );
+        result.materialEfficiency = static_cast< unsigned int >( materialEfficiencies[ option ] );
+        result.timeEfficiency = static_cast< unsigned int >( timeEfficiencies[ option ] );
+        result.attemptCost = datacoresCost + decryptorPrices[ option ];
+        result.inventionCostPerRun = inventionCosts[ option ];
+
+        const auto [ materialCost, isNew ] = materialCosts.try_emplace( { result.runsPerCopy, result.materialEfficiency }, 0.0 );
+        if ( isNew )
+            materialCost->second = GetMaterialCostPerRun( blueprintId, result.runsPerCopy, result.materialEfficiency );
+        result.materialCostPerRun = materialCost->second;
+    }
+    const auto best = std::min_element( estimate.options.begin(),
+                                        estimate.options.end(),
+                                        []( const InventionOption& left, const InventionOption& right )
+                                        { return left.GetCostPerRun() < right.GetCostPerRun(); } );
+    estimate.bestOption = static_cast< size_t >( best - estimate.options.begin() );
+    return estimate;
+}
+
+std::vector< InventionEstimate > InventionCalculator::EstimateAll( const InventionSkills& skills )
+{
+    PROFILE_FUNCTION();
+    const ActivityGraph& graph = GlobalRessources::GetActivityGraph();
+    std::set< tTypeId > inventedIds;
+    for ( uint32_t activityIndex = 0; activityIndex < graph.GetActivityCount(); ++activityIndex )
+    {
+        if ( graph.GetActivity( activityIndex ).activity != eIndustryActivity::Invention )
+            continue;
+        for ( const ActivityEdge& output : graph.GetOutputs( activityIndex ) )
+            inventedIds.insert( graph.GetTypeId( output.typeIndex ) );
+    }
+    const std::vector< tTypeId > blueprintIds( inventedIds.begin(), inventedIds.end() );
+
+    // Strided so that every worker gets its share of the deep and the shallow chains.
+    std::vector< std::optional< InventionEstimate > > estimates( blueprintIds.size() );
+    const size_t workerCount = std::min< size_t >( std::max( QThread::idealThreadCount(), 1 ), blueprintIds.size() );
+    QThreadPool threadPool;
+    for ( size_t worker = 0; worker < workerCount; ++worker )
+    {
+        threadPool.start(
+            [ &, worker ]()
+            {
+                PROFILE_ZONE( "Estimate inventions" );
+                for ( size_t index = worker; index < blueprintIds.size(); index += workerCount )
+                    estimates[ index ] = Estimate( blueprintIds[ index ], skills );
+            } );
+    }
+    threadPool.waitForDone();
+
+    std::vector< InventionEstimate > results;
+    results.reserve( estimates.size() );
+    for ( std::optional< InventionEstimate >& estimate : estimates )
+    {
+        if ( estimate )
+            results.push_back( std::move( *estimate ) );
+    }
+    LOG_NOTICE( "Estimated the invention of {} blueprints", results.size() );
+    return results;
+}
+
+std::span< const tTypeId > InventionCalculator::GetDecryptorIds()
+{
+    return std::span< const tTypeId >( DECRYPTORS.typeIds ).subspan( 1 );
+}
@@ -0,0 +1,177 @@
+#include "Inventory.h"
+#include "ActivityGraph.h"
+#include "EveType.h"
+#include "GlobalRessources.h"
+#include "LogManager.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QRegularExpression>
+#include <QStringList>
+
+#include <algorithm>
+
+Inventory::Inventory()
+    : graph_( &GlobalRessources::GetActivityGraph() )
+    , quantities_( graph_->GetTypeCount(), 0 )
+{
+}
+
+bool Inventory::LoadFromFile( const QString& filePath, std::string& error )
+{
+    PROFILE_FUNCTION();
+    QFile file( filePath );
+    if ( !file.open( QIODevice::ReadOnly ) )
+    {
+        error = "Could not open " + filePath.toStdString() + ": " + file.errorString().toStdString();
+        return false;
+    }
+    const QByteArray data = file.readAll();
+    if ( QFileInfo( filePath ).suffix().compare( "json", Qt::CaseInsensitive ) == 0 )
+        return ParseEsiAssets( data, error );
+    return ParseText( QString::fromUtf8( data ), error );
+}
+
+bool Inventory::ParseEsiAssets( const QByteArray& data, std::string& error )
+{
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson( data, &parseError );
+    if ( parseError.error != QJsonParseError::NoError || !document.isArray() )
+    {
+        error = "Expected an array of assets: " + parseError.errorString().toStdString();
+        return false;
+    }
+    for ( const QJsonValue& assetValue : document.array() )
+    {
+        const QJsonObject asset = assetValue.toObject();
+        const qint64 typeId = asset.value( "type_id" ).toInteger();
+        const qint64 quantity = asset.value( "quantity" ).toInteger();
+        if ( typeId <= 0 || quantity <= 0 )
+        {
+            error = "Asset without a valid type_id and quantity";
+            return false;
+        }
+        Add( static_cast< tTypeId >( typeId ), static_cast< unsigned long long >( quantity ) );
+    }
+    return true;
+}
+
+bool Inventory::ParseText( const QString& text, std::string& error )
+{
+    // Names are matched case insensitively, only types kept by the loader can be named.
+    std::unordered_map< std::string, tTypeId > typeIdsByName;
+    for ( const auto& [ typeId, type ] : GlobalRessources::GetTypesMap() )
+        typeIdsByName.emplace( QString::fromStdString( type->GetName() ).toLower().toStdString(), typeId );
+
+    unsigned int skippedLines = 0;
+    const QStringList lines = text.split( '\n' );
+    for ( int lineIndex = 0; lineIndex < lines.size(); ++lineIndex )
+    {
+        const QString line = lines[ lineIndex ].trimmed();
+        if ( line.isEmpty() || line.startsWith( '#' ) )
+            continue;
+
+        // Pasted asset lists are tab separated, the item first and its quantity second. Otherwise only the first comma
+        // separates, so that the quantity may keep its thousands separators.
+        QString item;
+        QString quantityText;
+        if ( line.contains( '\t' ) )
+        {
+            const QStringList fields = line.split( '\t' );
+            item = fields[ 0 ].trimmed();
+            quantityText = fields.size() > 1 ? fields[ 1 ] : QString();
+        }
+        else
+        {
+            const qsizetype separator = line.indexOf( ',' );
+            item = line.left( separator ).trimmed();
+            quantityText = separator >= 0 ? line.mid( separator + 1 ) : QString();
+        }
+        static const QRegularExpression THOUSANDS_SEPARATORS( "[\\s,.'\\x{00A0}]" );
+        quantityText.remove( THOUSANDS_SEPARATORS );
+
+        bool isValid = true;
+        const unsigned long long quantity = quantityText.isEmpty() ? 1 : quantityText.toULongLong( &isValid );
+        bool isNumber = false;
+        tTypeId typeId = item.toUInt( &isNumber );
+        if ( !isNumber )
+        {
+            const auto namedType = typeIdsByName.find( item.toLower().toStdString() );
+            typeId = namedType != typeIdsByName.end() ? namedType->second : 0;
+        }
+        if ( !isValid || typeId == 0 )
+        {
+            // Header lines, and items no blueprint or ore uses.
+            LOG_NOTICE( "Skipped inventory line {}: {}", lineIndex + 1, line.toStdString() );
+            ++skippedLines;
+            continue;
+        }
+        Add( typeId, quantity );
+    }
+    if ( skippedLines > 0 )
+        LOG_NOTICE( "Skipped {} inventory lines", skippedLines );
+    if ( IsEmpty() && skippedLines > 0 )
+    {
+        error = "No known item in the inventory";
+        return false;
+    }
+    return true;
+}
+
+void Inventory::Add( tTypeId typeId, unsigned long long quantity )
+{
+    if ( unsigned long long* owned = FindQuantity( typeId ) )
+        *owned += quantity;
+    else
+        otherQuantities_[ typeId ] += quantity;
+}
+
+unsigned long long Inventory::GetQuantity( tTypeId typeId ) const
+{
+    if ( const std::optional< uint32_t > typeIndex = graph_->FindType( typeId ) )
+        return quantities_[ *typeIndex ];
+    const auto owned = otherQuantities_.find( typeId );
+    return owned != otherQuantities_.end() ? owned->second : 0;
+}
+
+unsigned long long Inventory::Take( tTypeId typeId, unsigned long long quantity )
+{
+    unsigned long long* owned = FindQuantity( typeId );
+    if ( owned == nullptr )
+    {
+        const auto other = otherQuantities_.find( typeId );
+        owned = other != otherQuantities_.end() ? &other->second : nullptr;
+    }
+    const unsigned long long taken = owned != nullptr ? std::min( *owned, quantity ) : 0;
+    if ( taken == 0 )
+        return 0;
+    *owned -= taken;
+    takenQuantities_[ typeId ] += taken;
+    return taken;
+}
+
+bool Inventory::IsEmpty() const
+{
+    return std::all_of( quantities_.begin(), quantities_.end(), []( unsigned long long quantity ) { return quantity == 0; } )
+           && std::all_of( otherQuantities_.begin(), otherQuantities_.end(), []( const auto& other ) { return other.second == 0; } );
+}
+
+const std::map< tTypeId, unsigned long long >& Inventory::GetTakenQuantities() const
+{
+    return takenQuantities_;
+}
+
+void Inventory::ClearTakenQuantities()
+{
+    takenQuantities_.clear();
+}
+
+unsigned long long* Inventory::FindQuantity( tTypeId typeId )
+{
+    const std::optional< uint32_t > typeIndex = graph_->FindType( typeId );
+    return typeIndex ? &quantities_[ *typeIndex ] : nullptr;
+}
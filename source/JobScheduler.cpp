@@ -0,0 +1,512 @@
+#include "JobScheduler.h"
+#include "ActivityGraph.h"
+#include "BuildOrBuyOptimizer.h"
+#include "GlobalRessources.h"
+#include "IndustryCalculator.h"
+#include "Inventory.h"
+#include "LogManager.h"
+
+#include <highs/Highs.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <unordered_map>
+
+static constexpr size_t SLOT_KIND_COUNT = 2; // Manufacturing and reaction slots.
+
+static size_t GetSlotKind( eIndustryActivity activity )
+{
+    return activity == eIndustryActivity::Reaction ? 1 : 0;
+}
+
+static unsigned int GetSlotCount( const SchedulerCharacter& character, size_t slotKind )
+{
+    return slotKind == 0 ? character.manufacturingSlots : character.reactionSlots;
+}
+
+// The manufacturing activity of blueprintId, or its reaction one for a formula.
+static std::optional< uint32_t > FindBlueprintActivity( const ActivityGraph& graph, tTypeId blueprintId )
+{
+    const std::optional< uint32_t > blueprintIndex = graph.FindType( blueprintId );
+    if ( !blueprintIndex )
+        return std::nullopt;
+    std::optional< uint32_t > reaction;
+    for ( const uint32_t activityIndex : graph.GetConsumers( *blueprintIndex ) )
+    {
+        const ActivityNode& node = graph.GetActivity( activityIndex );
+        if ( node.blueprintId != blueprintId )
+            continue;
+        if ( node.activity == eIndustryActivity::Manufacturing )
+            return activityIndex;
+        if ( node.activity == eIndustryActivity::Reaction && !reaction )
+            reaction = activityIndex;
+    }
+    return reaction;
+}
+
+std::vector< PlannedJob > JobScheduler::BuildPlan( const ProductionRequest& request )
+{
+    PROFILE_FUNCTION();
+    const ActivityGraph& graph = GlobalRessources::GetActivityGraph();
+    const std::optional< uint32_t > rootActivity = FindBlueprintActivity( graph, request.blueprintId );
+    if ( !rootActivity )
+    {
+        LOG_WARNING( "Blueprint {} has no manufacturing job to plan.", request.blueprintId );
+        return {};
+    }
+    std::optional< BuildOrBuyOptimizer > buildOrBuy;
+    if ( request.buildOrBuy )
+        buildOrBuy.emplace( *request.buildOrBuy, request.materialEfficiency );
+    std::optional< Inventory > stock;
+    if ( request.stock != nullptr )
+        stock.emplace( *request.stock );
+
+    // The activity building a material input, nullopt when it is bought.
+    auto findComponentActivity = [ & ]( const ActivityEdge& input ) -> std::optional< uint32_t >
+    {
+        if ( input.kind != eActivityEdge::Material )
+            return std::nullopt;
+        const tTypeId typeId = graph.GetTypeId( input.typeIndex );
+        if ( buildOrBuy && !buildOrBuy->IsBuilt( typeId ) )
+            return std::nullopt;
+        return graph.FindProductionActivity( typeId );
+    };
+
+    // Post-order over the activities of the chain, each reached once however many times it is used.
+    struct Frame
+    {
+        uint32_t activityIndex = 0;
+        size_t nextInput = 0;
+    };
+    std::unordered_map< uint32_t, size_t > orderIndexes; // Activity to its position in order, set once it is finished.
+    std::unordered_map< uint32_t, uint32_t > productIndexes; // Activity to the type it is planned for.
+    std::vector< uint32_t > order;
+    std::vector< Frame > stack = { { *rootActivity, 0 } };
+    productIndexes[ *rootActivity ] = 0;
+    while ( !stack.empty() )
+    {
+        Frame& frame = stack.back();
+        const std::span< const ActivityEdge > inputs = graph.GetInputs( frame.activityIndex );
+        std::optional< uint32_t > unvisitedActivity;
+        while ( frame.nextInput < inputs.size() && !unvisitedActivity )
+        {
+            const ActivityEdge& input = inputs[ frame.nextInput++ ];
+            const std::optional< uint32_t > componentActivity = findComponentActivity( input );
+            if ( componentActivity && productIndexes.try_emplace( *componentActivity, input.typeIndex ).second )
+                unvisitedActivity = componentActivity;
+        }
+        if ( unvisitedActivity )
+        {
+            stack.push_back( { *unvisitedActivity, 0 } );
+            continue;
+        }
+        orderIndexes[ frame.activityIndex ] = order.size();
+        order.push_back( frame.activityIndex );
+        stack.pop_back();
+    }
+
+    // Quantities flow from the product down, components are rounded to whole runs once all their consumers are known.
+    // An input planned later than its consumer is a cycle back up the chain and is left out.
+    std::vector< unsigned long long > neededUnits( order.size(), 0 );
+    std::vector< unsigned long long > runs( order.size(), 0 );
+    runs.back() = request.runs;
+    for ( size_t position = order.size(); position-- > 0; )
+    {
+        const uint32_t activityIndex = order[ position ];
+        const ActivityNode& node = graph.GetActivity( activityIndex );
+        if ( position + 1 < order.size() )
+        {
+            const uint32_t productIndex = productIndexes.at( activityIndex );
+            unsigned long long needed = neededUnits[ position ];
+            if ( stock )
+                needed -= stock->Take( graph.GetTypeId( productIndex ), needed );
+            const unsigned long long producedPerRun = std::max( graph.GetProducedQuantity( activityIndex, productIndex ), 1u );
+            runs[ position ] = ( needed + producedPerRun - 1 ) / producedPerRun;
+        }
+        // Reaction formulas cannot be researched.
+        const unsigned int efficiency = node.activity == eIndustryActivity::Manufacturing ? request.materialEfficiency : 0;
+        for ( const ActivityEdge& input : graph.GetInputs( activityIndex ) )
+        {
+            const std::optional< uint32_t > componentActivity = findComponentActivity( input );
+            if ( !componentActivity )
+                continue;
+            const size_t componentPosition = orderIndexes.at( *componentActivity );
+            if ( componentPosition < position )
+            {
+                neededUnits[ componentPosition ] +=
+                    IndustryCalculator::ApplyMaterialEfficiency( input.quantity, runs[ position ], efficiency );
+            }
+        }
+    }
+
+    // Components fully covered by the stock get no job.
+    std::vector< PlannedJob > plan;
+    std::vector< std::optional< size_t > > jobIndexes( order.size() );
+    plan.reserve( order.size() );
+    for ( size_t position = 0; position < order.size(); ++position )
+    {
+        if ( runs[ position ] == 0 )
+            continue;
+        const ActivityNode& node = graph.GetActivity( order[ position ] );
+        jobIndexes[ position ] = plan.size();
+        PlannedJob& job = plan.emplace_back();
+        job.blueprintId = node.blueprintId;
+        job.activity = node.activity;
+        job.runs = runs[ position ];
+        job.timePerRunSeconds = node.timeInSeconds;
+        for ( const ActivityEdge& input : graph.GetInputs( order[ position ] ) )
+        {
+            const std::optional< uint32_t > componentActivity = findComponentActivity( input );
+            if ( !componentActivity )
+                continue;
+            const size_t componentPosition = orderIndexes.at( *componentActivity );
+            if ( componentPosition >= position || !jobIndexes[ componentPosition ] )
+                continue;
+            const size_t dependency = *jobIndexes[ componentPosition ];
+            if ( std::find( job.dependencies.begin(), job.dependencies.end(), dependency ) == job.dependencies.end() )
+                job.dependencies.push_back( dependency );
+        }
+    }
+    return plan;
+}
+
+double JobScheduler::GetDuration( const PlannedJob& job, const SchedulerCharacter& character )
+{
+    const double duration = static_cast< double >( job.timePerRunSeconds ) * static_cast< double >( job.runs );
+    if ( job.activity != eIndustryActivity::Manufacturing )
+        return duration;
+    const unsigned int timeEfficiency = std::min( character.timeEfficiency, IndustryCalculator::MAX_TIME_EFFICIENCY );
+    return duration * ( 1.0 - static_cast< double >( timeEfficiency ) / 100.0 );
+}
+
+std::optional< ProductionSchedule > JobScheduler::Schedule( std::vector< PlannedJob > plan, const SchedulerSettings& settings )
+{
+    PROFILE_FUNCTION();
+    ProductionSchedule schedule;
+    schedule.plan = std::move( plan );
+    const size_t jobCount = schedule.plan.size();
+    schedule.jobs.resize( jobCount );
+
+    std::vector< std::vector< size_t > > consumers( jobCount );
+    std::vector< size_t > remainingDependencies( jobCount );
+    for ( size_t job = 0; job < jobCount; ++job )
+    {
+        remainingDependencies[ job ] = schedule.plan[ job ].dependencies.size();
+        for ( const size_t dependency : schedule.plan[ job ].dependencies )
+            consumers[ dependency ].push_back( job );
+    }
+
+    // Priority of a job: the longest chain from its start to the end of the plan, at the pace of the fastest character.
+    // Consumers come later in the plan, so one backward pass is enough.
+    std::vector< double > ranks( jobCount, 0.0 );
+    for ( size_t job = jobCount; job-- > 0; )
+    {
+        const size_t slotKind = GetSlotKind( schedule.plan[ job ].activity );
+        double fastestDuration = std::numeric_limits< double >::infinity();
+        for ( const SchedulerCharacter& character : settings.characters )
+        {
+            if ( GetSlotCount( character, slotKind ) > 0 )
+                fastestDuration = std::min( fastestDuration, GetDuration( schedule.plan[ job ], character ) );
+        }
+        if ( std::isinf( fastestDuration ) )
+        {
+            LOG_WARNING( "No character has a slot for the job of blueprint {}.", schedule.plan[ job ].blueprintId );
+            return std::nullopt;
+        }
+        double longestConsumer = 0.0;
+        for ( const size_t consumer : consumers[ job ] )
+            longestConsumer = std::max( longestConsumer, ranks[ consumer ] );
+        ranks[ job ] = fastestDuration + longestConsumer;
+    }
+
+    // When each slot of each character is next free, per slot kind.
+    std::vector< std::array< std::vector< double >, SLOT_KIND_COUNT > > slotFreeTimes( settings.characters.size() );
+    for ( size_t character = 0; character < settings.characters.size(); ++character )
+    {
+        for ( size_t slotKind = 0; slotKind < SLOT_KIND_COUNT; ++slotKind )
+            slotFreeTimes[ character ][ slotKind ].assign( GetSlotCount( settings.characters[ character ], slotKind ), 0.0 );
+    }
+
+    std::priority_queue< std::pair< double, size_t > > readyJobs;
+    for ( size_t job = 0; job < jobCount; ++job )
+    {
+        if ( remainingDependencies[ job ] == 0 )
+            readyJobs.emplace( ranks[ job ], job );
+    }
+    while ( !readyJobs.empty() )
+    {
+        const size_t job = readyJobs.top().second;
+        readyJobs.pop();
+        const PlannedJob& plannedJob = schedule.plan[ job ];
+        const size_t slotKind = GetSlotKind( plannedJob.activity );
+        double releaseTime = 0.0;
+        for ( const size_t dependency : plannedJob.dependencies )
+            releaseTime = std::max( releaseTime, schedule.jobs[ dependency ].endSeconds );
+
+        // The slot finishing the job first, characters differ by their time efficiency.
+        ScheduledJob& scheduled = schedule.jobs[ job ];
+        scheduled.endSeconds = std::numeric_limits< double >::infinity();
+        for ( size_t character = 0; character < settings.characters.size(); ++character )
+        {
+            std::vector< double >& freeTimes = slotFreeTimes[ character ][ slotKind ];
+            if ( freeTimes.empty() )
+                continue;
+            const auto slot = std::min_element( freeTimes.begin(), freeTimes.end() );
+            const double startSeconds = std::max( *slot, releaseTime );
+            const double endSeconds = startSeconds + GetDuration( plannedJob, settings.characters[ character ] );
+            if ( endSeconds < scheduled.endSeconds )
+                scheduled = { character, static_cast< size_t >( slot - freeTimes.begin() ), startSeconds, endSeconds };
+        }
+        slotFreeTimes[ scheduled.character ][ slotKind ][ scheduled.slot ] = scheduled.endSeconds;
+        schedule.makespanSeconds = std::max( schedule.makespanSeconds, scheduled.endSeconds );
+
+        for ( const size_t consumer : consumers[ job ] )
+        {
+            if ( --remainingDependencies[ consumer ] == 0 )
+                readyJobs.emplace( ranks[ consumer ], consumer );
+        }
+    }
+    LOG_NOTICE(
+        "Scheduled {} jobs on {} characters, makespan of {:.0f} s", jobCount, settings.characters.size(), schedule.makespanSeconds );
+
+    if ( settings.isRefiningWithMip && jobCount > 1 && jobCount <= settings.maxMipJobs )
+        RefineWithMip( schedule, settings );
+    return schedule;
+}
+
+bool JobScheduler::RefineWithMip( ProductionSchedule& schedule, const SchedulerSettings& settings )
+{
+    PROFILE_FUNCTION();
+    struct Machine
+    {
+        size_t character = 0;
+        size_t slot = 0;
+    };
+
+    // Identical slots only add symmetry: a character never needs more of them than there are jobs of their kind.
+    const size_t jobCount = schedule.plan.size();
+    std::array< size_t, SLOT_KIND_COUNT > jobCounts = {};
+    for ( const PlannedJob& job : schedule.plan )
+        ++jobCounts[ GetSlotKind( job.activity ) ];
+    std::array< std::vector< Machine >, SLOT_KIND_COUNT > machines;
+    for ( size_t slotKind = 0; slotKind < SLOT_KIND_COUNT; ++slotKind )
+    {
+        for ( size_t character = 0; character < settings.characters.size(); ++character )
+        {
+            const unsigned int characterSlots = GetSlotCount( settings.characters[ character ], slotKind );
+            const size_t slotCount = std::min< size_t >( characterSlots, jobCounts[ slotKind ] );
+            for ( size_t slot = 0; slot < slotCount; ++slot )
+                machines[ slotKind ].push_back( { character, slot } );
+        }
+    }
+
+    // Columns: the start of every job, the makespan, then per job one assignment per machine of its kind, then per pair of
+    // jobs of the same kind whether the first one runs before the second.
+    const double horizon = schedule.makespanSeconds;
+    std::vector< double > lowerBounds( jobCount + 1, 0.0 );
+    std::vector< double > upperBounds( jobCount + 1, horizon );
+    std::vector< double > objectiveCoefficients( jobCount + 1, 0.0 );
+    std::vector< HighsVarType > variableTypes( jobCount + 1, HighsVarType::kContinuous );
+    const int makespanColumn = static_cast< int >( jobCount );
+    objectiveCoefficients[ makespanColumn ] = 1.0;
+    auto addBinary = [ & ]()
+    {
+        lowerBounds.push_back( 0.0 );
+        upperBounds.push_back( 1.0 );
+        objectiveCoefficients.push_back( 0.0 );
+        variableTypes.push_back( HighsVarType::kInteger );
+        return static_cast< int >( lowerBounds.size() - 1 );
+    };
+
+    std::vector< int > assignmentColumns( jobCount ); // First assignment column of each job.
+    std::vector< std::vector< double > > durations( jobCount ); // Per machine of the kind of the job.
+    double longestDuration = 0.0;
+    for ( size_t job = 0; job < jobCount; ++job )
+    {
+        const std::vector< Machine >& jobMachines = machines[ GetSlotKind( schedule.plan[ job ].activity ) ];
+        assignmentColumns[ job ] = static_cast< int >( lowerBounds.size() );
+        for ( const Machine& machine : jobMachines )
+        {
+            addBinary();
+            durations[ job ].push_back( GetDuration( schedule.plan[ job ], settings.characters[ machine.character ] ) );
+            longestDuration = std::max( longestDuration, durations[ job ].back() );
+        }
+    }
+    std::vector< std::pair< size_t, size_t > > pairs;
+    std::vector< int > orderColumns;
+    for ( size_t first = 0; first < jobCount; ++first )
+    {
+        for ( size_t second = first + 1; second < jobCount; ++second )
+        {
+            if ( GetSlotKind( schedule.plan[ first ].activity ) != GetSlotKind( schedule.plan[ second ].activity ) )
+                continue;
+            pairs.emplace_back( first, second );
+            orderColumns.push_back( addBinary() );
+        }
+    }
+
+    std::vector< int > rowStarts;
+    std::vector< int > columnIndices;
+    std::vector< double > values;
+    std::vector< double > rowLowerBounds;
+    std::vector< double > rowUpperBounds;
+    auto addEntry = [ & ]( int column, double value )
+    {
+        columnIndices.push_back( column );
+        values.push_back( value );
+    };
+    auto beginRow = [ & ]( double lower, double upper )
+    {
+        rowStarts.push_back( static_cast< int >( columnIndices.size() ) );
+        rowLowerBounds.push_back( lower );
+        rowUpperBounds.push_back( upper );
+    };
+    // Adds the duration of job, given by its assignment, with the sign of factor.
+    auto addDuration = [ & ]( size_t job, double factor )
+    {
+        for ( size_t machine = 0; machine < durations[ job ].size(); ++machine )
+            addEntry( assignmentColumns[ job ] + static_cast< int >( machine ), factor * durations[ job ][ machine ] );
+    };
+
+    for ( size_t job = 0; job < jobCount; ++job )
+    {
+        beginRow( 1.0, 1.0 );
+        for ( size_t machine = 0; machine < durations[ job ].size(); ++machine )
+            addEntry( assignmentColumns[ job ] + static_cast< int >( machine ), 1.0 );
+
+        beginRow( 0.0, kHighsInf );
+        addEntry( makespanColumn, 1.0 );
+        addEntry( static_cast< int >( job ), -1.0 );
+        addDuration( job, -1.0 );
+
+        for ( const size_t dependency : schedule.plan[ job ].dependencies )
+        {
+            beginRow( 0.0, kHighsInf );
+            addEntry( static_cast< int >( job ), 1.0 );
+            addEntry( static_cast< int >( dependency ), -1.0 );
+            addDuration( dependency, -1.0 );
+        }
+    }
+    // Two jobs on the same machine do not overlap, bigM relaxes the rows of every other combination.
+    const double bigM = horizon + longestDuration;
+    for ( size_t pair = 0; pair < pairs.size(); ++pair )
+    {
+        const auto [ first, second ] = pairs[ pair ];
+        for ( size_t machine = 0; machine < durations[ first ].size(); ++machine )
+        {
+            const int firstAssignment = assignmentColumns[ first ] + static_cast< int >( machine );
+            const int secondAssignment = assignmentColumns[ second ] + static_cast< int >( machine );
+            // first before second: start(second) >= start(first) + duration(first).
+            beginRow( durations[ first ][ machine ] - 3.0 * bigM, kHighsInf );
+            addEntry( static_cast< int >( second ), 1.0 );
+            addEntry( static_cast< int >( first ), -1.0 );
+            addEntry( orderColumns[ pair ], -bigM );
+            addEntry( firstAssignment, -bigM );
+            addEntry( secondAssignment, -bigM );
+            // second before first.
+            beginRow( durations[ second ][ machine ] - 2.0 * bigM, kHighsInf );
+            addEntry( static_cast< int >( first ), 1.0 );
+            addEntry( static_cast< int >( second ), -1.0 );
+            addEntry( orderColumns[ pair ], bigM );
+            addEntry( firstAssignment, -bigM );
+            addEntry( secondAssignment, -bigM );
+        }
+    }
+    rowStarts.push_back( static_cast< int >( columnIndices.size() ) );
+
+    HighsLp lp;
+    lp.num_col_ = static_cast< int >( lowerBounds.size() );
+    lp.num_row_ = static_cast< int >( rowLowerBounds.size() );
+    lp.col_cost_ = objectiveCoefficients;
+    lp.col_lower_ = lowerBounds;
+    lp.col_upper_ = upperBounds;
+    lp.row_lower_ = rowLowerBounds;
+    lp.row_upper_ = rowUpperBounds;
+    lp.a_matrix_.format_ = MatrixFormat::kRowwise;
+    lp.a_matrix_.start_ = rowStarts;
+    lp.a_matrix_.index_ = columnIndices;
+    lp.a_matrix_.value_ = values;
+
+    Highs highs;
+    highs.setOptionValue( "output_flag", false );
+    highs.setOptionValue( "time_limit", settings.mipTimeLimitSeconds );
+    highs.passModel( lp );
+    for ( int i = 0; i < static_cast< int >( variableTypes.size() ); i++ )
+        highs.changeColIntegrality( i, variableTypes[ i ] );
+
+    // Warm start from the list schedule, so that the time limit can only improve on it.
+    HighsSolution warmStart;
+    warmStart.col_value.assign( lowerBounds.size(), 0.0 );
+    for ( size_t job = 0; job < jobCount; ++job )
+    {
+        const ScheduledJob& scheduled = schedule.jobs[ job ];
+        warmStart.col_value[ job ] = scheduled.startSeconds;
+        const std::vector< Machine >& jobMachines = machines[ GetSlotKind( schedule.plan[ job ].activity ) ];
+        for ( size_t machine = 0; machine < jobMachines.size(); ++machine )
+        {
+            if ( jobMachines[ machine ].character == scheduled.character && jobMachines[ machine ].slot == scheduled.slot )
+                warmStart.col_value[ assignmentColumns[ job ] + machine ] = 1.0;
+        }
+    }
+    warmStart.col_value[ makespanColumn ] = horizon;
+    for ( size_t pair = 0; pair < pairs.size(); ++pair )
+    {
+        const auto [ first, second ] = pairs[ pair ];
+        const bool isFirstBefore = schedule.jobs[ first ].startSeconds <= schedule.jobs[ second ].startSeconds;
+        warmStart.col_value[ orderColumns[ pair ] ] = isFirstBefore ? 1.0 : 0.0;
+    }
+    highs.setSolution( warmStart );
+
+    HighsStatus status = HighsStatus::kError;
+    {
+        PROFILE_ZONE( "Highs::run" );
+        status = highs.run();
+    }
+    if ( status == HighsStatus::kError || highs.getInfo().primal_solution_status != kSolutionStatusFeasible )
+    {
+        LOG_WARNING( "Failed to refine the schedule of {} jobs", jobCount );
+        return false;
+    }
+
+    // Rebuilt from the assignment and the order of the solution, the starts of the solver are only up to its tolerances.
+    const HighsSolution& solution = highs.getSolution();
+    std::vector< size_t > jobsByStart( jobCount );
+    std::iota( jobsByStart.begin(), jobsByStart.end(), 0 );
+    std::stable_sort( jobsByStart.begin(),
+                      jobsByStart.end(),
+                      [ & ]( size_t left, size_t right ) { return solution.col_value[ left ] < solution.col_value[ right ]; } );
+    std::array< std::vector< double >, SLOT_KIND_COUNT > machineFreeTimes;
+    for ( size_t slotKind = 0; slotKind < SLOT_KIND_COUNT; ++slotKind )
+        machineFreeTimes[ slotKind ].assign( machines[ slotKind ].size(), 0.0 );
+    std::vector< ScheduledJob > refinedJobs( jobCount );
+    double makespanSeconds = 0.0;
+    for ( const size_t job : jobsByStart )
+    {
+        const size_t slotKind = GetSlotKind( schedule.plan[ job ].activity );
+        size_t machine = 0;
+        for ( size_t candidate = 1; candidate < durations[ job ].size(); ++candidate )
+        {
+            if ( solution.col_value[ assignmentColumns[ job ] + candidate ] > solution.col_value[ assignmentColumns[ job ] + machine ] )
+                machine = candidate;
+        }
+        double startSeconds = machineFreeTimes[ slotKind ][ machine ];
+        for ( const size_t dependency : schedule.plan[ job ].dependencies )
+            startSeconds = std::max( startSeconds, refinedJobs[ dependency ].endSeconds );
+        const Machine& assigned = machines[ slotKind ][ machine ];
+        refinedJobs[ job ] = { assigned.character, assigned.slot, startSeconds, startSeconds + durations[ job ][ machine ] };
+        machineFreeTimes[ slotKind ][ machine ] = refinedJobs[ job ].endSeconds;
+        makespanSeconds = std::max( makespanSeconds, refinedJobs[ job ].endSeconds );
+    }
+    if ( makespanSeconds >= schedule.makespanSeconds )
+        return false;
+
+    LOG_NOTICE( "Refined the makespan of {} jobs from {:.0f} s to {:.0f} s", jobCount, schedule.makespanSeconds, makespanSeconds );
+    schedule.jobs = std::move( refinedJobs );
+    schedule.makespanSeconds = makespanSeconds;
+    schedule.isMipRefined = true;
+    return true;
+}
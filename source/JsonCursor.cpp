@@ -0,0 +1,364 @@
+#include "JsonCursor.h"
+
+#include <charconv>
+
+static bool IsNumberCharacter( char character )
+{
+    return ( character >= '0' && character <= '9' ) || character == '-' || character == '+' || character == '.' || character == 'e' ||
+           character == 'E';
+}
+
+static void AppendUtf8( std::string& buffer, uint32_t codePoint )
+{
+    if ( codePoint < 0x80 )
+        buffer.push_back( static_cast< char >( codePoint ) );
+    else if ( codePoint < 0x800 )
+    {
+        buffer.push_back( static_cast< char >( 0xC0 | ( codePoint >> 6 ) ) );
+        buffer.push_back( static_cast< char >( 0x80 | ( codePoint & 0x3F ) ) );
+    }
+    else if ( codePoint < 0x10000 )
+    {
+        buffer.push_back( static_cast< char >( 0xE0 | ( codePoint >> 12 ) ) );
+        buffer.push_back( static_cast< char >( 0x80 | ( ( codePoint >> 6 ) & 0x3F ) ) );
+        buffer.push_back( static_cast< char >( 0x80 | ( codePoint & 0x3F ) ) );
+    }
+    else
+    {
+        buffer.push_back( static_cast< char >( 0xF0 | ( codePoint >> 18 ) ) );
+        buffer.push_back( static_cast< char >( 0x80 | ( ( codePoint >> 12 ) & 0x3F ) ) );
+        buffer.push_back( static_cast< char >( 0x80 | ( ( codePoint >> 6 ) & 0x3F ) ) );
+        buffer.push_back( static_cast< char >( 0x80 | ( codePoint & 0x3F ) ) );
+    }
+}
+
+JsonCursor::JsonCursor( std::string_view text )
+    : begin_( text.data() )
+    , current_( text.data() )
+    , end_( text.data() + text.size() )
+{
+}
+
+char JsonCursor::Peek()
+{
+    SkipWhitespace();
+    return current_ < end_ ? *current_ : '\0';
+}
+
+bool JsonCursor::IsNumber()
+{
+    const char next = Peek();
+    return next == '-' || ( next >= '0' && next <= '9' );
+}
+
+bool JsonCursor::IsString()
+{
+    return Peek() == '"';
+}
+
+bool JsonCursor::IsNull()
+{
+    return Peek() == 'n';
+}
+
+bool JsonCursor::Read( bool& value )
+{
+    const char next = Peek();
+    if ( next == 't' )
+    {
+        value = true;
+        return SkipLiteral( "true" );
+    }
+    if ( next == 'f' )
+    {
+        value = false;
+        return SkipLiteral( "false" );
+    }
+    return SkipValue();
+}
+
+bool JsonCursor::Read( double& value )
+{
+    if ( !IsNumber() )
+        return SkipValue();
+    std::string_view token;
+    if ( !ReadNumberToken( token ) )
+        return false;
+    const auto [ end, errorCode ] = std::from_chars( token.data(), token.data() + token.size(), value );
+    if ( errorCode != std::errc() || end != token.data() + token.size() )
+        return Fail( "Invalid number" );
+    return true;
+}
+
+bool JsonCursor::Read( std::string& value )
+{
+    if ( !IsString() )
+        return SkipValue();
+    std::string_view text;
+    if ( !ReadStringView( text, value ) )
+        return false;
+    if ( text.data() != value.data() )
+        value.assign( text );
+    return true;
+}
+
+bool JsonCursor::Read( std::string_view& value )
+{
+    if ( !IsString() )
+        return SkipValue();
+    return ReadStringView( value, stringBuffer_ );
+}
+
+bool JsonCursor::SkipValue()
+{
+    switch ( Peek() )
+    {
+        case '"':
+            return SkipString();
+        case '{':
+        case '[':
+            return SkipContainer();
+        case 't':
+            return SkipLiteral( "true" );
+        case 'f':
+            return SkipLiteral( "false" );
+        case 'n':
+            return SkipLiteral( "null" );
+        case '\0':
+            return Fail( "Unexpected end of input" );
+        default:
+            break;
+    }
+    if ( !IsNumber() )
+        return Fail( "Unexpected character" );
+    std::string_view token;
+    return ReadNumberToken( token );
+}
+
+bool JsonCursor::ReadFirstKey( std::string_view& key )
+{
+    if ( Peek() != '{' )
+        return false;
+    ++current_;
+    if ( Peek() == '}' )
+        return false;
+    return ReadStringView( key, keyBuffer_ ) && Consume( ':' );
+}
+
+bool JsonCursor::ExpectEnd()
+{
+    if ( error_ )
+        return false;
+    return Peek() == '\0' ? true : Fail( "Unexpected data after the value" );
+}
+
+std::string JsonCursor::GetError() const
+{
+    if ( !error_ )
+        return {};
+    return std::string( error_ ) + " at offset " + std::to_string( errorOffset_ );
+}
+
+void JsonCursor::SkipWhitespace()
+{
+    while ( current_ < end_ && ( *current_ == ' ' || *current_ == '\n' || *current_ == '\r' || *current_ == '\t' ) )
+        ++current_;
+}
+
+bool JsonCursor::Consume( char expected )
+{
+    if ( Peek() != expected )
+        return Fail( expected == ':' ? "Expected ':'" : "Unexpected character" );
+    ++current_;
+    return true;
+}
+
+bool JsonCursor::Fail( const char* reason )
+{
+    if ( !error_ )
+    {
+        error_ = reason;
+        errorOffset_ = static_cast< size_t >( current_ - begin_ );
+    }
+    return false;
+}
+
+bool JsonCursor::ReadInteger( int64_t& value )
+{
+    std::string_view token;
+    if ( !ReadNumberToken( token ) )
+        return false;
+    const char* tokenEnd = token.data() + token.size();
+    const std::from_chars_result integerResult = std::from_chars( token.data(), tokenEnd, value );
+    if ( integerResult.ec == std::errc() && integerResult.ptr == tokenEnd )
+        return true;
+
+    // Fraction or exponent, truncated like QJsonValue::toInt() does.
+    double floating = 0.0;
+    const std::from_chars_result floatingResult = std::from_chars( token.data(), tokenEnd, floating );
+    if ( floatingResult.ec != std::errc() || floatingResult.ptr != tokenEnd )
+        return Fail( "Invalid number" );
+    value = static_cast< int64_t >( floating );
+    return true;
+}
+
+bool JsonCursor::ReadStringView( std::string_view& text, std::string& buffer )
+{
+    if ( Peek() != '"' )
+        return Fail( "Expected a string" );
+    const char* start = ++current_;
+    while ( current_ < end_ && *current_ != '"' && *current_ != '\\' )
+        ++current_;
+    if ( current_ >= end_ )
+        return Fail( "Unterminated string" );
+    if ( *current_ == '"' )
+    {
+        text = std::string_view( start, static_cast< size_t >( current_ - start ) );
+        ++current_;
+        return true;
+    }
+
+    // Escape sequences, the string is rebuilt in buffer from here on.
+    buffer.assign( start, current_ );
+    while ( current_ < end_ )
+    {
+        const char character = *current_++;
+        if ( character == '"' )
+        {
+            text = buffer;
+            return true;
+        }
+        if ( character != '\\' )
+        {
+            buffer.push_back( character );
+            continue;
+        }
+        if ( current_ >= end_ )
+            break;
+        switch ( *current_++ )
+        {
+            case '"':
+                buffer.push_back( '"' );
+                break;
+            case '\\':
+                buffer.push_back( '\\' );
+                break;
+            case '/':
+                buffer.push_back( '/' );
+                break;
+            case 'b':
+                buffer.push_back( '\b' );
+                break;
+            case 'f':
+                buffer.push_back( '\f' );
+                break;
+            case 'n':
+                buffer.push_back( '\n' );
+                break;
+            case 'r':
+                buffer.push_back( '\r' );
+                break;
+            case 't':
+                buffer.push_back( '\t' );
+                break;
+            case 'u':
+                if ( !ReadUnicodeEscape( buffer ) )
+                    return false;
+                break;
+            default:
+                return Fail( "Invalid escape sequence" );
+        }
+    }
+    return Fail( "Unterminated string" );
+}
+
+bool JsonCursor::ReadUnicodeEscape( std::string& buffer )
+{
+    auto readHex = [ this ]( uint32_t& codeUnit )
+    {
+        if ( end_ - current_ < 4 )
+            return false;
+        const auto [ end, errorCode ] = std::from_chars( current_, current_ + 4, codeUnit, 16 );
+        if ( errorCode != std::errc() || end != current_ + 4 )
+            return false;
+        current_ += 4;
+        return true;
+    };
+
+    uint32_t codePoint = 0;
+    if ( !readHex( codePoint ) )
+        return Fail( "Invalid unicode escape" );
+    if ( codePoint >= 0xD800 && codePoint <= 0xDBFF )
+    {
+        uint32_t lowSurrogate = 0;
+        if ( end_ - current_ >= 2 && current_[ 0 ] == '\\' && current_[ 1 ] == 'u' )
+        {
+            current_ += 2;
+            if ( !readHex( lowSurrogate ) )
+                return Fail( "Invalid unicode escape" );
+        }
+        if ( lowSurrogate >= 0xDC00 && lowSurrogate <= 0xDFFF )
+            codePoint = 0x10000 + ( ( codePoint - 0xD800 ) << 10 ) + ( lowSurrogate - 0xDC00 );
+        else
+            codePoint = 0xFFFD;
+    }
+    else if ( codePoint >= 0xDC00 && codePoint <= 0xDFFF )
+        codePoint = 0xFFFD;
+    AppendUtf8( buffer, codePoint );
+    return true;
+}
+
+bool JsonCursor::ReadNumberToken( std::string_view& token )
+{
+    SkipWhitespace();
+    const char* start = current_;
+    while ( current_ < end_ && IsNumberCharacter( *current_ ) )
+        ++current_;
+    if ( current_ == start )
+        return Fail( "Expected a number" );
+    token = std::string_view( start, static_cast< size_t >( current_ - start ) );
+    return true;
+}
+
+bool JsonCursor::SkipString()
+{
+    ++current_;
+    while ( current_ < end_ )
+    {
+        const char character = *current_++;
+        if ( character == '"' )
+            return true;
+        if ( character == '\\' && current_ < end_ )
+            ++current_;
+    }
+    return Fail( "Unterminated string" );
+}
+
+bool JsonCursor::SkipContainer()
+{
+    int depth = 0;
+    while ( current_ < end_ )
+    {
+        const char character = *current_;
+        if ( character == '"' )
+        {
+            if ( !SkipString() )
+                return false;
+            continue;
+        }
+        ++current_;
+        if ( character == '{' || character == '[' )
+            ++depth;
+        else if ( ( character == '}' || character == ']' ) && --depth == 0 )
+            return true;
+    }
+    return Fail( "Unterminated object or array" );
+}
+
+bool JsonCursor::SkipLiteral( std::string_view literal )
+{
+    if ( static_cast< size_t >( end_ - current_ ) < literal.size() || std::string_view( current_, literal.size() ) != literal )
+        return Fail( "Invalid literal" );
+    current_ += literal.size();
+    return true;
+}
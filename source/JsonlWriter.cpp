@@ -0,0 +1,134 @@
+#include "JsonlWriter.h"
+
+#include <charconv>
+#include <cmath>
+
+JsonlWriter::JsonlWriter( std::string& buffer )
+    : buffer_( buffer )
+{
+}
+
+void JsonlWriter::BeginObject()
+{
+    BeforeValue();
+    buffer_.push_back( '{' );
+    needsComma_ = false;
+}
+
+void JsonlWriter::EndObject()
+{
+    buffer_.push_back( '}' );
+    needsComma_ = true;
+}
+
+void JsonlWriter::BeginArray()
+{
+    BeforeValue();
+    buffer_.push_back( '[' );
+    needsComma_ = false;
+}
+
+void JsonlWriter::EndArray()
+{
+    buffer_.push_back( ']' );
+    needsComma_ = true;
+}
+
+void JsonlWriter::Key( std::string_view key )
+{
+    Write( key );
+    buffer_.push_back( ':' );
+    needsComma_ = false;
+}
+
+void JsonlWriter::Write( bool value )
+{
+    BeforeValue();
+    buffer_.append( value ? "true" : "false" );
+}
+
+void JsonlWriter::Write( double value )
+{
+    BeforeValue();
+    // JSON has no representation for them, null reads back as a missing value.
+    if ( !std::isfinite( value ) )
+    {
+        buffer_.append( "null" );
+        return;
+    }
+    char text[ 32 ];
+    const std::to_chars_result result = std::to_chars( text, text + sizeof( text ), value );
+    buffer_.append( text, result.ptr );
+}
+
+void JsonlWriter::Write( std::string_view value )
+{
+    static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+    BeforeValue();
+    buffer_.push_back( '"' );
+    for ( const char character : value )
+    {
+        switch ( character )
+        {
+            case '"':
+                buffer_.append( "\\\"" );
+                break;
+            case '\\':
+                buffer_.append( "\\\\" );
+                break;
+            case '\n':
+                buffer_.append( "\\n" );
+                break;
+            case '\r':
+                buffer_.append( "\\r" );
+                break;
+            case '\t':
+                buffer_.append( "\\t" );
+                break;
+            default:
+                if ( static_cast< unsigned char >( character ) < 0x20 )
+                {
+                    buffer_.append( "\\u00" );
+                    buffer_.push_back( HEX_DIGITS[ static_cast< unsigned char >( character ) >> 4 ] );
+                    buffer_.push_back( HEX_DIGITS[ character & 0xF ] );
+                }
+                else
+                    buffer_.push_back( character );
+        }
+    }
+    buffer_.push_back( '"' );
+}
+
+void JsonlWriter::Write( const char* value )
+{
+    Write( std::string_view( value ) );
+}
+
+void JsonlWriter::EndLine()
+{
+    buffer_.push_back( '\n' );
+    needsComma_ = false;
+}
+
+void JsonlWriter::BeforeValue()
+{
+    if ( needsComma_ )
+        buffer_.push_back( ',' );
+    needsComma_ = true;
+}
+
+void JsonlWriter::WriteInteger( long long value )
+{
+    BeforeValue();
+    char text[ 24 ];
+    const std::to_chars_result result = std::to_chars( text, text + sizeof( text ), value );
+    buffer_.append( text, result.ptr );
+}
+
+void JsonlWriter::WriteUnsigned( unsigned long long value )
+{
+    BeforeValue();
+    char text[ 24 ];
+    const std::to_chars_result result = std::to_chars( text, text + sizeof( text ), value );
+    buffer_.append( text, result.ptr );
+}
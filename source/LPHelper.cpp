@@ -2,61 +2,138 @@
 #include "Blueprint.h"
 #include "EveType.h"
 #include "GlobalRessources.h"
+#include "HelperFunctions.h"
 #include "LogManager.h"
 #include "Ore.h"
+#include "OreSolutionCache.h"
+
+static double GetRefiningYield( const Ore& ore, tTypeId materialId )
+{
+    for ( const auto& product : ore.GetRefinedProducts() )
+    {
+        if ( product.item == materialId )
+            return static_cast< double >( product.quantity ) / LPHelper::ORE_REFINING_BATCH_SIZE;
+    }
+    return 0.0;
+}
 
 LPHelper::LPHelper( const TypeIdMap< Ore >& ores )
     : ores_( ores )
 {
+    // Versions are sums of per ore hashes so they do not depend on the map iteration order.
+    yieldsVersion_ = HashValue( ORE_REFINING_BATCH_SIZE );
     for ( const auto& [ oreId, orePtr ] : ores_ )
     {
         lowerBounds_.push_back( 0.0 );
         upperBounds_.push_back( kHighsInf );
         objectiveCoefficients_.push_back( orePtr->GetBasePrice() );
         variableTypes_.push_back( HighsVarType::kInteger );
+
+        pricesVersion_ += HashValue( orePtr->GetBasePrice(), HashValue( oreId ) );
+        uint64_t oreYieldsHash = HashValue( oreId );
+        for ( const auto& [ materialId, quantity ] : orePtr->GetRefinedProducts() )
+        {
+            oreYieldsHash = HashValue( materialId, oreYieldsHash );
+            oreYieldsHash = HashValue( quantity, oreYieldsHash );
+        }
+        yieldsVersion_ += oreYieldsHash;
     }
 }
 
-bool LPHelper::SolveForBlueprint( const Blueprint& blueprint )
+void LPHelper::SetSolutionCache( OreSolutionCache* solutionCache )
+{
+    solutionCache_ = solutionCache;
+}
+
+void LPHelper::SetOwnedOres( const std::map< tTypeId, unsigned long long >& ownedOres )
+{
+    ownedOres_.clear();
+    for ( const auto& [ oreId, quantity ] : ownedOres )
+    {
+        if ( quantity > 0 && ores_.contains( oreId ) )
+            ownedOres_[ oreId ] = quantity;
+    }
+}
+
+bool LPHelper::SolveForBlueprint( const Blueprint& blueprint, const std::function< bool() >& shouldAbort )
+{
+    return SolveForRequirements( blueprint.GetProductionJob()->GetRecursedRawMaterialList(), shouldAbort );
+}
+
+bool LPHelper::SolveForRequirements( const std::map< tTypeId, unsigned int >& requirements, const std::function< bool() >& shouldAbort )
 {
+    PROFILE_FUNCTION();
     lpResult_.clear();
     leftover_.clear();
-    const auto& manufacturingJob = blueprint.GetManufacturingJob();
+    ownedOresUsed_.clear();
+
+    std::map< tTypeId, unsigned int > oreRequirements;
+    for ( const auto& [ typeId, quantity ] : requirements )
+    {
+        const auto type = GlobalRessources::GetTypeById( typeId );
+        if ( quantity == 0 || type == nullptr || !type->IsReprocessedFromOre() )
+            continue;
+        LOG_DEBUG( " Blueprint require {} x {}", typeId, quantity );
+        oreRequirements[ typeId ] = quantity;
+    }
+
+    // Solutions drawing from owned ores depend on the stock, they are not cached.
+    if ( solutionCache_ == nullptr || !ownedOres_.empty() )
+        return RunSolver( oreRequirements, shouldAbort );
+
+    const OreSolutionKey key = BuildSolutionKey( oreRequirements );
+    if ( const auto cachedSolution = solutionCache_->Find( key ) )
+    {
+        lpResult_ = cachedSolution->compressedOres;
+        leftover_ = cachedSolution->leftover;
+        return true;
+    }
+    if ( !RunSolver( oreRequirements, shouldAbort ) )
+        return false;
+    solutionCache_->Insert( key, GetSolution() );
+    return true;
+}
+
+OreSolutionKey LPHelper::BuildSolutionKey( const std::map< tTypeId, unsigned int >& oreRequirements ) const
+{
+    OreSolutionKey key;
+    key.pricesVersion = pricesVersion_;
+    key.yieldsVersion = yieldsVersion_;
+    key.requirements.reserve( oreRequirements.size() );
+    for ( const auto& [ typeId, quantity ] : oreRequirements )
+        key.requirements.push_back( { typeId, quantity } );
+    return key;
+}
+
+bool LPHelper::RunSolver( const std::map< tTypeId, unsigned int >& oreRequirements, const std::function< bool() >& shouldAbort )
+{
+    PROFILE_FUNCTION();
     constraintRowStarts_.clear();
     constraintColumnIndices_.clear();
     constraintValues_.clear();
     constraintLowerBounds_.clear();
     constraintUpperBounds_.clear();
 
-    std::map< tTypeId, unsigned int > requiredMats = manufacturingJob->GetRecursedRawMaterialList();
-    for ( auto it = requiredMats.begin(); it != requiredMats.end(); )
-    {
-        const EveType& type = *GlobalRessources::GetTypeById( it->first );
-        if ( !type.IsReprocessedFromOre() )
-        {
-            it = requiredMats.erase( it );
-            continue;
-        }
-        LOG_NOTICE( " Blueprint require {} x {}", it->first, it->second );
-        it++;
-    }
-    for ( const auto& [ requirement, quantity ] : requiredMats )
+    for ( const auto& [ requirement, quantity ] : oreRequirements )
     {
         int rowStart = static_cast< int >( constraintColumnIndices_.size() );
         constraintRowStarts_.push_back( rowStart );
 
+        // Bought ores first, then the owned ones in extra columns.
         int oreIndex = 0;
         for ( auto& [ oreId, orePtr ] : ores_ )
         {
-            double yield = 0.0;
-            for ( const auto& product : orePtr->GetRefinedProducts() )
+            const double yield = GetRefiningYield( *orePtr, requirement );
+            if ( yield > 0.0 )
             {
-                if ( product.item == requirement )
-                {
-                    yield = static_cast< double >( product.quantity ) / 100.0;
-                    break;
-                }
+                constraintColumnIndices_.push_back( oreIndex );
+                constraintValues_.push_back( yield );
             }
+            ++oreIndex;
+        }
+        for ( const auto& [ oreId, ownedQuantity ] : ownedOres_ )
+        {
+            const double yield = GetRefiningYield( *ores_.at( oreId ), requirement );
             if ( yield > 0.0 )
             {
                 constraintColumnIndices_.push_back( oreIndex );
@@ -68,21 +145,46 @@ bool LPHelper::SolveForBlueprint( const Blueprint& blueprint )
         constraintUpperBounds_.push_back( kHighsInf );
     }
     constraintRowStarts_.push_back( static_cast< int >( constraintColumnIndices_.size() ) );
-    HighsLp lp = BuildHighsLp( blueprint );
+    HighsLp lp = BuildHighsLp();
     Highs highs;
     highs.passModel( lp );
 
     for ( int i = 0; i < static_cast< int >( variableTypes_.size() ); i++ )
         highs.changeColIntegrality( i, variableTypes_[ i ] );
+    for ( int i = static_cast< int >( variableTypes_.size() ); i < lp.num_col_; i++ )
+        highs.changeColIntegrality( i, HighsVarType::kInteger );
 
-    HighsStatus status = highs.run();
+    if ( shouldAbort )
+    {
+        highs.setCallback(
+            []( int, const std::string&, const auto*, auto* dataIn, void* userData )
+            {
+                if ( ( *static_cast< const std::function< bool() >* >( userData ) )() )
+                    dataIn->user_interrupt = true;
+            },
+            const_cast< std::function< bool() >* >( &shouldAbort ) );
+        highs.startCallback( kCallbackSimplexInterrupt );
+        highs.startCallback( kCallbackIpmInterrupt );
+        highs.startCallback( kCallbackMipInterrupt );
+    }
+
+    HighsStatus status = HighsStatus::kError;
+    {
+        PROFILE_ZONE( "Highs::run" );
+        status = highs.run();
+    }
+    HighsModelStatus modelStatus = highs.getModelStatus();
+    if ( modelStatus == HighsModelStatus::kInterrupt )
+    {
+        LOG_NOTICE( "LP solve interrupted" );
+        return false;
+    }
     if ( status != HighsStatus::kOk )
     {
         LOG_WARNING( "Failed to solve LP" );
         return false;
     }
 
-    HighsModelStatus modelStatus = highs.getModelStatus();
     if ( modelStatus == HighsModelStatus::kInfeasible )
     {
         LOG_WARNING( "Failed to solve LP : Judged infeasible" );
@@ -98,9 +200,16 @@ bool LPHelper::SolveForBlueprint( const Blueprint& blueprint )
             lpResult_[ oreId ] = static_cast< unsigned int >( std::ceil( quantity ) );
         ++oreIndex;
     }
+    for ( const auto& [ oreId, ownedQuantity ] : ownedOres_ )
+    {
+        double quantity = sol.col_value[ oreIndex ];
+        if ( quantity > 0.0 )
+            ownedOresUsed_[ oreId ] = static_cast< unsigned int >( std::min( std::ceil( quantity ), static_cast< double >( ownedQuantity ) ) );
+        ++oreIndex;
+    }
 
     auto produced = ComputeTotalProduced();
-    ComputeLeftover( produced, blueprint );
+    ComputeLeftover( produced, oreRequirements );
 
     return true;
 }
@@ -115,15 +224,26 @@ const std::map< tTypeId, unsigned int >& LPHelper::GetLeftover() const
     return leftover_;
 }
 
-HighsLp LPHelper::BuildHighsLp( const Blueprint& blueprint ) const
+OreSolution LPHelper::GetSolution() const
+{
+    return OreSolution{ lpResult_, leftover_, ownedOresUsed_ };
+}
+
+HighsLp LPHelper::BuildHighsLp() const
 {
     HighsLp lp;
-    lp.num_col_ = static_cast< int >( ores_.size() );
+    lp.num_col_ = static_cast< int >( ores_.size() + ownedOres_.size() );
     lp.num_row_ = static_cast< int >( constraintLowerBounds_.size() );
 
     lp.col_cost_ = objectiveCoefficients_;
     lp.col_lower_ = lowerBounds_;
     lp.col_upper_ = upperBounds_;
+    for ( const auto& [ oreId, ownedQuantity ] : ownedOres_ )
+    {
+        lp.col_cost_.push_back( OWNED_ORE_COST );
+        lp.col_lower_.push_back( 0.0 );
+        lp.col_upper_.push_back( static_cast< double >( ownedQuantity ) );
+    }
     lp.row_lower_ = constraintLowerBounds_;
     lp.row_upper_ = constraintUpperBounds_;
 
@@ -152,30 +272,27 @@ std::map< tTypeId, double > LPHelper::ComputeTotalProduced() const
         }
 
         for ( const auto& product : ore->GetRefinedProducts() )
-            produced[ product.item ] += oreCount * product.quantity;
+            produced[ product.item ] += oreCount * product.quantity / ORE_REFINING_BATCH_SIZE;
 
         oreIndex++;
     }
+    for ( const auto& [ oreId, oreCount ] : ownedOresUsed_ )
+    {
+        for ( const auto& product : ores_.at( oreId )->GetRefinedProducts() )
+            produced[ product.item ] += oreCount * product.quantity / ORE_REFINING_BATCH_SIZE;
+    }
     return produced;
 }
 
-void LPHelper::ComputeLeftover( std::map< tTypeId, double >& produced, const Blueprint& blueprint )
+void LPHelper::ComputeLeftover( std::map< tTypeId, double >& produced, const std::map< tTypeId, unsigned int >& oreRequirements )
 {
     for ( auto& kv : produced )
     {
         tTypeId typeId = kv.first;
         double totalProduced = kv.second;
 
-        double required = 0.0;
-        const auto& job = blueprint.GetManufacturingJob();
-        for ( const auto& req : job->GetRawMaterials() )
-        {
-            if ( req.item == typeId )
-            {
-                required = req.quantity;
-                break;
-            }
-        }
+        const auto requirement = oreRequirements.find( typeId );
+        double required = requirement != oreRequirements.end() ? static_cast< double >( requirement->second ) : 0.0;
 
         double extra = totalProduced - required;
 
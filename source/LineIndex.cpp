@@ -0,0 +1,195 @@
+#include "LineIndex.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined( __x86_64__ ) || defined( _M_X64 )
+#    define LINE_INDEX_X86 1
+#    include <immintrin.h>
+#    ifdef _MSC_VER
+#        include <intrin.h>
+#        define LINE_INDEX_TARGET_AVX2
+#    else
+#        define LINE_INDEX_TARGET_AVX2 __attribute__( ( target( "avx2" ) ) )
+#    endif
+#endif
+
+static void AppendLineBreaksScalar( const char* data, size_t begin, size_t size, std::vector< qint64 >& offsets )
+{
+    const char* current = data + begin;
+    const char* end = data + size;
+    while ( current < end )
+    {
+        const char* lineBreak = static_cast< const char* >( std::memchr( current, '\n', static_cast< size_t >( end - current ) ) );
+        if ( !lineBreak )
+            return;
+        offsets.push_back( lineBreak - data + 1 );
+        current = lineBreak + 1;
+    }
+}
+
+#ifdef LINE_INDEX_X86
+static void AppendMaskOffsets( uint32_t mask, size_t blockOffset, std::vector< qint64 >& offsets )
+{
+    while ( mask != 0 )
+    {
+        offsets.push_back( static_cast< qint64 >( blockOffset + std::countr_zero( mask ) + 1 ) );
+        mask &= mask - 1;
+    }
+}
+
+// SSE2 is part of x86-64, no runtime check needed.
+static void AppendLineBreaksSse2( const char* data, size_t size, std::vector< qint64 >& offsets )
+{
+    const __m128i newlines = _mm_set1_epi8( '\n' );
+    size_t offset = 0;
+    for ( ; offset + 16 <= size; offset += 16 )
+    {
+        const __m128i block = _mm_loadu_si128( reinterpret_cast< const __m128i* >( data + offset ) );
+        AppendMaskOffsets( static_cast< uint32_t >( _mm_movemask_epi8( _mm_cmpeq_epi8( block, newlines ) ) ), offset, offsets );
+    }
+    AppendLineBreaksScalar( data, offset, size, offsets );
+}
+
+LINE_INDEX_TARGET_AVX2 static void AppendLineBreaksAvx2( const char* data, size_t size, std::vector< qint64 >& offsets )
+{
+    const __m256i newlines = _mm256_set1_epi8( '\n' );
+    size_t offset = 0;
+    for ( ; offset + 64 <= size; offset += 64 )
+    {
+        // Two registers per iteration, lines are rarely shorter than 64 bytes so most blocks have no bit set.
+        const __m256i low = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( data + offset ) );
+        const __m256i high = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( data + offset + 32 ) );
+        const uint32_t lowMask = static_cast< uint32_t >( _mm256_movemask_epi8( _mm256_cmpeq_epi8( low, newlines ) ) );
+        const uint32_t highMask = static_cast< uint32_t >( _mm256_movemask_epi8( _mm256_cmpeq_epi8( high, newlines ) ) );
+        if ( ( lowMask | highMask ) == 0 )
+            continue;
+        AppendMaskOffsets( lowMask, offset, offsets );
+        AppendMaskOffsets( highMask, offset + 32, offsets );
+    }
+    AppendLineBreaksScalar( data, offset, size, offsets );
+}
+
+static bool IsAvx2Supported()
+{
+#    ifdef _MSC_VER
+    int registers[ 4 ] = {};
+    __cpuid( registers, 1 );
+    const bool isOsSavingAvx = ( registers[ 2 ] & ( 1 << 27 ) ) != 0 && ( registers[ 2 ] & ( 1 << 28 ) ) != 0 && ( _xgetbv( 0 ) & 0x6 ) == 0x6;
+    if ( !isOsSavingAvx )
+        return false;
+    __cpuidex( registers, 7, 0 );
+    return ( registers[ 1 ] & ( 1 << 5 ) ) != 0;
+#    else
+    return __builtin_cpu_supports( "avx2" );
+#    endif
+}
+#endif
+
+MappedFile::~MappedFile()
+{
+    if ( mapping_ )
+        file_->unmap( mapping_ );
+}
+
+bool MappedFile::Map( QFile& file )
+{
+    file_ = &file;
+    const qint64 size = file.size();
+    if ( size == 0 )
+    {
+        data_ = std::string_view();
+        return true;
+    }
+    mapping_ = file.map( 0, size );
+    if ( mapping_ )
+    {
+        data_ = std::string_view( reinterpret_cast< const char* >( mapping_ ), static_cast< size_t >( size ) );
+        return true;
+    }
+    buffer_ = file.readAll();
+    data_ = std::string_view( buffer_.constData(), static_cast< size_t >( buffer_.size() ) );
+    return buffer_.size() == size;
+}
+
+std::string_view MappedFile::GetData() const
+{
+    return data_;
+}
+
+void LineIndex::Build( std::string_view data, const QFileInfo& fileInfo )
+{
+    fileSize_ = fileInfo.size();
+    lastModifiedMs_ = fileInfo.lastModified().toMSecsSinceEpoch();
+    lineStarts_.clear();
+    if ( data.empty() )
+    {
+        lineStarts_.push_back( 0 );
+        return;
+    }
+
+    lineStarts_.reserve( data.size() / 256 + 2 );
+    lineStarts_.push_back( 0 );
+    AppendLineBreaks( data, lineStarts_ );
+    // Past the last line break, either the end of the data or the start of a line without a line ending.
+    if ( lineStarts_.back() != static_cast< qint64 >( data.size() ) )
+        lineStarts_.push_back( static_cast< qint64 >( data.size() ) );
+}
+
+bool LineIndex::IsUpToDate( const QFileInfo& fileInfo ) const
+{
+    return fileSize_ == fileInfo.size() && lastModifiedMs_ == fileInfo.lastModified().toMSecsSinceEpoch();
+}
+
+qint64 LineIndex::GetLineCount() const
+{
+    return lineStarts_.empty() ? 0 : static_cast< qint64 >( lineStarts_.size() ) - 1;
+}
+
+std::string_view LineIndex::GetLine( std::string_view data, qint64 line ) const
+{
+    const size_t start = static_cast< size_t >( lineStarts_[ line ] );
+    size_t end = static_cast< size_t >( lineStarts_[ line + 1 ] );
+    while ( end > start && ( data[ end - 1 ] == '\n' || data[ end - 1 ] == '\r' ) )
+        --end;
+    return data.substr( start, end - start );
+}
+
+std::vector< LineIndex::tLineRange > LineIndex::Split( int chunkCount ) const
+{
+    std::vector< tLineRange > ranges;
+    const qint64 lineCount = GetLineCount();
+    if ( lineCount == 0 )
+        return ranges;
+
+    chunkCount = std::max( chunkCount, 1 );
+    const qint64 totalBytes = lineStarts_.back();
+    qint64 firstLine = 0;
+    for ( int chunk = 1; chunk <= chunkCount && firstLine < lineCount; ++chunk )
+    {
+        const qint64 targetOffset = totalBytes / chunkCount * chunk;
+        qint64 lastLine = chunk == chunkCount ? lineCount
+                                              : std::lower_bound( lineStarts_.begin(), lineStarts_.end() - 1, targetOffset ) - lineStarts_.begin();
+        lastLine = std::clamp( lastLine, firstLine + 1, lineCount );
+        ranges.emplace_back( firstLine, lastLine );
+        firstLine = lastLine;
+    }
+    return ranges;
+}
+
+void LineIndex::AppendLineBreaks( std::string_view data, std::vector< qint64 >& offsets )
+{
+#ifdef LINE_INDEX_X86
+    static const bool isAvx2Supported = IsAvx2Supported();
+    if ( isAvx2Supported )
+        AppendLineBreaksAvx2( data.data(), data.size(), offsets );
+    else
+        AppendLineBreaksSse2( data.data(), data.size(), offsets );
+#else
+    AppendLineBreaksScalar( data.data(), 0, data.size(), offsets );
+#endif
+}
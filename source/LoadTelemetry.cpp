@@ -0,0 +1,244 @@
+#include "LoadTelemetry.h"
+#include "LogManager.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+
+#ifdef _WIN32
+#    define NOMINMAX
+#    define PSAPI_VERSION 2 // GetProcessMemoryInfo from kernel32, no psapi import library needed.
+#    include <windows.h>
+#    include <psapi.h>
+#else
+#    include <sys/resource.h>
+#endif
+
+static constexpr double MEBIBYTE = 1024.0 * 1024.0;
+
+static QJsonObject StageToJson( const LoadStageMetrics& stage )
+{
+    QJsonObject stageJson;
+    stageJson[ "step" ] = static_cast< int >( stage.step );
+    stageJson[ "name" ] = stage.name;
+    stageJson[ "wallSeconds" ] = stage.wallSeconds;
+    stageJson[ "cpuSeconds" ] = stage.cpuSeconds;
+    stageJson[ "bytesRead" ] = stage.bytesRead;
+    stageJson[ "bytesWritten" ] = stage.bytesWritten;
+    stageJson[ "recordsParsed" ] = stage.recordsParsed;
+    stageJson[ "peakRssBytes" ] = stage.peakRssBytes;
+    return stageJson;
+}
+
+static LoadStageMetrics StageFromJson( const QJsonObject& stageJson )
+{
+    LoadStageMetrics stage;
+    stage.step = static_cast< eDataLoadingSteps >( stageJson.value( "step" ).toInt() );
+    stage.name = stageJson.value( "name" ).toString();
+    stage.wallSeconds = stageJson.value( "wallSeconds" ).toDouble();
+    stage.cpuSeconds = stageJson.value( "cpuSeconds" ).toDouble();
+    stage.bytesRead = stageJson.value( "bytesRead" ).toInteger();
+    stage.bytesWritten = stageJson.value( "bytesWritten" ).toInteger();
+    stage.recordsParsed = stageJson.value( "recordsParsed" ).toInteger();
+    stage.peakRssBytes = stageJson.value( "peakRssBytes" ).toInteger();
+    return stage;
+}
+
+// Runs written before HISTORY_VERSION existed have none, and count as version 0.
+static bool IsCurrentVersion( const QJsonObject& runJson )
+{
+    return runJson.value( "version" ).toInt() == LoadTelemetry::HISTORY_VERSION;
+}
+
+void LoadTelemetry::BeginStage( eDataLoadingSteps step, const QString& name )
+{
+    EndStage();
+    currentStage_ = LoadStageMetrics();
+    currentStage_->step = step;
+    currentStage_->name = name;
+    stageStartTime_ = std::chrono::steady_clock::now();
+    stageStartCpuSeconds_ = GetProcessCpuSeconds();
+}
+
+void LoadTelemetry::EndStage()
+{
+    if ( !currentStage_ )
+        return;
+    currentStage_->wallSeconds = std::chrono::duration< double >( std::chrono::steady_clock::now() - stageStartTime_ ).count();
+    currentStage_->cpuSeconds = GetProcessCpuSeconds() - stageStartCpuSeconds_;
+    currentStage_->peakRssBytes = GetPeakRssBytes();
+    stages_.push_back( *currentStage_ );
+    currentStage_.reset();
+}
+
+void LoadTelemetry::AddBytesRead( qint64 bytes )
+{
+    if ( currentStage_ )
+        currentStage_->bytesRead += bytes;
+}
+
+void LoadTelemetry::AddBytesWritten( qint64 bytes )
+{
+    if ( currentStage_ )
+        currentStage_->bytesWritten += bytes;
+}
+
+void LoadTelemetry::AddRecordsParsed( qint64 records )
+{
+    if ( currentStage_ )
+        currentStage_->recordsParsed += records;
+}
+
+LoadThroughput LoadTelemetry::GetThroughput( double progress ) const
+{
+    LoadThroughput throughput;
+    if ( !currentStage_ )
+        return throughput;
+
+    const double elapsedSeconds = std::chrono::duration< double >( std::chrono::steady_clock::now() - stageStartTime_ ).count();
+    if ( elapsedSeconds > 0.0 )
+    {
+        throughput.bytesPerSecond = static_cast< double >( currentStage_->bytesRead + currentStage_->bytesWritten ) / elapsedSeconds;
+        throughput.recordsPerSecond = static_cast< double >( currentStage_->recordsParsed ) / elapsedSeconds;
+    }
+
+    // The latest run that went through this stage tells how long it and the stages after it took on this machine.
+    for ( auto run = history_.rbegin(); run != history_.rend(); ++run )
+    {
+        const auto stage = std::find_if(
+            run->begin(), run->end(), [ this ]( const LoadStageMetrics& metrics ) { return metrics.step == currentStage_->step; } );
+        if ( stage == run->end() )
+            continue;
+
+        double remainingSeconds = std::max( stage->wallSeconds - elapsedSeconds, 0.0 );
+        if ( progress > 0.0 && progress < 1.0 )
+            remainingSeconds = elapsedSeconds * ( 1.0 - progress ) / progress;
+        for ( auto nextStage = std::next( stage ); nextStage != run->end(); ++nextStage )
+            remainingSeconds += nextStage->wallSeconds;
+        throughput.etaSeconds = remainingSeconds;
+        break;
+    }
+    return throughput;
+}
+
+const std::vector< LoadStageMetrics >& LoadTelemetry::GetStages() const
+{
+    return stages_;
+}
+
+bool LoadTelemetry::LoadHistory( const QString& filePath )
+{
+    history_.clear();
+    QFile file( filePath );
+    if ( !file.open( QIODevice::ReadOnly | QIODevice::Text ) )
+        return false;
+
+    while ( !file.atEnd() )
+    {
+        const QJsonDocument doc = QJsonDocument::fromJson( file.readLine() );
+        if ( !doc.isObject() || !IsCurrentVersion( doc.object() ) )
+            continue;
+        std::vector< LoadStageMetrics > run;
+        for ( const QJsonValue& stageValue : doc.object().value( "stages" ).toArray() )
+            run.push_back( StageFromJson( stageValue.toObject() ) );
+        if ( !run.empty() )
+            history_.push_back( std::move( run ) );
+    }
+    return true;
+}
+
+bool LoadTelemetry::AppendToHistory( const QString& filePath ) const
+{
+    QStringList lines;
+    QFile file( filePath );
+    if ( file.open( QIODevice::ReadOnly | QIODevice::Text ) )
+    {
+        while ( !file.atEnd() )
+        {
+            const QByteArray line = file.readLine().trimmed();
+            if ( IsCurrentVersion( QJsonDocument::fromJson( line ).object() ) )
+                lines.append( QString::fromUtf8( line ) );
+        }
+        file.close();
+    }
+
+    QJsonArray stagesJson;
+    for ( const LoadStageMetrics& stage : stages_ )
+        stagesJson.append( StageToJson( stage ) );
+    QJsonObject runJson;
+    runJson[ "version" ] = HISTORY_VERSION;
+    runJson[ "date" ] = QDateTime::currentDateTime().toString( Qt::ISODate );
+    runJson[ "stages" ] = stagesJson;
+    lines.append( QString::fromUtf8( QJsonDocument( runJson ).toJson( QJsonDocument::Compact ) ) );
+    while ( lines.size() > MAX_HISTORY_RUNS )
+        lines.removeFirst();
+
+    QDir().mkpath( QFileInfo( filePath ).absolutePath() );
+    if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text ) )
+    {
+        LOG_WARNING( "Could not write load metrics to {}", filePath.toStdString() );
+        return false;
+    }
+    file.write( lines.join( '\n' ).toUtf8() + '\n' );
+    return true;
+}
+
+void LoadTelemetry::LogSummary() const
+{
+    for ( const LoadStageMetrics& stage : stages_ )
+    {
+        const double cpuRatio = stage.wallSeconds > 0.0 ? stage.cpuSeconds / stage.wallSeconds * 100.0 : 0.0;
+        LOG_NOTICE( "Stage {} : wall {:.3f}s, cpu {:.3f}s ({:.0f}%), read {:.1f} MiB, written {:.1f} MiB, {} records, peak RSS {:.0f} MiB",
+                    stage.name.toStdString(),
+                    stage.wallSeconds,
+                    stage.cpuSeconds,
+                    cpuRatio,
+                    stage.bytesRead / MEBIBYTE,
+                    stage.bytesWritten / MEBIBYTE,
+                    stage.recordsParsed,
+                    stage.peakRssBytes / MEBIBYTE );
+    }
+}
+
+qint64 LoadTelemetry::GetPeakRssBytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if ( !GetProcessMemoryInfo( GetCurrentProcess(), &counters, sizeof( counters ) ) )
+        return 0;
+    return static_cast< qint64 >( counters.PeakWorkingSetSize );
+#else
+    struct rusage usage;
+    if ( getrusage( RUSAGE_SELF, &usage ) != 0 )
+        return 0;
+#    ifdef __APPLE__
+    return static_cast< qint64 >( usage.ru_maxrss ); // Bytes on macOS, kilobytes elsewhere.
+#    else
+    return static_cast< qint64 >( usage.ru_maxrss ) * 1024;
+#    endif
+#endif
+}
+
+double LoadTelemetry::GetProcessCpuSeconds()
+{
+#ifdef _WIN32
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if ( !GetProcessTimes( GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime ) )
+        return 0.0;
+    auto toSeconds = []( const FILETIME& time )
+    { return static_cast< double >( ( static_cast< uint64_t >( time.dwHighDateTime ) << 32 ) | time.dwLowDateTime ) / 1e7; };
+    return toSeconds( kernelTime ) + toSeconds( userTime );
+#else
+    struct rusage usage;
+    if ( getrusage( RUSAGE_SELF, &usage ) != 0 )
+        return 0.0;
+    auto toSeconds = []( const timeval& time ) { return static_cast< double >( time.tv_sec ) + static_cast< double >( time.tv_usec ) / 1e6; };
+    return toSeconds( usage.ru_utime ) + toSeconds( usage.ru_stime );
+#endif
+}
@@ -1,14 +1,37 @@
+#include "CliApplication.h"
+#include "LogManager.h"
 #include "MainWindow.h"
 #include <qapplication.h>
+#include <qcoreapplication.h>
+#include <qtimer.h>
 
 
 int main( int argc, char** argv )
 {
-    QApplication app( argc, argv );
-    MainWindow mainWindow( "EoMultiTool", "0.01" );
+    Profiler::EnableFromArguments( argc, argv );
+    PROFILE_THREAD_NAME( "Main" );
 
-    mainWindow.show();
-    int rc = app.exec();
+    int rc = 0;
+    if ( CliApplication::IsRequested( argc, argv ) )
+    {
+        QCoreApplication app( argc, argv );
+        CliApplication cliApplication;
+        QTimer::singleShot( 0, &cliApplication, &CliApplication::Start );
+        rc = app.exec();
+    }
+    else
+    {
+        QApplication app( argc, argv );
+        MainWindow mainWindow( "EoMultiTool", "0.01" );
 
+        mainWindow.show();
+        rc = app.exec();
+    }
+
+    if ( Profiler::IsEnabled() )
+    {
+        const std::string tracePath = Profiler::ExportToLogDirectory();
+        LOG_NOTICE( "Profile written to {}", tracePath );
+    }
     return rc;
 }
@@ -173,6 +173,7 @@ void MainWindow::BuildBaseInterface()
 
 void MainWindow::OnDataLoadingFinished()
 {
+    PROFILE_FUNCTION();
     LOG_NOTICE( "Quitting data loading thread" );
     dataLoadingThread_->quit();
     dataLoadingThread_->wait();
@@ -189,6 +190,7 @@ void MainWindow::OnDataLoadingFinished()
 
 void MainWindow::StartDataLoading()
 {
+    PROFILE_FUNCTION();
     DataLoadingWidget* dataLoadingWidget = new DataLoadingWidget;
     AddPage( dataLoadingWidget );
     GoToPage( pages_->count() - 1 );
@@ -196,16 +198,7 @@ void MainWindow::StartDataLoading()
     dataLoadingThread_ = new QThread( this );
     ressourcesManager_->moveToThread( dataLoadingThread_ );
 
-    connect( ressourcesManager_.get(),
-             &RessourcesManager::RessourcesLoadingMainStepChanged,
-             dataLoadingWidget,
-             &DataLoadingWidget::OnMainDataLoadingStepChanged,
-             Qt::QueuedConnection );
-    connect( ressourcesManager_.get(),
-             &RessourcesManager::RessourcesLoadingSubStepChanged,
-             dataLoadingWidget,
-             &DataLoadingWidget::OnSubDataLoadingStepChanged,
-             Qt::QueuedConnection );
+    dataLoadingWidget->SetProgressReporter( ressourcesManager_->GetProgressReporter() );
     connect( ressourcesManager_.get(),
              &RessourcesManager::ErrorOccured,
              dataLoadingWidget,
@@ -214,6 +207,7 @@ void MainWindow::StartDataLoading()
     connect(
         ressourcesManager_.get(), &RessourcesManager::RessourcesReady, this, &MainWindow::OnDataLoadingFinished, Qt::QueuedConnection );
 
+    connect( dataLoadingThread_, &QThread::started, []() { PROFILE_THREAD_NAME( "Data loading" ); } );
     connect( dataLoadingThread_, &QThread::started, ressourcesManager_.get(), &RessourcesManager::LoadRessources );
     dataLoadingThread_->start();
 }
@@ -2,17 +2,30 @@
 #include "Blueprint.h"
 #include "EveType.h"
 #include "GlobalRessources.h"
+#include "JsonlWriter.h"
 #include "LogManager.h"
+#include "SdeImport.h"
 
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QJsonValue>
 
-ManufacturingJob::ManufacturingJob( const QJsonObject& jsonData )
+ManufacturingJob::ManufacturingJob( eIndustryActivity activity, const QJsonObject& jsonData )
+    : activity_( activity )
 {
     FromJsonObject( jsonData );
 }
 
+ManufacturingJob::ManufacturingJob( eIndustryActivity activity, const SdeActivityRecord& record )
+    : activity_( activity )
+    , isValid_( true )
+    , timeInSeconds_( record.timeInSeconds )
+    , probability_( record.probability )
+    , manufacturedProducts_( record.products.begin(), record.products.end() )
+    , matRequirements_( record.materials.begin(), record.materials.end() )
+{
+}
+
 void ManufacturingJob::FromJsonObject( const QJsonObject& jsonData )
 {
     if ( jsonData.isEmpty() )
@@ -81,42 +94,56 @@ void ManufacturingJob::FromJsonObject( const QJsonObject& jsonData )
                 LOG_WARNING( "Product missing quantity." );
                 continue;
             }
+            if ( prodObject.contains( "probability" ) && prodObject.value( "probability" ).isDouble() )
+                probability_ = prodObject.value( "probability" ).toDouble();
             manufacturedProducts_.push_back( product );
         }
     }
     isValid_ = true;
 }
 
-QJsonObject ManufacturingJob::ToJsonObject() const
+void ManufacturingJob::WriteJson( JsonlWriter& writer ) const
 {
     if ( !isValid_ )
         throw std::runtime_error( "Attempted to serialize an invalid ManufacturingJob." );
 
-    QJsonObject manufacturingObj;
-
-    manufacturingObj[ "time" ] = static_cast< qint64 >( timeInSeconds_ );
-
-    QJsonArray materialsArray;
-    for ( const auto& matReq : matRequirements_ )
+    auto writeQuantities = [ &writer ]( std::string_view key,
+                                        const std::vector< WithQuantity< tTypeId > >& quantities,
+                                        const std::optional< double >& probability )
     {
-        QJsonObject matObj;
-        matObj[ "typeID" ] = static_cast< qint64 >( matReq.item );
-        matObj[ "quantity" ] = static_cast< qint64 >( matReq.quantity );
-        materialsArray.append( matObj );
-    }
-    manufacturingObj[ "materials" ] = materialsArray;
+        writer.Key( key );
+        writer.BeginArray();
+        for ( const auto& quantity : quantities )
+        {
+            writer.BeginObject();
+            writer.Member( "typeID", quantity.item );
+            writer.Member( "quantity", quantity.quantity );
+            if ( probability )
+                writer.Member( "probability", *probability );
+            writer.EndObject();
+        }
+        writer.EndArray();
+    };
+    writer.BeginObject();
+    writer.Member( "time", timeInSeconds_ );
+    writeQuantities( "materials", matRequirements_, std::nullopt );
+    writeQuantities( "products", manufacturedProducts_, probability_ );
+    writer.EndObject();
+}
 
-    QJsonArray productsArray;
-    for ( const auto& product : manufacturedProducts_ )
-    {
-        QJsonObject prodObj;
-        prodObj[ "typeID" ] = static_cast< qint64 >( product.item );
-        prodObj[ "quantity" ] = static_cast< qint64 >( product.quantity );
-        productsArray.append( prodObj );
-    }
-    manufacturingObj[ "products" ] = productsArray;
+eIndustryActivity ManufacturingJob::GetActivity() const
+{
+    return activity_;
+}
 
-    return manufacturingObj;
+unsigned int ManufacturingJob::GetTimeInSeconds() const
+{
+    return timeInSeconds_;
+}
+
+double ManufacturingJob::GetProbability() const
+{
+    return probability_.value_or( 1.0 );
 }
 
 const std::vector< WithQuantity< tTypeId > >& ManufacturingJob::GetComponents() const
@@ -139,8 +166,17 @@ const std::vector< WithQuantity< tTypeId > >& ManufacturingJob::GetFullMaterialL
     return matRequirements_;
 }
 
-std::map< tTypeId, unsigned int > ManufacturingJob::GetRecursedRawMaterialList() const
+const std::map< tTypeId, unsigned int >& ManufacturingJob::GetRecursedRawMaterialList() const
 {
+    std::call_once( recursedRawMaterialsFlag_, [ this ]() { recursedRawMaterials_ = BuildRecursedRawMaterialList(); } );
+    return recursedRawMaterials_;
+}
+
+std::map< tTypeId, unsigned int > ManufacturingJob::BuildRecursedRawMaterialList() const
+{
+    if ( !componentsFiltered_ )
+        throw std::runtime_error( "Attempted to expand materials before components were filtered." );
+
     std::map< tTypeId, unsigned int > rawMaterialList;
     for ( const auto& [ material, quantity ] : GetRawMaterials() )
     {
@@ -153,8 +189,8 @@ std::map< tTypeId, unsigned int > ManufacturingJob::GetRecursedRawMaterialList()
     for ( const auto component : GetComponents() )
     {
         const std::shared_ptr< Blueprint > blueprint = GlobalRessources::GetBlueprintByProductId( component.item );
-        const auto job = blueprint->GetManufacturingJob();
-        std::map< tTypeId, unsigned int > componentRawMaterialList = job->GetRecursedRawMaterialList();
+        const auto job = blueprint->GetProductionJob();
+        const std::map< tTypeId, unsigned int >& componentRawMaterialList = job->GetRecursedRawMaterialList();
         for ( const auto& [ componentMaterial, quantity ] : componentRawMaterialList )
         {
             if ( rawMaterialList.contains( componentMaterial ) )
@@ -181,7 +217,7 @@ void ManufacturingJob::FilterComponents()
     {
 
         auto matType = GlobalRessources::GetTypeById( matReq.item );
-        if ( matType->IsManufacturable() )
+        if ( matType != nullptr && matType->IsManufacturable() )
             components_.emplace_back( matReq.item, matReq.quantity );
         else
             rawMaterials_.emplace_back( matReq.item, matReq.quantity );
@@ -0,0 +1,235 @@
+#include "MaterialTreeModel.h"
+#include "Blueprint.h"
+#include "EveType.h"
+#include "GlobalRessources.h"
+
+static constexpr int COLUMN_COUNT = 3;
+
+MaterialTreeModel::MaterialTreeModel( QObject* parent )
+    : QAbstractItemModel( parent )
+    , root_( std::make_unique< Node >() )
+{
+    root_->areChildrenFetched = true;
+}
+
+void MaterialTreeModel::SetBlueprint( const std::shared_ptr< const Blueprint > blueprint )
+{
+    beginResetModel();
+    root_ = std::make_unique< Node >();
+    root_->areChildrenFetched = true;
+    blueprintName_.clear();
+    if ( blueprint != nullptr && blueprint->GetProductionJob() != nullptr )
+    {
+        blueprintName_ = blueprint->GetName();
+        auto blueprintNode = std::make_unique< Node >();
+        blueprintNode->kind = eNodeKind::Blueprint;
+        blueprintNode->typeId = blueprint->GetTypeId();
+        blueprintNode->blueprintId = blueprint->GetTypeId();
+        blueprintNode->quantity = 1;
+        blueprintNode->parent = root_.get();
+        root_->children.push_back( std::move( blueprintNode ) );
+    }
+    endResetModel();
+}
+
+void MaterialTreeModel::Clear()
+{
+    SetBlueprint( nullptr );
+}
+
+QModelIndex MaterialTreeModel::index( int row, int column, const QModelIndex& parent ) const
+{
+    if ( !hasIndex( row, column, parent ) )
+        return QModelIndex();
+
+    Node* parentNode = NodeFromIndex( parent );
+    return createIndex( row, column, parentNode->children[ row ].get() );
+}
+
+QModelIndex MaterialTreeModel::parent( const QModelIndex& child ) const
+{
+    if ( !child.isValid() )
+        return QModelIndex();
+
+    Node* parentNode = NodeFromIndex( child )->parent;
+    if ( parentNode == nullptr || parentNode == root_.get() )
+        return QModelIndex();
+    return createIndex( parentNode->row, 0, parentNode );
+}
+
+int MaterialTreeModel::rowCount( const QModelIndex& parent ) const
+{
+    if ( parent.column() > 0 )
+        return 0;
+    return static_cast< int >( NodeFromIndex( parent )->children.size() );
+}
+
+int MaterialTreeModel::columnCount( const QModelIndex& ) const
+{
+    return COLUMN_COUNT;
+}
+
+QVariant MaterialTreeModel::data( const QModelIndex& index, int role ) const
+{
+    if ( !index.isValid() || role != Qt::DisplayRole )
+        return QVariant();
+
+    const Node& node = *NodeFromIndex( index );
+    switch ( index.column() )
+    {
+        case 0:
+            if ( node.kind == eNodeKind::TotalRawMaterials )
+                return tr( "Total raw materials" );
+            if ( node.kind == eNodeKind::Details )
+                return tr( "Details" );
+            if ( node.kind == eNodeKind::Blueprint )
+                return blueprintName_;
+            return GetTypeName( node.typeId );
+        case 1:
+            if ( node.kind == eNodeKind::TotalRawMaterials || node.kind == eNodeKind::Details )
+                return QString();
+            return QString::number( node.quantity );
+        case 2:
+        {
+            const auto type = GlobalRessources::GetTypeById( node.typeId );
+            if ( node.kind == eNodeKind::RawMaterial && type != nullptr )
+                return QString::number( static_cast< int >( type->GetBasePrice() ) );
+            if ( node.kind == eNodeKind::RecursedRawMaterial && type != nullptr )
+                return QString::number( static_cast< int >( type->GetMarketPrice().averagePrice ) );
+            if ( node.kind == eNodeKind::Blueprint || node.kind == eNodeKind::Component )
+                return QStringLiteral( "0" );
+            return QString();
+        }
+        default:
+            return QVariant();
+    }
+}
+
+QVariant MaterialTreeModel::headerData( int section, Qt::Orientation orientation, int role ) const
+{
+    if ( orientation != Qt::Horizontal || role != Qt::DisplayRole )
+        return QVariant();
+
+    switch ( section )
+    {
+        case 0:
+            return tr( "Material" );
+        case 1:
+            return tr( "Quantity" );
+        case 2:
+            return tr( "Base price" );
+        default:
+            return QVariant();
+    }
+}
+
+bool MaterialTreeModel::hasChildren( const QModelIndex& parent ) const
+{
+    if ( parent.column() > 0 )
+        return false;
+    const Node& node = *NodeFromIndex( parent );
+    if ( node.areChildrenFetched )
+        return !node.children.empty();
+    return CanHaveChildren( node );
+}
+
+bool MaterialTreeModel::canFetchMore( const QModelIndex& parent ) const
+{
+    if ( !parent.isValid() )
+        return false;
+    const Node& node = *NodeFromIndex( parent );
+    return !node.areChildrenFetched && CanHaveChildren( node );
+}
+
+void MaterialTreeModel::fetchMore( const QModelIndex& parent )
+{
+    if ( !canFetchMore( parent ) )
+        return;
+
+    Node& node = *NodeFromIndex( parent );
+    std::vector< std::unique_ptr< Node > > children = BuildChildren( node );
+    node.areChildrenFetched = true;
+    if ( children.empty() )
+        return;
+
+    beginInsertRows( parent, 0, static_cast< int >( children.size() ) - 1 );
+    node.children = std::move( children );
+    endInsertRows();
+}
+
+MaterialTreeModel::Node* MaterialTreeModel::NodeFromIndex( const QModelIndex& index ) const
+{
+    if ( !index.isValid() )
+        return root_.get();
+    return static_cast< Node* >( index.internalPointer() );
+}
+
+bool MaterialTreeModel::CanHaveChildren( const Node& node ) const
+{
+    switch ( node.kind )
+    {
+        case eNodeKind::Blueprint:
+        case eNodeKind::TotalRawMaterials:
+        case eNodeKind::Details:
+            return true;
+        case eNodeKind::Component:
+            return node.blueprintId != 0;
+        default:
+            return false;
+    }
+}
+
+std::vector< std::unique_ptr< MaterialTreeModel::Node > > MaterialTreeModel::BuildChildren( Node& node ) const
+{
+    std::vector< std::unique_ptr< Node > > children;
+    auto addChild = [ & ]( eNodeKind kind, tTypeId typeId, unsigned int quantity, tTypeId blueprintId )
+    {
+        auto child = std::make_unique< Node >();
+        child->kind = kind;
+        child->typeId = typeId;
+        child->quantity = quantity;
+        child->blueprintId = blueprintId;
+        child->parent = &node;
+        child->row = static_cast< int >( children.size() );
+        children.push_back( std::move( child ) );
+    };
+
+    const auto blueprint = GlobalRessources::GetBlueprintById( node.blueprintId );
+    if ( blueprint == nullptr || blueprint->GetProductionJob() == nullptr )
+        return children;
+    const auto job = blueprint->GetProductionJob();
+
+    switch ( node.kind )
+    {
+        case eNodeKind::Blueprint:
+            addChild( eNodeKind::TotalRawMaterials, 0, 0, node.blueprintId );
+            addChild( eNodeKind::Details, 0, 0, node.blueprintId );
+            break;
+        case eNodeKind::TotalRawMaterials:
+            for ( const auto& [ matTypeId, quantity ] : job->GetRecursedRawMaterialList() )
+                addChild( eNodeKind::RecursedRawMaterial, matTypeId, quantity, 0 );
+            break;
+        case eNodeKind::Details:
+        case eNodeKind::Component:
+            for ( const auto& matReq : job->GetRawMaterials() )
+                addChild( eNodeKind::RawMaterial, matReq.item, matReq.quantity, 0 );
+            for ( const auto& component : job->GetComponents() )
+            {
+                const auto componentBlueprint = GlobalRessources::GetBlueprintByProductId( component.item );
+                const tTypeId componentBlueprintId = componentBlueprint != nullptr ? componentBlueprint->GetTypeId() : 0;
+                addChild( eNodeKind::Component, component.item, component.quantity, componentBlueprintId );
+            }
+            break;
+        default:
+            break;
+    }
+    return children;
+}
+
+QString MaterialTreeModel::GetTypeName( tTypeId typeId ) const
+{
+    const auto type = GlobalRessources::GetTypeById( typeId );
+    if ( type == nullptr )
+        return tr( "Unknown type %1" ).arg( typeId );
+    return QString::fromStdString( type->GetName() );
+}
@@ -1,5 +1,7 @@
 #include "Ore.h"
+#include "JsonlWriter.h"
 #include "LogManager.h"
+#include "SdeImport.h"
 
 #include <qjsonarray.h>
 #include <qjsonobject.h>
@@ -9,6 +11,13 @@ Ore::Ore( const QJsonObject& jsonData )
     FromJsonObject( jsonData );
 }
 
+Ore::Ore( const SdeOreRecord& record )
+    : refinedProducts_( record.materials.begin(), record.materials.end() )
+{
+    typeId_ = record.typeId;
+    isValid_ = record.isValid;
+}
+
 void Ore::FromJsonObject( const QJsonObject& jsonData )
 {
     if ( !jsonData.contains( "_key" ) || !jsonData.contains( "materials" ) )
@@ -47,24 +56,21 @@ void Ore::FromJsonObject( const QJsonObject& jsonData )
     isValid_ = true;
 }
 
-QJsonObject Ore::ToJsonObject() const
+void Ore::WriteJson( JsonlWriter& writer ) const
 {
-    QJsonObject obj;
-
-    obj[ "_key" ] = QString::number( typeId_ );
-
-    QJsonArray materialsArray;
+    writer.BeginObject();
+    writer.Member( "_key", typeId_ );
+    writer.Key( "materials" );
+    writer.BeginArray();
     for ( const auto& refinedProduct : refinedProducts_ )
     {
-        QJsonObject matObj;
-        matObj[ "materialTypeID" ] = QString::number( refinedProduct.item );
-        matObj[ "quantity" ] = QString::number( refinedProduct.quantity );
-        materialsArray.append( matObj );
+        writer.BeginObject();
+        writer.Member( "materialTypeID", refinedProduct.item );
+        writer.Member( "quantity", refinedProduct.quantity );
+        writer.EndObject();
     }
-
-    obj[ "materials" ] = materialsArray;
-
-    return obj;
+    writer.EndArray();
+    writer.EndObject();
 }
 
 void Ore::PostLoadingInitialization()
@@ -0,0 +1,199 @@
+#include "OreSolutionCache.h"
+#include "HelperFunctions.h"
+#include "LogManager.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+static constexpr quint32 CACHE_FILE_MAGIC = 0x454f4c50; // "EOLP"
+static constexpr quint32 CACHE_FILE_VERSION = 1;
+
+uint64_t OreSolutionKey::Hash() const
+{
+    uint64_t hash = HashValue( pricesVersion );
+    hash = HashValue( yieldsVersion, hash );
+    for ( const auto& [ typeId, quantity ] : requirements )
+    {
+        hash = HashValue( typeId, hash );
+        hash = HashValue( quantity, hash );
+    }
+    return hash;
+}
+
+bool OreSolutionKey::operator==( const OreSolutionKey& other ) const
+{
+    if ( pricesVersion != other.pricesVersion || yieldsVersion != other.yieldsVersion )
+        return false;
+    if ( requirements.size() != other.requirements.size() )
+        return false;
+    for ( size_t i = 0; i < requirements.size(); ++i )
+    {
+        if ( requirements[ i ].item != other.requirements[ i ].item || requirements[ i ].quantity != other.requirements[ i ].quantity )
+            return false;
+    }
+    return true;
+}
+
+OreSolutionCache::OreSolutionCache( size_t capacity )
+    : capacity_( capacity > 0 ? capacity : 1 )
+{
+}
+
+std::optional< OreSolution > OreSolutionCache::Find( const OreSolutionKey& key )
+{
+    const uint64_t hash = key.Hash();
+    std::lock_guard< std::mutex > guard( mutex_ );
+    auto it = entriesByHash_.find( hash );
+    if ( it == entriesByHash_.end() || !( it->second->key == key ) )
+        return std::nullopt;
+
+    entries_.splice( entries_.begin(), entries_, it->second );
+    return it->second->solution;
+}
+
+void OreSolutionCache::Insert( const OreSolutionKey& key, const OreSolution& solution )
+{
+    const uint64_t hash = key.Hash();
+    std::lock_guard< std::mutex > guard( mutex_ );
+    InsertLocked( hash, key, solution );
+}
+
+void OreSolutionCache::Clear()
+{
+    std::lock_guard< std::mutex > guard( mutex_ );
+    entries_.clear();
+    entriesByHash_.clear();
+}
+
+size_t OreSolutionCache::GetSize() const
+{
+    std::lock_guard< std::mutex > guard( mutex_ );
+    return entries_.size();
+}
+
+void OreSolutionCache::InsertLocked( uint64_t hash, const OreSolutionKey& key, const OreSolution& solution )
+{
+    auto it = entriesByHash_.find( hash );
+    if ( it != entriesByHash_.end() )
+    {
+        entries_.erase( it->second );
+        entriesByHash_.erase( it );
+    }
+
+    entries_.push_front( Entry{ hash, key, solution } );
+    entriesByHash_[ hash ] = entries_.begin();
+
+    while ( entries_.size() > capacity_ )
+    {
+        entriesByHash_.erase( entries_.back().hash );
+        entries_.pop_back();
+    }
+}
+
+static void WriteQuantityMap( QDataStream& stream, const std::map< tTypeId, unsigned int >& map )
+{
+    stream << static_cast< quint32 >( map.size() );
+    for ( const auto& [ typeId, quantity ] : map )
+        stream << static_cast< quint32 >( typeId ) << static_cast< quint32 >( quantity );
+}
+
+static void ReadQuantityMap( QDataStream& stream, std::map< tTypeId, unsigned int >& map )
+{
+    quint32 size = 0;
+    stream >> size;
+    for ( quint32 i = 0; i < size && stream.status() == QDataStream::Ok; ++i )
+    {
+        quint32 typeId = 0;
+        quint32 quantity = 0;
+        stream >> typeId >> quantity;
+        map[ typeId ] = quantity;
+    }
+}
+
+bool OreSolutionCache::LoadFromFile( const QString& filePath )
+{
+    QFile file( filePath );
+    if ( !file.exists() )
+        return false;
+    if ( !file.open( QIODevice::ReadOnly ) )
+    {
+        LOG_WARNING( "Could not open ore solution cache {}", filePath.toStdString() );
+        return false;
+    }
+
+    QDataStream stream( &file );
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 entryCount = 0;
+    stream >> magic >> version >> entryCount;
+    if ( magic != CACHE_FILE_MAGIC || version != CACHE_FILE_VERSION )
+    {
+        LOG_NOTICE( "Ignoring ore solution cache {} with unknown format", filePath.toStdString() );
+        return false;
+    }
+
+    std::lock_guard< std::mutex > guard( mutex_ );
+    entries_.clear();
+    entriesByHash_.clear();
+    // Entries are stored most recent first, inserting from the back keeps the LRU order.
+    std::vector< std::pair< OreSolutionKey, OreSolution > > loaded;
+    for ( quint32 i = 0; i < entryCount && stream.status() == QDataStream::Ok; ++i )
+    {
+        OreSolutionKey key;
+        OreSolution solution;
+        quint64 pricesVersion = 0;
+        quint64 yieldsVersion = 0;
+        quint32 requirementCount = 0;
+        stream >> pricesVersion >> yieldsVersion >> requirementCount;
+        key.pricesVersion = pricesVersion;
+        key.yieldsVersion = yieldsVersion;
+        for ( quint32 r = 0; r < requirementCount && stream.status() == QDataStream::Ok; ++r )
+        {
+            quint32 typeId = 0;
+            quint32 quantity = 0;
+            stream >> typeId >> quantity;
+            key.requirements.push_back( { typeId, quantity } );
+        }
+        ReadQuantityMap( stream, solution.compressedOres );
+        ReadQuantityMap( stream, solution.leftover );
+        loaded.emplace_back( std::move( key ), std::move( solution ) );
+    }
+    if ( stream.status() != QDataStream::Ok )
+    {
+        LOG_WARNING( "Ore solution cache {} is truncated, ignoring it", filePath.toStdString() );
+        return false;
+    }
+
+    for ( auto it = loaded.rbegin(); it != loaded.rend(); ++it )
+        InsertLocked( it->first.Hash(), it->first, it->second );
+    LOG_NOTICE( "Loaded {} ore solutions from {}", entries_.size(), filePath.toStdString() );
+    return true;
+}
+
+bool OreSolutionCache::SaveToFile( const QString& filePath ) const
+{
+    if ( !QDir().mkpath( QFileInfo( filePath ).absolutePath() ) )
+        return false;
+    QFile file( filePath );
+    if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+    {
+        LOG_WARNING( "Could not write ore solution cache {}", filePath.toStdString() );
+        return false;
+    }
+
+    QDataStream stream( &file );
+    std::lock_guard< std::mutex > guard( mutex_ );
+    stream << CACHE_FILE_MAGIC << CACHE_FILE_VERSION << static_cast< quint32 >( entries_.size() );
+    for ( const Entry& entry : entries_ )
+    {
+        stream << static_cast< quint64 >( entry.key.pricesVersion ) << static_cast< quint64 >( entry.key.yieldsVersion );
+        stream << static_cast< quint32 >( entry.key.requirements.size() );
+        for ( const auto& [ typeId, quantity ] : entry.key.requirements )
+            stream << static_cast< quint32 >( typeId ) << static_cast< quint32 >( quantity );
+        WriteQuantityMap( stream, entry.solution.compressedOres );
+        WriteQuantityMap( stream, entry.solution.leftover );
+    }
+    return stream.status() == QDataStream::Ok;
+}
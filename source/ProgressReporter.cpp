@@ -0,0 +1,79 @@
+#include "ProgressReporter.h"
+
+#include <algorithm>
+#include <cstring>
+
+void ProgressReporter::SetMainStep( int step, int stepCount, const char* description )
+{
+    mainDescription_.store( description, std::memory_order_relaxed );
+    mainStepCount_.store( stepCount, std::memory_order_relaxed );
+    mainStep_.store( step, std::memory_order_relaxed );
+}
+
+void ProgressReporter::SetSubTask( const char* description, qint64 total, qint64 current )
+{
+    SetSubDetail( {} );
+    subDescription_.store( description, std::memory_order_relaxed );
+    subTotal_.store( total, std::memory_order_relaxed );
+    subCurrent_.store( current, std::memory_order_relaxed );
+}
+
+void ProgressReporter::SetSubDetail( std::string_view detail )
+{
+    std::lock_guard< std::mutex > guard( detailLock_ );
+    detailSize_ = std::min( detail.size(), MAX_DETAIL_SIZE );
+    std::memcpy( detail_.data(), detail.data(), detailSize_ );
+}
+
+void ProgressReporter::SetSubTotal( qint64 total )
+{
+    subTotal_.store( total, std::memory_order_relaxed );
+}
+
+void ProgressReporter::SetSubProgress( qint64 current )
+{
+    subCurrent_.store( current, std::memory_order_relaxed );
+}
+
+void ProgressReporter::AdvanceSubProgress( qint64 count )
+{
+    subCurrent_.fetch_add( count, std::memory_order_relaxed );
+}
+
+void ProgressReporter::SetThroughput( double bytesPerSecond, double recordsPerSecond, double etaSeconds )
+{
+    bytesPerSecond_.store( bytesPerSecond, std::memory_order_relaxed );
+    recordsPerSecond_.store( recordsPerSecond, std::memory_order_relaxed );
+    etaSeconds_.store( etaSeconds, std::memory_order_relaxed );
+}
+
+double ProgressReporter::GetSubProgressFraction() const
+{
+    const qint64 total = subTotal_.load( std::memory_order_relaxed );
+    if ( total <= 0 )
+        return 0.0;
+    return std::clamp( static_cast< double >( subCurrent_.load( std::memory_order_relaxed ) ) / static_cast< double >( total ), 0.0, 1.0 );
+}
+
+ProgressSnapshot ProgressReporter::Sample() const
+{
+    ProgressSnapshot snapshot;
+    snapshot.mainStep = mainStep_.load( std::memory_order_relaxed );
+    snapshot.mainStepCount = mainStepCount_.load( std::memory_order_relaxed );
+    snapshot.mainDescription = QString::fromUtf8( mainDescription_.load( std::memory_order_relaxed ) );
+    snapshot.subCurrent = subCurrent_.load( std::memory_order_relaxed );
+    snapshot.subTotal = subTotal_.load( std::memory_order_relaxed );
+    snapshot.subDescription = QString::fromUtf8( subDescription_.load( std::memory_order_relaxed ) );
+    {
+        std::lock_guard< std::mutex > guard( detailLock_ );
+        if ( detailSize_ > 0 )
+        {
+            snapshot.subDescription += QLatin1Char( ' ' );
+            snapshot.subDescription += QString::fromUtf8( detail_.data(), static_cast< qsizetype >( detailSize_ ) );
+        }
+    }
+    snapshot.bytesPerSecond = bytesPerSecond_.load( std::memory_order_relaxed );
+    snapshot.recordsPerSecond = recordsPerSecond_.load( std::memory_order_relaxed );
+    snapshot.etaSeconds = etaSeconds_.load( std::memory_order_relaxed );
+    return snapshot;
+}
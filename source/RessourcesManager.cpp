@@ -2,11 +2,17 @@
 #include "EveType.h"
 #include "GlobalRessources.h"
 #include "HelperFunctions.h"
+#include "InventionCalculator.h"
+#include "JsonCursor.h"
+#include "JsonlWriter.h"
+#include "LineIndex.h"
 #include "LogManager.h"
 #include "Ore.h"
+#include "SdeJsonParser.h"
+#include "SnapshotFile.h"
 
-#include <QBinaryJson>
 #include <QCoreapplication>
+#include <QDateTime>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
@@ -14,22 +20,32 @@
 #include <QJsonObject>
 #include <QJsonParseError>
 #include <QSettings>
+#include <QThread>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
 
 static constexpr const char* TYPES_JSONL = "types.jsonl";
 static constexpr const char* BLUEPRINTS_JSONL = "blueprints.jsonl";
 static constexpr const char* TYPEMATERIALS_JSONL = "typeMaterials.jsonl";
 static constexpr const char* GROUPS_JSONL = "groups.jsonl";
 static constexpr unsigned int ORES_CATEGORY_ID = 25;
+static constexpr int PARSE_POLL_INTERVAL_MS = 50;      // Throughput refresh while the parse workers run.
+static constexpr size_t JSON_BYTES_PER_ARENA_BYTE = 4; // Initial arena size, records take a fraction of their JSON text.
+static constexpr const char* COMPRESS_SNAPSHOTS_SETTING = "StaticData/CompressSnapshots";
 
 static constexpr std::array< const char*, static_cast< int >( eDataLoadingSteps::Count ) > currentDataLoadingStep = {
     "Waiting...",
     "Downloading SDE...",
     "Extracting SDE...",
     "Validating SDE...",
-    "Loading Jsonl files...",
-    "Loading types...",
+    "Fetching market prices...",
+    "Reading groups...",
     "Loading blueprints...",
     "Loading ores...",
+    "Loading types...",
     "Filtering irrelevant data...",
     "Saving filtered json...",
     "Finalizing..." };
@@ -38,30 +54,45 @@ RessourcesManager::RessourcesManager( QSettings& settings, QObject* parent )
     : QObject( parent )
     , settings_( settings )
     , dataLoader_( std::make_unique< DataLoader >() )
-    , BINARY_DATA_DIRECTORY_PATH_( QCoreApplication::applicationDirPath() + "/ressources/generated/data/" )
+    , progress_( std::make_shared< ProgressReporter >() )
+    , BINARY_DATA_DIRECTORY_PATH_( GetBinaryDataDirectoryPath() )
     , BINARY_TYPES_FILEPATH_( BINARY_DATA_DIRECTORY_PATH_ + "types.bin" )
     , BINARY_BLUEPRINTS_FILEPATH_( BINARY_DATA_DIRECTORY_PATH_ + "blueprints.bin" )
     , BINARY_ORES_FILEPATH_( BINARY_DATA_DIRECTORY_PATH_ + "ores.bin" )
+    , LOAD_METRICS_FILEPATH_( QCoreApplication::applicationDirPath() + "/ressources/generated/load_metrics.jsonl" )
+{
+    telemetry_.LoadHistory( LOAD_METRICS_FILEPATH_ );
+    dataLoader_->SetProgressReporter( progress_ );
+}
+
+std::shared_ptr< const ProgressReporter > RessourcesManager::GetProgressReporter() const
 {
+    return progress_;
+}
+
+QString RessourcesManager::GetBinaryDataDirectoryPath()
+{
+    return QCoreApplication::applicationDirPath() + "/ressources/generated/data/";
 }
 
 void RessourcesManager::LoadRessources()
 {
-    if ( QFile::exists( BINARY_TYPES_FILEPATH_ ) && QFile::exists( BINARY_BLUEPRINTS_FILEPATH_ ) && QFile::exists( BINARY_ORES_FILEPATH_ ) )
+    PROFILE_FUNCTION();
+    const eSnapshotStatus snapshotStatus = LoadMapsFromBinaryFiles();
+    if ( snapshotStatus == eSnapshotStatus::Valid )
     {
-        if ( !LoadMapsFromBinaryFiles() )
-            LOG_WARNING( "Failed to load ressources from binary files, falling back to JSON." );
-        else
-        {
-            LOG_NOTICE( "Loaded ressources from binary files." );
-            OnRessourcesReady();
-            return;
-        }
+        LOG_NOTICE( "Loaded ressources from binary files." );
+        OnRessourcesReady();
+        return;
     }
+    if ( snapshotStatus == eSnapshotStatus::Missing )
+        LOG_NOTICE( "No binary files yet, loading ressources from JSON." );
+    else
+        LOG_WARNING( "Failed to load ressources from binary files, falling back to JSON." );
 
     connect( dataLoader_.get(), &DataLoader::MainDataLoadingStepChanged, this, &RessourcesManager::SetLoadingStep );
-    connect( dataLoader_.get(), &DataLoader::SubDataLoadingStepChanged, this, &RessourcesManager::RessourcesLoadingSubStepChanged );
     connect( dataLoader_.get(), &DataLoader::ErrorOccurred, this, &RessourcesManager::ErrorOccured );
+    connect( dataLoader_.get(), &DataLoader::LoadingBytesRead, this, [ this ]( qint64 bytes ) { telemetry_.AddBytesRead( bytes ); } );
     connect( dataLoader_.get(), &DataLoader::MarketPricesReady, this, &RessourcesManager::LoadSdeData );
 
     dataLoader_->StartDataLoading();
@@ -69,32 +100,74 @@ void RessourcesManager::LoadRessources()
 
 void RessourcesManager::SetLoadingStep( eDataLoadingSteps step )
 {
-    emit RessourcesLoadingMainStepChanged(
-        static_cast< int >( step ), static_cast< int >( eDataLoadingSteps::Count ), currentDataLoadingStep[ static_cast< int >( step ) ] );
+    const char* description = currentDataLoadingStep[ static_cast< int >( step ) ];
+    telemetry_.BeginStage( step, description );
+    progress_->SetMainStep( static_cast< int >( step ), static_cast< int >( eDataLoadingSteps::Count ), description );
+    progress_->SetSubTask( "", 0 );
+    emit RessourcesLoadingMainStepChanged( static_cast< int >( step ), static_cast< int >( eDataLoadingSteps::Count ), description );
+    ReportThroughput();
+}
+
+void RessourcesManager::ReportThroughput()
+{
+    const LoadThroughput throughput = telemetry_.GetThroughput( progress_->GetSubProgressFraction() );
+    progress_->SetThroughput( throughput.bytesPerSecond, throughput.recordsPerSecond, throughput.etaSeconds.value_or( -1.0 ) );
+}
+
+void RessourcesManager::WaitForParseWorkers( QThreadPool& threadPool, const std::atomic< qint64 >& parsedLines )
+{
+    qint64 reportedLines = 0;
+    auto reportParsedLines = [ & ]()
+    {
+        const qint64 lines = parsedLines.load( std::memory_order_relaxed );
+        telemetry_.AddRecordsParsed( lines - reportedLines );
+        reportedLines = lines;
+        ReportThroughput();
+    };
+    while ( !threadPool.waitForDone( PARSE_POLL_INTERVAL_MS ) )
+        reportParsedLines();
+    reportParsedLines();
 }
 
 void RessourcesManager::LoadSdeData()
 {
+    PROFILE_FUNCTION();
     QString extractedSdePath = dataLoader_->GetSdeExtractedPath();
     QJsonObject marketPricesJson = dataLoader_->GetMarketPricesJson();
+    marketPricesTimestamp_ = dataLoader_->GetMarketPricesTimestamp();
     dataLoader_->deleteLater();
 
-    if ( !BuildMapFromJsonlFile< EveType >( extractedSdePath + TYPES_JSONL, types_, eDataLoadingSteps::LoadingTypes ) )
+    if ( !BuildMapsFromJsonl( extractedSdePath, marketPricesJson ) )
         return;
-    if ( !BuildMapFromJsonlFile< Blueprint >( extractedSdePath + BLUEPRINTS_JSONL, blueprints_, eDataLoadingSteps::LoadingBlueprints ) )
-        return;
-    if ( !BuildMapFromJsonlFile< Ore >( extractedSdePath + TYPEMATERIALS_JSONL, ores_, eDataLoadingSteps::LoadingOres ) )
-        return;
-    SetManufacturableTypes();
-    FilterIrrelevantTypes( extractedSdePath + GROUPS_JSONL );
-    AddMarketPricesToTypes( marketPricesJson );
-    AddReprocessedFromOreDataToTypes();
     if ( !SaveToBinaryFile() )
         return;
 
     OnRessourcesReady();
 }
 
+bool RessourcesManager::BuildMapsFromJsonl( const QString& extractedSdePath, const QJsonObject& marketPricesJson )
+{
+    PROFILE_FUNCTION();
+    const QDir directory( extractedSdePath );
+    // The small files first, so that the types file, by far the largest, only parses the types they refer to.
+    import_ = std::make_unique< SdeImport >();
+    std::unordered_set< unsigned int > oreGroupIds;
+    if ( !ReadOreGroupIds( directory.filePath( GROUPS_JSONL ), oreGroupIds ) )
+        return false;
+    if ( !StageJsonlFile( directory.filePath( BLUEPRINTS_JSONL ), import_->GetBlueprints(), eDataLoadingSteps::LoadingBlueprints ) )
+        return false;
+    if ( !StageJsonlFile( directory.filePath( TYPEMATERIALS_JSONL ), import_->GetOres(), eDataLoadingSteps::LoadingOres ) )
+        return false;
+    const std::unordered_set< tTypeId > referencedTypeIds = CollectReferencedTypeIds();
+    if ( !StageJsonlFile( directory.filePath( TYPES_JSONL ), import_->GetTypes(), eDataLoadingSteps::LoadingTypes, &referencedTypeIds ) )
+        return false;
+    FilterIrrelevantTypes( oreGroupIds );
+    SetManufacturableTypes();
+    AddMarketPricesToTypes( marketPricesJson );
+    AddReprocessedFromOreDataToTypes();
+    return true;
+}
+
 bool RessourcesManager::OpenFile( const QString& filePath, QFile& outFile, bool isBinary )
 {
     outFile.setFileName( QDir::cleanPath( filePath ) );
@@ -114,157 +187,235 @@ bool RessourcesManager::OpenFile( const QString& filePath, QFile& outFile, bool
     return true;
 }
 
-void RessourcesManager::RemoveNonOreMaterials( const QString& groupFilePath )
+bool RessourcesManager::ReadOreGroupIds( const QString& groupFilePath, std::unordered_set< unsigned int >& oreGroupIds )
 {
+    PROFILE_FUNCTION();
+    SetLoadingStep( eDataLoadingSteps::LoadingJsonlFiles );
     QFile jsonFile;
-    QFileInfo info( jsonFile );
-    if ( !OpenFile( groupFilePath, jsonFile, false ) )
+    MappedFile mappedFile;
+    if ( !OpenFile( groupFilePath, jsonFile, true ) )
+        return false;
+    if ( !mappedFile.Map( jsonFile ) )
     {
-        emit ErrorOccured( tr( "Could not open %1 to filter ores." ).arg( info.absolutePath() ) );
-        return;
+        emit ErrorOccured( tr( "Failed to read %1" ).arg( jsonFile.fileName() ) );
+        return false;
     }
-    std::unordered_set< tTypeId > validOreGroupTypeIds;
-    while ( !jsonFile.atEnd() )
+    const std::string_view data = mappedFile.GetData();
+    const LineIndex& lineIndex = GetLineIndex( jsonFile, data );
+    telemetry_.AddBytesRead( static_cast< qint64 >( data.size() ) );
+    telemetry_.AddRecordsParsed( lineIndex.GetLineCount() );
+    for ( qint64 line = 0; line < lineIndex.GetLineCount(); ++line )
     {
-        QByteArray line = jsonFile.readLine();
-        QJsonParseError parseError;
-        QJsonDocument doc = QJsonDocument::fromJson( line, &parseError );
-        if ( parseError.error != QJsonParseError::NoError )
+        JsonCursor cursor( lineIndex.GetLine( data, line ) );
+        if ( cursor.Peek() != '{' )
         {
-            emit ErrorOccured( tr( "Failed to parse JSON in %1: %2" ).arg( jsonFile.fileName(), parseError.errorString() ) );
-            return;
+            emit ErrorOccured( tr( "Expected JSON object in %1" ).arg( jsonFile.fileName() ) );
+            return false;
         }
-        if ( !doc.isObject() )
+        unsigned int groupId = 0;
+        unsigned int categoryId = 0;
+        const bool isWellFormed = cursor.ForEachMember(
+            [ & ]( std::string_view key )
+            {
+                if ( key == "_key" )
+                    return cursor.Read( groupId );
+                if ( key == "categoryID" )
+                    return cursor.Read( categoryId );
+                return cursor.SkipValue();
+            } );
+        if ( !isWellFormed || !cursor.ExpectEnd() )
         {
-            emit ErrorOccured( tr( "Expected JSON object in %1" ).arg( jsonFile.fileName() ) );
-            return;
+            emit ErrorOccured( tr( "Failed to parse JSON in %1: %2" ).arg( jsonFile.fileName(), QString::fromStdString( cursor.GetError() ) ) );
+            return false;
         }
-        QJsonObject obj = doc.object();
-        tTypeId groupId = obj.value( "_key" ).toInt();
-        tTypeId categoryId = obj.value( "categoryID" ).toInt();
         if ( categoryId == ORES_CATEGORY_ID )
-            validOreGroupTypeIds.insert( groupId );
+            oreGroupIds.insert( groupId );
+    }
+    return true;
+}
+
+std::unordered_set< tTypeId > RessourcesManager::CollectReferencedTypeIds() const
+{
+    PROFILE_FUNCTION();
+    std::unordered_set< tTypeId > typeIds;
+    for ( const auto& [ typeId, record ] : import_->GetBlueprints() )
+    {
+        typeIds.insert( typeId );
+        for ( const std::optional< SdeActivityRecord >& activity : record->activities )
+        {
+            if ( !activity )
+                continue;
+            for ( const auto& product : activity->products )
+                typeIds.insert( product.item );
+            for ( const auto& material : activity->materials )
+                typeIds.insert( material.item );
+        }
     }
+    // Ores need their type too, to be checked for being published and in an ore group.
+    for ( const auto& [ typeId, record ] : import_->GetOres() )
+        typeIds.insert( typeId );
+    for ( const tTypeId decryptorId : InventionCalculator::GetDecryptorIds() )
+        typeIds.insert( decryptorId );
+    return typeIds;
+}
+
+void RessourcesManager::RemoveNonOreMaterials( const std::unordered_set< unsigned int >& oreGroupIds )
+{
+    PROFILE_FUNCTION();
+    SdeRecordMap< SdeOreRecord >& ores = import_->GetOres();
+    const SdeRecordMap< SdeTypeRecord >& types = import_->GetTypes();
     unsigned int removedCount = 0;
-    for ( auto it = ores_.begin(); it != ores_.end(); )
+    for ( auto it = ores.begin(); it != ores.end(); )
     {
-        tTypeId typeId = it->second->GetTypeId();
-        if ( !types_.at( typeId ) )
+        const auto type = types.find( it->first );
+        if ( type == types.end() )
         {
-            LOG_WARNING( "Ore with typeId {} has no corresponding EveType, removing from ores list.", typeId );
-            it = ores_.erase( it );
+            LOG_WARNING( "Ore with typeId {} has no corresponding EveType, removing from ores list.", it->first );
+            it = ores.erase( it );
             continue;
         }
-        unsigned int groupId = types_.at( typeId )->GetGroupId();
-        if ( validOreGroupTypeIds.find( groupId ) == validOreGroupTypeIds.end() )
+        if ( !oreGroupIds.contains( type->second->groupId ) )
         {
-            it = ores_.erase( it );
+            it = ores.erase( it );
             removedCount++;
         }
         else
             ++it;
     }
-    LOG_NOTICE( "Removed {} non-ore materials from ores list, leaving {} ores", removedCount, ores_.size() );
+    LOG_NOTICE( "Removed {} non-ore materials from ores list, leaving {} ores", removedCount, ores.size() );
 }
 
-void RessourcesManager::FilterIrrelevantTypes( const QString& groupFilepath )
+void RessourcesManager::FilterIrrelevantTypes( const std::unordered_set< unsigned int >& oreGroupIds )
 {
+    PROFILE_FUNCTION();
     SetLoadingStep( eDataLoadingSteps::FilteringIrrelevantData );
     static constexpr unsigned int PROGRESS_TOTAL_STEPS = 3;
-    std::unordered_map< tTypeId, std::shared_ptr< EveType > > types;
+    const SdeRecordMap< SdeTypeRecord >& types = import_->GetTypes();
+    SdeRecordMap< SdeBlueprintRecord >& blueprints = import_->GetBlueprints();
+    SdeRecordMap< SdeOreRecord >& ores = import_->GetOres();
+    auto isPublished = [ &types ]( tTypeId typeId )
+    {
+        const auto type = types.find( typeId );
+        return type != types.end() && type->second->isPublished;
+    };
     std::unordered_set< tTypeId > relevantTypeIds;
 
-    emit RessourcesLoadingSubStepChanged( 0, PROGRESS_TOTAL_STEPS, "Identifying relevant blueprints and materials..." );
-    unsigned int removedBlueprints = 0;
-    for ( auto it = blueprints_.begin(); it != blueprints_.end(); )
+    progress_->SetSubTask( "Identifying relevant blueprints and materials...", PROGRESS_TOTAL_STEPS, 0 );
+    for ( auto it = blueprints.begin(); it != blueprints.end(); )
     {
-        const Blueprint& blueprint = *( it->second );
-        const EveType& type = *types_.at( blueprint.GetTypeId() );
-        if ( !type.IsPublished() )
+        const tTypeId typeId = it->first;
+        const SdeActivityRecord& job = *it->second->GetProductionActivity();
+        if ( job.products.empty() )
         {
-            it = blueprints_.erase( it );
-            removedBlueprints++;
+            LOG_WARNING( "Blueprint with typeId {} has no manufactured products, removing from blueprints list.", typeId );
+            it = blueprints.erase( it );
+            continue;
+        }
+        const auto missingProduct =
+            std::find_if( job.products.begin(), job.products.end(), [ &types ]( const auto& product ) { return !types.contains( product.item ); } );
+        if ( missingProduct != job.products.end() )
+        {
+            LOG_WARNING( "Blueprint with typeId {} produces item with typeId {} which is not in the types list, removing blueprint.",
+                         typeId,
+                         missingProduct->item );
+            it = blueprints.erase( it );
+            continue;
+        }
+        if ( !isPublished( typeId ) )
+        {
+            it = blueprints.erase( it );
             continue;
         }
 
-        relevantTypeIds.insert( blueprint.GetTypeId() );
-        const auto job = blueprint.GetManufacturingJob();
-
-        for ( const auto& product : job->GetManufacturedProducts() )
-            relevantTypeIds.insert( product.item );
-        for ( const auto& matReq : job->GetFullMaterialList() )
-            relevantTypeIds.insert( matReq.item );
-        it++;
+        // Every activity is kept, invention and reactions are what T2 and T3 chains are built from.
+        relevantTypeIds.insert( typeId );
+        for ( const std::optional< SdeActivityRecord >& activity : it->second->activities )
+        {
+            if ( !activity )
+                continue;
+            for ( const auto& product : activity->products )
+                relevantTypeIds.insert( product.item );
+            for ( const auto& matReq : activity->materials )
+                relevantTypeIds.insert( matReq.item );
+        }
+        ++it;
     }
+    // Decryptors are optional invention inputs, the SDE does not list them as materials.
+    for ( const tTypeId decryptorId : InventionCalculator::GetDecryptorIds() )
+        relevantTypeIds.insert( decryptorId );
 
-    for ( auto it = ores_.begin(); it != ores_.end(); )
+    for ( auto it = ores.begin(); it != ores.end(); )
     {
-        tTypeId typeId = it->second->GetTypeId();
-        if ( !types_.contains( typeId ) || !types_.at( typeId )->IsPublished() )
+        if ( !isPublished( it->first ) )
         {
-            LOG_NOTICE( "Ore with typeId {} has no corresponding EveType, removing from ores list.", typeId );
-            it = ores_.erase( it );
+            LOG_NOTICE( "Ore with typeId {} has no corresponding EveType, removing from ores list.", it->first );
+            it = ores.erase( it );
             continue;
         }
         ++it;
     }
-    emit RessourcesLoadingSubStepChanged( 1, PROGRESS_TOTAL_STEPS, "Filtering Non ore materials..." );
-    RemoveNonOreMaterials( groupFilepath );
-    emit RessourcesLoadingSubStepChanged( 2, PROGRESS_TOTAL_STEPS, "Building filtered types list..." );
-    for ( const auto& typeId : relevantTypeIds )
+    progress_->SetSubTask( "Filtering Non ore materials...", PROGRESS_TOTAL_STEPS, 1 );
+    RemoveNonOreMaterials( oreGroupIds );
+    progress_->SetSubTask( "Building filtered types list...", PROGRESS_TOTAL_STEPS, 2 );
+    CompactRecords( relevantTypeIds );
+}
+
+void RessourcesManager::CompactRecords( const std::unordered_set< tTypeId >& relevantTypeIds )
+{
+    PROFILE_FUNCTION();
+    const SdeRecordMap< SdeTypeRecord >& types = import_->GetTypes();
+    types_.clear();
+    types_.reserve( relevantTypeIds.size() );
+    for ( const tTypeId typeId : relevantTypeIds )
+    {
+        const auto type = types.find( typeId );
+        if ( type != types.end() )
+            types_.emplace( typeId, std::make_shared< EveType >( *type->second ) );
+    }
+
+    blueprints_.clear();
+    blueprints_.reserve( import_->GetBlueprints().size() );
+    for ( const auto& [ typeId, record ] : import_->GetBlueprints() )
     {
-        if ( types_.find( typeId ) != types_.end() )
-            types.insert( { typeId, types_.at( typeId ) } );
+        std::shared_ptr< Blueprint > blueprint = std::make_shared< Blueprint >( *record );
+        if ( blueprint->IsValid() )
+            blueprints_.emplace( typeId, std::move( blueprint ) );
     }
-    types_.clear();
-    types_ = std::move( types );
+
+    ores_.clear();
+    ores_.reserve( import_->GetOres().size() );
+    for ( const auto& [ typeId, record ] : import_->GetOres() )
+        ores_.emplace( typeId, std::make_shared< Ore >( *record ) );
+
+    LOG_NOTICE( "Kept {} types, {} blueprints and {} ores out of {} types parsed, releasing {:.1f} MiB of import records",
+                types_.size(),
+                blueprints_.size(),
+                ores_.size(),
+                types.size(),
+                static_cast< double >( import_->GetBytesAllocated() ) / ( 1024.0 * 1024.0 ) );
+    import_.reset();
 }
 
 void RessourcesManager::SetManufacturableTypes()
 {
-    for ( auto it = blueprints_.begin(); it != blueprints_.end(); )
+    PROFILE_FUNCTION();
+    for ( const auto& [ typeId, blueprint ] : blueprints_ )
     {
-        const auto& typeId = it->first;
-        const auto& blueprint = it->second;
-        const auto& job = blueprint->GetManufacturingJob();
-
-        if ( job->GetManufacturedProducts().empty() )
+        for ( const auto& product : blueprint->GetProductionJob()->GetManufacturedProducts() )
         {
-            LOG_WARNING( "Blueprint with typeId {} has no manufactured products, removing from blueprints list.", typeId );
-            it = blueprints_.erase( it );
-            continue;
+            const auto type = types_.find( product.item );
+            if ( type == types_.end() )
+                continue;
+            type->second->SetIsManufacturable( true );
+            type->second->SetSourceBlueprintId( typeId );
         }
-
-        bool remove = false;
-        for ( const auto& product : job->GetManufacturedProducts() )
-        {
-            if ( types_.find( product.item ) == types_.end() )
-            {
-                LOG_WARNING( "Blueprint with typeId {} produces item with typeId {} which is not in the types list, removing blueprint.",
-                             typeId,
-                             product.item );
-                remove = true;
-                break;
-            }
-            else
-            {
-                types_.at( product.item )->SetIsManufacturable( true );
-                types_.at( product.item )->SetSourceBlueprintId( typeId );
-            }
-        }
-
-        if ( remove )
-            it = blueprints_.erase( it );
-        else
-            ++it;
     }
 }
 
 bool RessourcesManager::SaveToBinaryFile()
 {
+    PROFILE_FUNCTION();
     SetLoadingStep( eDataLoadingSteps::SavingFilteredJson );
-    static constexpr unsigned int PROGRESS_TOTAL_STEPS = 3;
-    emit RessourcesLoadingSubStepChanged( 0, PROGRESS_TOTAL_STEPS, "Saving types..." );
 
     QDir dir;
     QFileInfo fileInfo( BINARY_DATA_DIRECTORY_PATH_ );
@@ -274,94 +425,132 @@ bool RessourcesManager::SaveToBinaryFile()
         return false;
     }
 
-    QJsonObject typesJson = GetJsonFromMap( types_ );
-    if ( !SaveJsonObjectToBinaryFile( typesJson, BINARY_TYPES_FILEPATH_ ) )
-        return false;
-
-    emit RessourcesLoadingSubStepChanged( 1, PROGRESS_TOTAL_STEPS, "Saving blueprints..." );
-    QJsonObject blueprintsJson = GetJsonFromMap( blueprints_ );
-    if ( !SaveJsonObjectToBinaryFile( blueprintsJson, BINARY_BLUEPRINTS_FILEPATH_ ) )
-        return false;
-
-    emit RessourcesLoadingSubStepChanged( 2, PROGRESS_TOTAL_STEPS, "Saving ores..." );
-    QJsonObject oresJson = GetJsonFromMap( ores_ );
-    if ( !SaveJsonObjectToBinaryFile( oresJson, BINARY_ORES_FILEPATH_ ) )
-        return false;
-
-    return true;
-}
+    const SnapshotMetadata metadata = { DataLoader::GetSdeBuildNumber(), marketPricesTimestamp_ };
+    // Worth it when the snapshots sit on a slow or network drive, reading is then bound by the disk rather than the inflating.
+    const eSnapshotCompression compression =
+        settings_.value( COMPRESS_SNAPSHOTS_SETTING, false ).toBool() ? eSnapshotCompression::ZlibBlocks : eSnapshotCompression::None;
 
-bool RessourcesManager::SaveJsonObjectToBinaryFile( const QJsonObject& jsonObject, const QString& binaryFilepath )
-{
-    LOG_NOTICE( "Saving {} elements to {}", jsonObject.size(), binaryFilepath.toStdString() );
-    QFile file( binaryFilepath );
-    if ( !file.open( QIODevice::WriteOnly ) )
+    struct PendingSnapshot
     {
-        emit ErrorOccured( tr( "Could not save map to %1" ).arg( binaryFilepath ) );
-        return false;
-    }
-
-    QJsonDocument doc( jsonObject );
-    QByteArray data = QBinaryJson::toBinaryData( doc );
-
-    qint64 bytesWritten = file.write( data );
-    if ( bytesWritten != data.size() )
+        QString filePath;
+        std::function< std::string() > serialize;
+        size_t elementCount = 0;
+        qint64 bytesWritten = 0;
+        std::string error;
+    };
+    // Blueprints and ores only depend on the SDE build, a valid snapshot of them is already what would be written.
+    // Types carry the market prices and are always rewritten.
+    std::vector< PendingSnapshot > snapshots;
+    snapshots.push_back( { BINARY_TYPES_FILEPATH_, [ this ]() { return GetJsonlFromMap( types_ ); } } );
+    if ( validSnapshots_.contains( BINARY_BLUEPRINTS_FILEPATH_ ) )
+        LOG_NOTICE( "Keeping valid snapshot {}", BINARY_BLUEPRINTS_FILEPATH_.toStdString() );
+    else
+        snapshots.push_back( { BINARY_BLUEPRINTS_FILEPATH_, [ this ]() { return GetJsonlFromMap( blueprints_ ); } } );
+    if ( validSnapshots_.contains( BINARY_ORES_FILEPATH_ ) )
+        LOG_NOTICE( "Keeping valid snapshot {}", BINARY_ORES_FILEPATH_.toStdString() );
+    else
+        snapshots.push_back( { BINARY_ORES_FILEPATH_, [ this ]() { return GetJsonlFromMap( ores_ ); } } );
+
+    // The tables only read the maps, each is serialized, compressed and written on its own thread.
+    progress_->SetSubTask( "Saving binary files...", snapshots.size() );
+    QThreadPool threadPool;
+    for ( PendingSnapshot& snapshot : snapshots )
     {
-        emit ErrorOccured( tr( "Failed to write all data to file %1" ).arg( binaryFilepath ) );
-        return false;
+        threadPool.start(
+            [ this, &snapshot, &metadata, compression ]()
+            {
+                PROFILE_ZONE( "Save snapshot" );
+                const std::string jsonl = snapshot.serialize();
+                snapshot.elementCount = static_cast< size_t >( std::ranges::count( jsonl, '\n' ) );
+                const QByteArray payload = QByteArray::fromRawData( jsonl.data(), static_cast< qsizetype >( jsonl.size() ) );
+                if ( SnapshotFile::Write( snapshot.filePath, metadata, payload, compression, snapshot.error ) )
+                    snapshot.bytesWritten = payload.size();
+                progress_->AdvanceSubProgress();
+            } );
     }
+    while ( !threadPool.waitForDone( PARSE_POLL_INTERVAL_MS ) )
+        ReportThroughput();
 
-    file.close();
-    settings_.setValue( "StaticData/" + binaryFilepath + "TotalElements", jsonObject.size() );
-#ifndef NDEBUG
-    QFile jsonVersion( binaryFilepath + ".json" );
-    if ( jsonVersion.open( QIODevice::WriteOnly ) )
+    for ( const PendingSnapshot& snapshot : snapshots )
     {
-        jsonVersion.write( doc.toJson( QJsonDocument::Indented ) );
-        jsonVersion.close();
+        if ( !snapshot.error.empty() )
+        {
+            emit ErrorOccured( tr( "Could not save map to %1: %2" ).arg( snapshot.filePath, QString::fromStdString( snapshot.error ) ) );
+            return false;
+        }
+        LOG_NOTICE( "Saved {} elements to {}", snapshot.elementCount, snapshot.filePath.toStdString() );
+        telemetry_.AddBytesWritten( snapshot.bytesWritten );
+        settings_.setValue( "StaticData/" + snapshot.filePath + "TotalElements", static_cast< qulonglong >( snapshot.elementCount ) );
     }
-#endif
     return true;
 }
 
-bool RessourcesManager::LoadMapsFromBinaryFiles()
+eSnapshotStatus RessourcesManager::LoadMapsFromBinaryFiles()
 {
+    PROFILE_FUNCTION();
     SetLoadingStep( eDataLoadingSteps::Finalizing );
-    static constexpr unsigned int PROGRESS_TOTAL_STEPS = 3;
-    emit RessourcesLoadingSubStepChanged( 0, PROGRESS_TOTAL_STEPS, "Loading types from binary files..." );
-    if ( !BuildMapFromBinaryFile< EveType >( BINARY_TYPES_FILEPATH_, types_ ) )
-        return false;
-    emit RessourcesLoadingSubStepChanged( 1, PROGRESS_TOTAL_STEPS, "Loading blueprints from binary files..." );
-    if ( !BuildMapFromBinaryFile< Blueprint >( BINARY_BLUEPRINTS_FILEPATH_, blueprints_ ) )
-        return false;
-    emit RessourcesLoadingSubStepChanged( 2, PROGRESS_TOTAL_STEPS, "Loading ores from binary files..." );
-    if ( !BuildMapFromBinaryFile< Ore >( BINARY_ORES_FILEPATH_, ores_ ) )
-        return false;
-    emit RessourcesLoadingSubStepChanged( PROGRESS_TOTAL_STEPS, PROGRESS_TOTAL_STEPS, "Done." );
-    return true;
-}
-
-unsigned int RessourcesManager::GetNumberOfLinesInFile( QFile& file )
-{
-    unsigned int lineCount = 0;
-    if ( settings_.contains( "StaticData/" + file.fileName() + "TotalLines" ) )
+    static constexpr unsigned int PROGRESS_TOTAL_STEPS = 4;
+    progress_->SetSubTask( "Checking binary files...", PROGRESS_TOTAL_STEPS, 0 );
+    const std::array< QString, 3 > snapshotPaths = { BINARY_TYPES_FILEPATH_, BINARY_BLUEPRINTS_FILEPATH_, BINARY_ORES_FILEPATH_ };
+    std::array< QByteArray, 3 > payloads;
+    eSnapshotStatus status = eSnapshotStatus::Valid;
+    validSnapshots_.clear();
+    for ( size_t index = 0; index < snapshotPaths.size(); ++index )
     {
-        LOG_NOTICE( "Using cached line count for file {}", file.fileName().toStdString() );
-        return settings_.value( "StaticData/" + file.fileName() + "TotalLines" ).toUInt();
+        SnapshotMetadata metadata;
+        std::string error;
+        const eSnapshotStatus snapshotStatus =
+            SnapshotFile::Read( snapshotPaths[ index ], DataLoader::GetSdeBuildNumber(), metadata, payloads[ index ], error );
+        if ( snapshotStatus == eSnapshotStatus::Missing )
+        {
+            LOG_NOTICE( "Binary file {} does not exist yet, it will be built.", snapshotPaths[ index ].toStdString() );
+            if ( status == eSnapshotStatus::Valid )
+                status = eSnapshotStatus::Missing;
+            continue;
+        }
+        if ( snapshotStatus == eSnapshotStatus::Invalid )
+        {
+            LOG_WARNING( "Binary file {} is unusable, it will be rebuilt: {}", snapshotPaths[ index ].toStdString(), error );
+            status = eSnapshotStatus::Invalid;
+            continue;
+        }
+        telemetry_.AddBytesRead( payloads[ index ].size() );
+        validSnapshots_.insert( snapshotPaths[ index ] );
+        if ( snapshotPaths[ index ] == BINARY_TYPES_FILEPATH_ && metadata.marketPricesTimestampMs > 0 )
+            LOG_NOTICE( "Market prices are {:.1f} hours old",
+                        static_cast< double >( QDateTime::currentMSecsSinceEpoch() - metadata.marketPricesTimestampMs ) / 3600000.0 );
     }
+    if ( status != eSnapshotStatus::Valid )
+        return status;
+
+    progress_->SetSubTask( "Loading types from binary files...", PROGRESS_TOTAL_STEPS, 1 );
+    if ( !BuildMapFromSnapshot< EveType >( snapshotPaths[ 0 ], payloads[ 0 ], types_ ) )
+        return eSnapshotStatus::Invalid;
+    progress_->SetSubTask( "Loading blueprints from binary files...", PROGRESS_TOTAL_STEPS, 2 );
+    if ( !BuildMapFromSnapshot< Blueprint >( snapshotPaths[ 1 ], payloads[ 1 ], blueprints_ ) )
+        return eSnapshotStatus::Invalid;
+    progress_->SetSubTask( "Loading ores from binary files...", PROGRESS_TOTAL_STEPS, 3 );
+    if ( !BuildMapFromSnapshot< Ore >( snapshotPaths[ 2 ], payloads[ 2 ], ores_ ) )
+        return eSnapshotStatus::Invalid;
+    progress_->SetSubTask( "Done.", PROGRESS_TOTAL_STEPS, PROGRESS_TOTAL_STEPS );
+    return eSnapshotStatus::Valid;
+}
 
-    while ( !file.atEnd() )
-    {
-        file.readLine();
-        ++lineCount;
-    }
-    file.seek( 0 );
-    settings_.setValue( "StaticData/" + file.fileName() + "TotalLines", lineCount );
-    return lineCount;
+const LineIndex& RessourcesManager::GetLineIndex( const QFile& file, std::string_view data )
+{
+    PROFILE_FUNCTION();
+    const QFileInfo info( file );
+    LineIndex& lineIndex = lineIndexes_[ info.absoluteFilePath() ];
+    if ( lineIndex.IsUpToDate( info ) )
+        LOG_NOTICE( "Using cached line index for file {}", file.fileName().toStdString() );
+    else
+        lineIndex.Build( data, info );
+    return lineIndex;
 }
 
 void RessourcesManager::AddMarketPricesToTypes( const QJsonObject& marketPricesJson )
 {
+    PROFILE_FUNCTION();
     for ( auto& [ typeId, eveType ] : types_ )
     {
         if ( marketPricesJson.contains( QString::number( typeId ) ) )
@@ -374,6 +563,7 @@ void RessourcesManager::AddMarketPricesToTypes( const QJsonObject& marketPricesJ
 
 void RessourcesManager::AddReprocessedFromOreDataToTypes()
 {
+    PROFILE_FUNCTION();
     for ( const auto& [ oreTypeId, ore ] : ores_ )
     {
         for ( const auto& refinedProducts : ore->GetRefinedProducts() )
@@ -387,8 +577,8 @@ void RessourcesManager::AddReprocessedFromOreDataToTypes()
 
 bool RessourcesManager::IsBlueprintValid( const Blueprint& blueprint ) const
 {
-    const auto job = blueprint.GetManufacturingJob();
-    if ( !job->IsValid() || !types_.contains( blueprint.GetTypeId() ) )
+    const auto job = blueprint.GetProductionJob();
+    if ( job == nullptr || !job->IsValid() || !types_.contains( blueprint.GetTypeId() ) )
     {
         return false;
     }
@@ -397,116 +587,229 @@ bool RessourcesManager::IsBlueprintValid( const Blueprint& blueprint ) const
 
 void RessourcesManager::OnRessourcesReady()
 {
+    PROFILE_FUNCTION();
     isRessourcesReady_ = true;
+    telemetry_.EndStage();
+    telemetry_.LogSummary();
+    telemetry_.AppendToHistory( LOAD_METRICS_FILEPATH_ );
     GlobalRessources::SetRessources( std::move( types_ ), std::move( blueprints_ ), std::move( ores_ ) );
     emit RessourcesReady();
 }
 
 template < JsonEveChild T >
-QJsonObject RessourcesManager::GetJsonFromMap( const TypeIdMap< T >& map ) const
+std::string RessourcesManager::GetJsonlFromMap( const TypeIdMap< T >& map ) const
 {
-    QJsonObject result;
+    PROFILE_FUNCTION();
+    std::string jsonl;
+    JsonlWriter writer( jsonl );
     for ( const auto& [ typeId, element ] : map )
     {
-        QJsonObject elementObj = element->ToJsonObject();
-        if ( elementObj.contains( "_key" ) )
-            result[ QString::number( typeId ) ] = element->ToJsonObject();
+        if ( !element->IsValid() )
+            continue;
+        element->WriteJson( writer );
+        writer.EndLine();
     }
-    return result;
+    return jsonl;
 }
 
 template < JsonEveChild T >
-bool RessourcesManager::BuildMapFromBinaryFile( const QString& filePath, TypeIdMap< T >& targetMap )
+bool RessourcesManager::BuildMapFromSnapshot( const QString& filePath, const QByteArray& payload, TypeIdMap< T >& targetMap )
 {
-    QFile binFile;
-    if ( !OpenFile( filePath, binFile, true ) )
-        return false;
-    QJsonDocument jsonDoc = QBinaryJson::fromBinaryData( binFile.readAll() );
-    if ( jsonDoc.isNull() || !jsonDoc.isObject() )
+    PROFILE_FUNCTION();
+    const std::string_view data( payload.constData(), static_cast< size_t >( payload.size() ) );
+    LineIndex lineIndex;
+    lineIndex.Build( data, QFileInfo( filePath ) );
+    LOG_NOTICE( "Loading {} elements from {}", lineIndex.GetLineCount(), filePath.toStdString() );
+    progress_->SetSubTask( "Loading", lineIndex.GetLineCount() );
+    progress_->SetSubDetail( QFileInfo( filePath ).fileName().toStdString() );
+
+    // One object per line, built in parallel like the SDE import and merged in file order.
+    struct ParsedChunk
     {
-        emit ErrorOccured( tr( "Failed to parse binary json from %1" ).arg( binFile.fileName() ) );
-        return false;
+        std::vector< std::shared_ptr< T > > elements;
+        QString error;
+        qint64 errorLine = -1;
+    };
+    const std::vector< LineIndex::tLineRange > ranges = lineIndex.Split( QThread::idealThreadCount() );
+    std::vector< ParsedChunk > chunks( ranges.size() );
+    std::atomic< qint64 > parsedLines = 0;
+    std::atomic< bool > hasFailed = false;
+    QThreadPool threadPool;
+    for ( size_t chunkIndex = 0; chunkIndex < ranges.size(); ++chunkIndex )
+    {
+        threadPool.start(
+            [ &, chunkIndex ]()
+            {
+                PROFILE_ZONE( "Load snapshot chunk" );
+                ParsedChunk& chunk = chunks[ chunkIndex ];
+                const auto [ firstLine, lastLine ] = ranges[ chunkIndex ];
+                chunk.elements.reserve( static_cast< size_t >( lastLine - firstLine ) );
+                for ( qint64 line = firstLine; line < lastLine && !hasFailed.load( std::memory_order_relaxed ); ++line )
+                {
+                    const std::string_view text = lineIndex.GetLine( data, line );
+                    QJsonParseError parseError;
+                    const QByteArray json = QByteArray::fromRawData( text.data(), static_cast< qsizetype >( text.size() ) );
+                    const QJsonDocument document = QJsonDocument::fromJson( json, &parseError );
+                    if ( !document.isObject() )
+                    {
+                        chunk.error = parseError.errorString();
+                        chunk.errorLine = line;
+                        hasFailed = true;
+                        return;
+                    }
+                    std::shared_ptr< T > element = std::make_shared< T >( document.object() );
+                    if ( element->IsValid() )
+                        chunk.elements.push_back( std::move( element ) );
+                    else
+                        LOG_WARNING(
+                            "Element with typeId {} in file {} is not valid, skipping.", element->GetTypeId(), filePath.toStdString() );
+                    parsedLines.fetch_add( 1, std::memory_order_relaxed );
+                    progress_->AdvanceSubProgress();
+                }
+            } );
+    }
+    WaitForParseWorkers( threadPool, parsedLines );
+
+    for ( const ParsedChunk& chunk : chunks )
+    {
+        if ( chunk.errorLine >= 0 )
+        {
+            emit ErrorOccured( tr( "Failed to parse %1 line %2: %3" ).arg( filePath ).arg( chunk.errorLine + 1 ).arg( chunk.error ) );
+            return false;
+        }
     }
-    QJsonObject jsonobject = jsonDoc.object();
-    LOG_NOTICE( "Loading {} elements from {}", jsonobject.size(), binFile.fileName().toStdString() );
-    unsigned int currentElement = 0;
-    double lastPercentageProgression = 0.0;
-    for ( const QString& key : jsonobject.keys() )
-    {
-        QJsonObject elementObj = jsonobject.value( key ).toObject();
-        tTypeId elementTypeId = key.toInt();
-        elementObj.insert( "_key", static_cast< int >( elementTypeId ) );
-        std::shared_ptr< T > element = std::make_shared< T >( elementObj );
-        if ( element->IsValid() )
+    targetMap.reserve( targetMap.size() + static_cast< size_t >( lineIndex.GetLineCount() ) );
+    for ( ParsedChunk& chunk : chunks )
+    {
+        for ( std::shared_ptr< T >& element : chunk.elements )
         {
-            targetMap[ elementTypeId ] = element;
-            double percentageProgression =
-                ( static_cast< double >( ++currentElement ) / static_cast< double >( jsonobject.size() ) ) * 100.0;
-            if ( percentageProgression - lastPercentageProgression > 1.0 || currentElement >= jsonobject.size() )
-            {
-                QString msg = tr( "Loading %1... %2%" ).arg( filePath ).arg( static_cast< int >( percentageProgression ) );
-                emit RessourcesLoadingSubStepChanged( currentElement, jsonobject.size(), msg );
-                lastPercentageProgression = percentageProgression;
-            }
+            const tTypeId typeId = element->GetTypeId();
+            targetMap[ typeId ] = std::move( element );
         }
-        else
-            LOG_WARNING( "Element with typeId {} in file {} is not valid, skipping.", elementTypeId, binFile.fileName().toStdString() );
     }
     return true;
 }
 
-template < JsonEveChild T >
-inline bool RessourcesManager::BuildMapFromJsonlFile( const QString& filePath, TypeIdMap< T >& targetMap, eDataLoadingSteps step )
+template < typename TRecord >
+bool RessourcesManager::StageJsonlFile( const QString& filePath,
+                                        SdeRecordMap< TRecord >& targetMap,
+                                        eDataLoadingSteps step,
+                                        const std::unordered_set< tTypeId >* keyFilter )
 {
+    PROFILE_FUNCTION();
     SetLoadingStep( step );
     QFile jsonFile;
-    if ( !OpenFile( filePath, jsonFile, false ) )
+    MappedFile mappedFile;
+    if ( !OpenFile( filePath, jsonFile, true ) )
         return false;
-    unsigned int totalLines = GetNumberOfLinesInFile( jsonFile );
-    unsigned int currentLine = 0;
-    double lastPercentageProgression = 0.0;
-    while ( !jsonFile.atEnd() )
+    if ( !mappedFile.Map( jsonFile ) )
     {
-        QByteArray line = jsonFile.readLine();
-        QJsonParseError parseError;
-        QJsonDocument doc = QJsonDocument::fromJson( line, &parseError );
-
-        if ( parseError.error != QJsonParseError::NoError )
-        {
-            emit ErrorOccured( tr( "Failed to parse JSON in %1: %2" ).arg( jsonFile.fileName(), parseError.errorString() ) );
-            return false;
-        }
-        if ( !doc.isObject() )
-        {
-            emit ErrorOccured( tr( "Expected JSON object in %1" ).arg( jsonFile.fileName() ) );
-            return false;
-        }
+        emit ErrorOccured( tr( "Failed to read %1" ).arg( jsonFile.fileName() ) );
+        return false;
+    }
+    const std::string_view data = mappedFile.GetData();
+    const LineIndex& lineIndex = GetLineIndex( jsonFile, data );
+    telemetry_.AddBytesRead( static_cast< qint64 >( data.size() ) );
+    progress_->SetSubTask( "Loading", lineIndex.GetLineCount() );
+    progress_->SetSubDetail( QFileInfo( jsonFile ).fileName().toStdString() );
+
+    // Each worker parses a range of lines into its own arena and list, merged in file order so later duplicates still win.
+    struct ParsedChunk
+    {
+        SdeImportArena* arena = nullptr;
+        std::vector< const TRecord* > records;
+        std::string error;
+        qint64 errorLine = -1;
+    };
+    const std::vector< LineIndex::tLineRange > ranges = lineIndex.Split( QThread::idealThreadCount() );
+    std::vector< ParsedChunk > chunks( ranges.size() );
+    size_t arenaSize = data.size() / ( std::max< size_t >( chunks.size(), 1 ) * JSON_BYTES_PER_ARENA_BYTE );
+    if ( keyFilter && lineIndex.GetLineCount() > 0 )
+        arenaSize = arenaSize * std::min( keyFilter->size(), static_cast< size_t >( lineIndex.GetLineCount() ) ) / lineIndex.GetLineCount();
+    for ( ParsedChunk& chunk : chunks )
+        chunk.arena = &import_->AddArena( arenaSize );
+    std::atomic< qint64 > parsedLines = 0;
+    std::atomic< qint64 > skippedLines = 0;
+    std::atomic< bool > hasFailed = false;
+    QThreadPool threadPool;
+    for ( size_t chunkIndex = 0; chunkIndex < ranges.size(); ++chunkIndex )
+    {
+        threadPool.start(
+            [ &, chunkIndex ]()
+            {
+                PROFILE_ZONE( "Parse JSON lines chunk" );
+                ParsedChunk& chunk = chunks[ chunkIndex ];
+                const auto [ firstLine, lastLine ] = ranges[ chunkIndex ];
+                chunk.records.reserve( static_cast< size_t >( lastLine - firstLine ) );
+                for ( qint64 line = firstLine; line < lastLine && !hasFailed.load( std::memory_order_relaxed ); ++line )
+                {
+                    const std::string_view text = lineIndex.GetLine( data, line );
+                    // Lines of unwanted records are dropped after their key alone, the rest of them is never read nor validated.
+                    const std::optional< tTypeId > key = keyFilter ? SdeJsonParser::ReadKey( text ) : std::nullopt;
+                    if ( key && !keyFilter->contains( *key ) )
+                    {
+                        skippedLines.fetch_add( 1, std::memory_order_relaxed );
+                    }
+                    else
+                    {
+                        TRecord* record = chunk.arena->template New< TRecord >();
+                        if ( !SdeJsonParser::Parse( text, *record, *chunk.arena, chunk.error ) )
+                        {
+                            chunk.errorLine = line;
+                            hasFailed = true;
+                            return;
+                        }
+                        if ( record->isValid && ( !keyFilter || keyFilter->contains( record->typeId ) ) )
+                            chunk.records.push_back( record );
+                    }
+                    parsedLines.fetch_add( 1, std::memory_order_relaxed );
+                    progress_->AdvanceSubProgress();
+                }
+            } );
+    }
 
-        QJsonObject obj = doc.object();
-        tTypeId elementTypeId = obj.value( "_key" ).toInt();
-        std::shared_ptr< T > element = std::make_shared< T >( obj );
-        if ( element->IsValid() )
-            targetMap[ elementTypeId ] = element;
+    WaitForParseWorkers( threadPool, parsedLines );
 
-        double percentageProgression = ( static_cast< double >( ++currentLine ) / static_cast< double >( totalLines ) ) * 100.0;
-        if ( percentageProgression - lastPercentageProgression > 1.0 || currentLine >= totalLines )
+    for ( const ParsedChunk& chunk : chunks )
+    {
+        if ( chunk.errorLine >= 0 )
         {
-            QString msg = tr( "Loading %1... %2%" ).arg( jsonFile.fileName() ).arg( static_cast< int >( percentageProgression ) );
-            emit RessourcesLoadingSubStepChanged( currentLine, totalLines, msg );
-            lastPercentageProgression = percentageProgression;
+            emit ErrorOccured( tr( "Failed to parse JSON in %1 line %2: %3" )
+                                   .arg( jsonFile.fileName() )
+                                   .arg( chunk.errorLine + 1 )
+                                   .arg( QString::fromStdString( chunk.error ) ) );
+            return false;
         }
     }
+    if ( keyFilter )
+        LOG_NOTICE(
+            "Skipped {} of {} lines of {} after reading their key", skippedLines.load(), lineIndex.GetLineCount(), filePath.toStdString() );
+    targetMap.reserve( targetMap.size() + static_cast< size_t >( lineIndex.GetLineCount() - skippedLines.load() ) );
+    for ( const ParsedChunk& chunk : chunks )
+    {
+        for ( const TRecord* record : chunk.records )
+            targetMap[ record->typeId ] = record;
+    }
     return true;
 }
 
-template bool RessourcesManager::BuildMapFromJsonlFile< EveType >( const QString&, TypeIdMap< EveType >&, eDataLoadingSteps );
-template bool RessourcesManager::BuildMapFromJsonlFile< Blueprint >( const QString&, TypeIdMap< Blueprint >&, eDataLoadingSteps );
-template bool RessourcesManager::BuildMapFromJsonlFile< Ore >( const QString&, TypeIdMap< Ore >&, eDataLoadingSteps );
-
-template QJsonObject RessourcesManager::GetJsonFromMap< EveType >( const TypeIdMap< EveType >& ) const;
-template QJsonObject RessourcesManager::GetJsonFromMap< Blueprint >( const TypeIdMap< Blueprint >& ) const;
-template QJsonObject RessourcesManager::GetJsonFromMap< Ore >( const TypeIdMap< Ore >& ) const;
-
-template bool RessourcesManager::BuildMapFromBinaryFile< EveType >( const QString& filePath, TypeIdMap< EveType >& targetMap );
-template bool RessourcesManager::BuildMapFromBinaryFile< Blueprint >( const QString& filePath, TypeIdMap< Blueprint >& targetMap );
-template bool RessourcesManager::BuildMapFromBinaryFile< Ore >( const QString& filePath, TypeIdMap< Ore >& targetMap );
\ No newline at end of file
+template bool RessourcesManager::StageJsonlFile< SdeTypeRecord >( const QString&,
+                                                                  SdeRecordMap< SdeTypeRecord >&,
+                                                                  eDataLoadingSteps,
+                                                                  const std::unordered_set< tTypeId >* );
+template bool RessourcesManager::StageJsonlFile< SdeBlueprintRecord >( const QString&,
+                                                                       SdeRecordMap< SdeBlueprintRecord >&,
+                                                                       eDataLoadingSteps,
+                                                                       const std::unordered_set< tTypeId >* );
+template bool RessourcesManager::StageJsonlFile< SdeOreRecord >( const QString&,
+                                                                 SdeRecordMap< SdeOreRecord >&,
+                                                                 eDataLoadingSteps,
+                                                                 const std::unordered_set< tTypeId >* );
+
+template std::string RessourcesManager::GetJsonlFromMap< EveType >( const TypeIdMap< EveType >& ) const;
+template std::string RessourcesManager::GetJsonlFromMap< Blueprint >( const TypeIdMap< Blueprint >& ) const;
+template std::string RessourcesManager::GetJsonlFromMap< Ore >( const TypeIdMap< Ore >& ) const;
+
+template bool RessourcesManager::BuildMapFromSnapshot< EveType >( const QString&, const QByteArray&, TypeIdMap< EveType >& );
+template bool RessourcesManager::BuildMapFromSnapshot< Blueprint >( const QString&, const QByteArray&, TypeIdMap< Blueprint >& );
+template bool RessourcesManager::BuildMapFromSnapshot< Ore >( const QString&, const QByteArray&, TypeIdMap< Ore >& );
\ No newline at end of file
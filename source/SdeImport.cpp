@@ -0,0 +1,78 @@
+#include "SdeImport.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <numeric>
+
+static constexpr size_t MIN_ARENA_SIZE = 64 * 1024;
+
+SdeImportArena::SdeImportArena( size_t initialSize )
+    : resource_( std::max( initialSize, MIN_ARENA_SIZE ) )
+{
+}
+
+std::string_view SdeImportArena::CopyString( std::string_view text )
+{
+    if ( text.empty() )
+        return {};
+    char* copy = static_cast< char* >( Allocate( text.size(), alignof( char ) ) );
+    std::memcpy( copy, text.data(), text.size() );
+    return std::string_view( copy, text.size() );
+}
+
+tRecordQuantities SdeImportArena::CopyQuantities( const std::vector< WithQuantity< tTypeId > >& quantities )
+{
+    if ( quantities.empty() )
+        return {};
+    auto* copy = static_cast< WithQuantity< tTypeId >* >(
+        Allocate( quantities.size() * sizeof( WithQuantity< tTypeId > ), alignof( WithQuantity< tTypeId > ) ) );
+    std::uninitialized_copy( quantities.begin(), quantities.end(), copy );
+    return tRecordQuantities( copy, quantities.size() );
+}
+
+size_t SdeImportArena::GetBytesAllocated() const
+{
+    return bytesAllocated_;
+}
+
+void* SdeImportArena::Allocate( size_t size, size_t alignment )
+{
+    bytesAllocated_ += size;
+    return resource_.allocate( size, alignment );
+}
+
+SdeImport::SdeImport()
+    : types_( &mapResource_ )
+    , blueprints_( &mapResource_ )
+    , ores_( &mapResource_ )
+{
+}
+
+SdeImportArena& SdeImport::AddArena( size_t initialSize )
+{
+    return arenas_.emplace_back( initialSize );
+}
+
+size_t SdeImport::GetBytesAllocated() const
+{
+    return std::accumulate( arenas_.begin(),
+                            arenas_.end(),
+                            size_t( 0 ),
+                            []( size_t total, const SdeImportArena& arena ) { return total + arena.GetBytesAllocated(); } );
+}
+
+SdeRecordMap< SdeTypeRecord >& SdeImport::GetTypes()
+{
+    return types_;
+}
+
+SdeRecordMap< SdeBlueprintRecord >& SdeImport::GetBlueprints()
+{
+    return blueprints_;
+}
+
+SdeRecordMap< SdeOreRecord >& SdeImport::GetOres()
+{
+    return ores_;
+}
@@ -0,0 +1,239 @@
+#include "SdeJsonParser.h"
+#include "JsonCursor.h"
+#include "LogManager.h"
+#include "SdeImport.h"
+
+#include <array>
+#include <optional>
+#include <vector>
+
+template < typename TRecord >
+struct SdeField
+{
+    std::string_view key;
+    bool ( *read )( JsonCursor& cursor, TRecord& target, SdeImportArena& arena );
+};
+
+template < typename TRecord, size_t N >
+static bool ReadFields( JsonCursor& cursor, TRecord& target, SdeImportArena& arena, const std::array< SdeField< TRecord >, N >& fields )
+{
+    return cursor.ForEachMember(
+        [ & ]( std::string_view key )
+        {
+            for ( const SdeField< TRecord >& field : fields )
+            {
+                if ( field.key == key )
+                    return field.read( cursor, target, arena );
+            }
+            return cursor.SkipValue();
+        } );
+}
+
+static bool ReadString( JsonCursor& cursor, std::string_view& target, SdeImportArena& arena )
+{
+    std::string_view text;
+    if ( !cursor.Read( text ) )
+        return false;
+    target = arena.CopyString( text );
+    return true;
+}
+
+// Array of { itemKey : typeId, "quantity" : count } objects, entries missing either are dropped.
+// Invention products also carry their "probability", read into probability when given.
+static bool ReadQuantities( JsonCursor& cursor,
+                            std::string_view itemKey,
+                            tRecordQuantities& target,
+                            SdeImportArena& arena,
+                            std::optional< double >* probability = nullptr )
+{
+    thread_local std::vector< WithQuantity< tTypeId > > quantities;
+    quantities.clear();
+    const bool isWellFormed = cursor.ForEachElement(
+        [ & ]()
+        {
+            if ( cursor.Peek() != '{' )
+            {
+                LOG_WARNING( "Invalid material entry." );
+                return cursor.SkipValue();
+            }
+            std::optional< tTypeId > item;
+            std::optional< unsigned int > quantity;
+            const bool isEntryWellFormed = cursor.ForEachMember(
+                [ & ]( std::string_view key )
+                {
+                    if ( key == itemKey && cursor.IsNumber() )
+                        return cursor.Read( item.emplace() );
+                    if ( key == "quantity" && cursor.IsNumber() )
+                        return cursor.Read( quantity.emplace() );
+                    if ( key == "probability" && probability != nullptr && cursor.IsNumber() )
+                        return cursor.Read( probability->emplace() );
+                    return cursor.SkipValue();
+                } );
+            if ( !isEntryWellFormed )
+                return false;
+            if ( !item )
+                LOG_WARNING( "Material missing {}.", std::string( itemKey ) );
+            else if ( !quantity )
+                LOG_WARNING( "Material missing quantity." );
+            else
+                quantities.push_back( { *item, *quantity } );
+            return true;
+        } );
+    if ( !isWellFormed )
+        return false;
+    target = arena.CopyQuantities( quantities );
+    return true;
+}
+
+static bool ReadActivity( JsonCursor& cursor, SdeActivityRecord& target, SdeImportArena& arena )
+{
+    static constexpr std::array< SdeField< SdeActivityRecord >, 3 > FIELDS = { {
+        { "time", []( JsonCursor& cursor, SdeActivityRecord& job, SdeImportArena& ) { return cursor.Read( job.timeInSeconds ); } },
+        { "materials",
+          []( JsonCursor& cursor, SdeActivityRecord& job, SdeImportArena& arena )
+          { return ReadQuantities( cursor, "typeID", job.materials, arena ); } },
+        { "products",
+          []( JsonCursor& cursor, SdeActivityRecord& job, SdeImportArena& arena )
+          { return ReadQuantities( cursor, "typeID", job.products, arena, &job.probability ); } },
+    } };
+
+    return ReadFields( cursor, target, arena, FIELDS );
+}
+
+static std::optional< eIndustryActivity > FindActivity( std::string_view key )
+{
+    for ( size_t index = 0; index < INDUSTRY_ACTIVITY_KEYS.size(); ++index )
+    {
+        if ( INDUSTRY_ACTIVITY_KEYS[ index ] == key )
+            return static_cast< eIndustryActivity >( index );
+    }
+    return std::nullopt;
+}
+
+template < typename TRecord >
+static bool ParseLine( std::string_view line,
+                       TRecord& target,
+                       SdeImportArena& arena,
+                       std::string& error,
+                       bool ( *read )( JsonCursor&, TRecord&, SdeImportArena& ) )
+{
+    JsonCursor cursor( line );
+    if ( cursor.Peek() != '{' )
+    {
+        error = "Expected a JSON object";
+        return false;
+    }
+    if ( read( cursor, target, arena ) && cursor.ExpectEnd() )
+        return true;
+    error = cursor.GetError();
+    return false;
+}
+
+static bool ReadType( JsonCursor& cursor, SdeTypeRecord& target, SdeImportArena& arena )
+{
+    static constexpr std::array< SdeField< SdeTypeRecord >, 10 > FIELDS = { {
+        { "_key", []( JsonCursor& cursor, SdeTypeRecord& type, SdeImportArena& ) { return cursor.Read( type.typeId ); } },
+        { "published", []( JsonCursor& cursor, SdeTypeRecord& type, SdeImportArena& ) { return cursor.Read( type.isPublished ); } },
+        { "groupID", []( JsonCursor& cursor, SdeTypeRecord& type, SdeImportArena& ) { return cursor.Read( type.groupId ); } },
+        { "categoryID", []( JsonCursor& cursor, SdeTypeRecord& type, SdeImportArena& ) { return cursor.Read( type.categoryId ); } },
+        { "marketGroupID", []( JsonCursor& cursor, SdeTypeRecord& type, SdeImportArena& ) { return cursor.Read( type.marketGroupId ); } },
+        { "iconID", []( JsonCursor& cursor, SdeTypeRecord& type, SdeImportArena& ) { return cursor.Read( type.iconId ); } },
+        { "name",
+          []( JsonCursor& cursor, SdeTypeRecord& type, SdeImportArena& arena )
+          {
+              return cursor.ForEachMember( [ & ]( std::string_view language )
+                                           { return language == "en" ? ReadString( cursor, type.name, arena ) : cursor.SkipValue(); } );
+          } },
+        { "description",
+          []( JsonCursor& cursor, SdeTypeRecord& type, SdeImportArena& arena )
+          { return cursor.IsString() ? ReadString( cursor, type.description.emplace(), arena ) : cursor.SkipValue(); } },
+        { "basePrice", []( JsonCursor& cursor, SdeTypeRecord& type, SdeImportArena& ) { return cursor.Read( type.basePrice ); } },
+        { "volume", []( JsonCursor& cursor, SdeTypeRecord& type, SdeImportArena& ) { return cursor.Read( type.volume ); } },
+    } };
+
+    if ( !ReadFields( cursor, target, arena, FIELDS ) )
+        return false;
+    target.isValid = target.typeId != 0;
+    return true;
+}
+
+static bool ReadBlueprint( JsonCursor& cursor, SdeBlueprintRecord& target, SdeImportArena& arena )
+{
+    static constexpr std::array< SdeField< SdeBlueprintRecord >, 2 > FIELDS = { {
+        { "_key", []( JsonCursor& cursor, SdeBlueprintRecord& blueprint, SdeImportArena& ) { return cursor.Read( blueprint.typeId ); } },
+        { "activities",
+          []( JsonCursor& cursor, SdeBlueprintRecord& blueprint, SdeImportArena& arena )
+          {
+              return cursor.ForEachMember(
+                  [ & ]( std::string_view key )
+                  {
+                      const std::optional< eIndustryActivity > activity = FindActivity( key );
+                      if ( !activity || cursor.Peek() != '{' )
+                          return cursor.SkipValue();
+                      return ReadActivity( cursor, blueprint.activities[ static_cast< size_t >( *activity ) ].emplace(), arena );
+                  } );
+          } },
+    } };
+
+    if ( !ReadFields( cursor, target, arena, FIELDS ) )
+        return false;
+    const SdeActivityRecord* production = target.GetProductionActivity();
+    if ( target.typeId == 0 )
+        LOG_WARNING( "Blueprint does not contain a valid typeId." );
+    else if ( production == nullptr )
+        LOG_NOTICE( "Blueprint id {} does not contain manufacturing or reaction job data.", target.typeId );
+    else
+    {
+        if ( production->timeInSeconds == 0 )
+            LOG_WARNING( "Missing time data." );
+        if ( production->materials.empty() )
+            LOG_WARNING( "no materials for manufacture job." );
+        target.isValid = true;
+    }
+    return true;
+}
+
+static bool ReadOre( JsonCursor& cursor, SdeOreRecord& target, SdeImportArena& arena )
+{
+    static constexpr std::array< SdeField< SdeOreRecord >, 2 > FIELDS = { {
+        { "_key", []( JsonCursor& cursor, SdeOreRecord& ore, SdeImportArena& ) { return cursor.Read( ore.typeId ); } },
+        { "materials",
+          []( JsonCursor& cursor, SdeOreRecord& ore, SdeImportArena& arena )
+          { return ReadQuantities( cursor, "materialTypeID", ore.materials, arena ); } },
+    } };
+
+    if ( !ReadFields( cursor, target, arena, FIELDS ) )
+        return false;
+    if ( target.typeId == 0 || target.materials.empty() )
+        LOG_WARNING( "Ore JSON data missing required fields." );
+    else
+        target.isValid = true;
+    return true;
+}
+
+std::optional< tTypeId > SdeJsonParser::ReadKey( std::string_view line )
+{
+    JsonCursor cursor( line );
+    std::string_view key;
+    if ( !cursor.ReadFirstKey( key ) || key != "_key" || !cursor.IsNumber() )
+        return std::nullopt;
+    tTypeId typeId = 0;
+    if ( !cursor.Read( typeId ) )
+        return std::nullopt;
+    return typeId;
+}
+
+bool SdeJsonParser::Parse( std::string_view line, SdeTypeRecord& target, SdeImportArena& arena, std::string& error )
+{
+    return ParseLine( line, target, arena, error, &ReadType );
+}
+
+bool SdeJsonParser::Parse( std::string_view line, SdeBlueprintRecord& target, SdeImportArena& arena, std::string& error )
+{
+    return ParseLine( line, target, arena, error, &ReadBlueprint );
+}
+
+bool SdeJsonParser::Parse( std::string_view line, SdeOreRecord& target, SdeImportArena& arena, std::string& error )
+{
+    return ParseLine( line, target, arena, error, &ReadOre );
+}
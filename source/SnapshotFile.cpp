@@ -0,0 +1,290 @@
+#include "SnapshotFile.h"
+#include "Profiler.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <zlib.h>
+
+static constexpr size_t COMPRESSION_BLOCK_SIZE = 1024 * 1024; // Enough blocks to keep every core busy on a few MiB snapshot.
+
+#pragma pack( push, 1 )
+struct SnapshotHeader
+{
+    char magic[ 4 ];
+    uint32_t formatVersion;
+    int64_t sdeBuildNumber;
+    int64_t marketPricesTimestampMs;
+    uint32_t compression;
+    uint32_t blockCount;
+    uint64_t rawSize;
+    uint64_t storedSize;
+    uint32_t storedCrc32;
+    uint32_t headerCrc32; // Of the bytes above.
+};
+
+struct SnapshotBlock
+{
+    uint32_t compressedSize;
+    uint32_t rawSize;
+};
+#pragma pack( pop )
+
+static_assert( sizeof( SnapshotHeader ) == 56 );
+
+static uint32_t ComputeCrc32( const void* data, size_t size )
+{
+    uLong crc = crc32( 0L, Z_NULL, 0 );
+    const Bytef* bytes = static_cast< const Bytef* >( data );
+    // crc32() takes a uInt length, large buffers go in slices.
+    while ( size > 0 )
+    {
+        const uInt slice = static_cast< uInt >( std::min< size_t >( size, 1u << 30 ) );
+        crc = crc32( crc, bytes, slice );
+        bytes += slice;
+        size -= slice;
+    }
+    return static_cast< uint32_t >( crc );
+}
+
+static size_t GetBlockRawSize( size_t rawSize, uint32_t blockIndex )
+{
+    return std::min( COMPRESSION_BLOCK_SIZE, rawSize - blockIndex * COMPRESSION_BLOCK_SIZE );
+}
+
+// Deflates the blocks in parallel, the block table is followed by the blocks in order.
+static bool CompressBlocks( const QByteArray& payload, QByteArray& stored, uint32_t& blockCount )
+{
+    PROFILE_FUNCTION();
+    const size_t rawSize = static_cast< size_t >( payload.size() );
+    blockCount = static_cast< uint32_t >( ( rawSize + COMPRESSION_BLOCK_SIZE - 1 ) / COMPRESSION_BLOCK_SIZE );
+    std::vector< std::vector< Bytef > > compressedBlocks( blockCount );
+    std::atomic< bool > hasFailed = false;
+    QThreadPool threadPool;
+    for ( uint32_t blockIndex = 0; blockIndex < blockCount; ++blockIndex )
+    {
+        threadPool.start(
+            [ &, blockIndex ]()
+            {
+                PROFILE_ZONE( "Deflate snapshot block" );
+                const uLong blockSize = static_cast< uLong >( GetBlockRawSize( rawSize, blockIndex ) );
+                std::vector< Bytef >& compressed = compressedBlocks[ blockIndex ];
+                uLongf compressedSize = compressBound( blockSize );
+                compressed.resize( compressedSize );
+                const Bytef* source = reinterpret_cast< const Bytef* >( payload.constData() ) + blockIndex * COMPRESSION_BLOCK_SIZE;
+                if ( compress2( compressed.data(), &compressedSize, source, blockSize, Z_DEFAULT_COMPRESSION ) != Z_OK )
+                    hasFailed = true;
+                compressed.resize( compressedSize );
+            } );
+    }
+    threadPool.waitForDone();
+    if ( hasFailed )
+        return false;
+
+    size_t storedSize = blockCount * sizeof( SnapshotBlock );
+    for ( const std::vector< Bytef >& compressed : compressedBlocks )
+        storedSize += compressed.size();
+    stored.resize( static_cast< qsizetype >( storedSize ) );
+    char* table = stored.data();
+    char* blocks = table + blockCount * sizeof( SnapshotBlock );
+    for ( uint32_t blockIndex = 0; blockIndex < blockCount; ++blockIndex )
+    {
+        const std::vector< Bytef >& compressed = compressedBlocks[ blockIndex ];
+        const SnapshotBlock block = { static_cast< uint32_t >( compressed.size() ), static_cast< uint32_t >( GetBlockRawSize( rawSize, blockIndex ) ) };
+        std::memcpy( table + blockIndex * sizeof( SnapshotBlock ), &block, sizeof( block ) );
+        std::memcpy( blocks, compressed.data(), compressed.size() );
+        blocks += compressed.size();
+    }
+    return true;
+}
+
+// Inflates the blocks in parallel, each straight to its place in payload.
+static bool DecompressBlocks( const QByteArray& stored, uint32_t blockCount, uint64_t rawSize, QByteArray& payload, std::string& error )
+{
+    PROFILE_FUNCTION();
+    const size_t tableSize = static_cast< size_t >( blockCount ) * sizeof( SnapshotBlock );
+    if ( static_cast< size_t >( stored.size() ) < tableSize )
+    {
+        error = "truncated block table";
+        return false;
+    }
+    std::vector< SnapshotBlock > blocks( blockCount );
+    std::memcpy( blocks.data(), stored.constData(), tableSize );
+    std::vector< size_t > compressedOffsets( blockCount );
+    std::vector< size_t > rawOffsets( blockCount );
+    size_t compressedOffset = tableSize;
+    size_t rawOffset = 0;
+    for ( uint32_t blockIndex = 0; blockIndex < blockCount; ++blockIndex )
+    {
+        compressedOffsets[ blockIndex ] = compressedOffset;
+        rawOffsets[ blockIndex ] = rawOffset;
+        compressedOffset += blocks[ blockIndex ].compressedSize;
+        rawOffset += blocks[ blockIndex ].rawSize;
+    }
+    if ( compressedOffset != static_cast< size_t >( stored.size() ) || rawOffset != rawSize )
+    {
+        error = "block table does not match the payload size";
+        return false;
+    }
+
+    payload.resize( static_cast< qsizetype >( rawSize ) );
+    char* output = payload.data();
+    std::atomic< bool > hasFailed = false;
+    QThreadPool threadPool;
+    for ( uint32_t blockIndex = 0; blockIndex < blockCount; ++blockIndex )
+    {
+        threadPool.start(
+            [ &, blockIndex ]()
+            {
+                PROFILE_ZONE( "Inflate snapshot block" );
+                const SnapshotBlock& block = blocks[ blockIndex ];
+                uLongf inflatedSize = block.rawSize;
+                const int result = uncompress( reinterpret_cast< Bytef* >( output + rawOffsets[ blockIndex ] ),
+                                               &inflatedSize,
+                                               reinterpret_cast< const Bytef* >( stored.constData() + compressedOffsets[ blockIndex ] ),
+                                               block.compressedSize );
+                if ( result != Z_OK || inflatedSize != block.rawSize )
+                    hasFailed = true;
+            } );
+    }
+    threadPool.waitForDone();
+    if ( hasFailed )
+    {
+        error = "failed to inflate a block";
+        return false;
+    }
+    return true;
+}
+
+bool SnapshotFile::Write( const QString& filePath,
+                          const SnapshotMetadata& metadata,
+                          const QByteArray& payload,
+                          eSnapshotCompression compression,
+                          std::string& error )
+{
+    PROFILE_FUNCTION();
+    SnapshotHeader header = {};
+    QByteArray compressed;
+    if ( compression == eSnapshotCompression::ZlibBlocks && !CompressBlocks( payload, compressed, header.blockCount ) )
+    {
+        error = "Failed to compress " + filePath.toStdString();
+        return false;
+    }
+    const QByteArray& stored = compression == eSnapshotCompression::ZlibBlocks ? compressed : payload;
+
+    std::memcpy( header.magic, MAGIC.data(), sizeof( header.magic ) );
+    header.formatVersion = FORMAT_VERSION;
+    header.sdeBuildNumber = metadata.sdeBuildNumber;
+    header.marketPricesTimestampMs = metadata.marketPricesTimestampMs;
+    header.compression = static_cast< uint32_t >( compression );
+    header.rawSize = static_cast< uint64_t >( payload.size() );
+    header.storedSize = static_cast< uint64_t >( stored.size() );
+    header.storedCrc32 = ComputeCrc32( stored.constData(), static_cast< size_t >( stored.size() ) );
+    header.headerCrc32 = ComputeCrc32( &header, offsetof( SnapshotHeader, headerCrc32 ) );
+
+    QSaveFile file( filePath );
+    if ( !file.open( QIODevice::WriteOnly ) )
+    {
+        error = "Could not open " + filePath.toStdString() + " for writing: " + file.errorString().toStdString();
+        return false;
+    }
+    if ( file.write( reinterpret_cast< const char* >( &header ), sizeof( header ) ) != sizeof( header )
+         || file.write( stored ) != stored.size() )
+    {
+        error = "Failed to write " + filePath.toStdString() + ": " + file.errorString().toStdString();
+        file.cancelWriting();
+        return false;
+    }
+    // Syncs the temporary file to disk before renaming it over the previous snapshot.
+    if ( !file.commit() )
+    {
+        error = "Failed to commit " + filePath.toStdString() + ": " + file.errorString().toStdString();
+        return false;
+    }
+    return true;
+}
+
+eSnapshotStatus SnapshotFile::Read( const QString& filePath,
+                                    int64_t expectedSdeBuildNumber,
+                                    SnapshotMetadata& metadata,
+                                    QByteArray& payload,
+                                    std::string& error )
+{
+    PROFILE_FUNCTION();
+    QFile file( filePath );
+    if ( !file.exists() )
+    {
+        error = "missing";
+        return eSnapshotStatus::Missing;
+    }
+    if ( !file.open( QIODevice::ReadOnly ) )
+    {
+        error = "unreadable: " + file.errorString().toStdString();
+        return eSnapshotStatus::Invalid;
+    }
+    SnapshotHeader header = {};
+    if ( file.read( reinterpret_cast< char* >( &header ), sizeof( header ) ) != sizeof( header ) )
+    {
+        error = "truncated header";
+        return eSnapshotStatus::Invalid;
+    }
+    if ( std::string_view( header.magic, sizeof( header.magic ) ) != MAGIC )
+    {
+        error = "not a snapshot file";
+        return eSnapshotStatus::Invalid;
+    }
+    if ( header.headerCrc32 != ComputeCrc32( &header, offsetof( SnapshotHeader, headerCrc32 ) ) )
+    {
+        error = "corrupted header";
+        return eSnapshotStatus::Invalid;
+    }
+    if ( header.formatVersion != FORMAT_VERSION )
+    {
+        error = "format version " + std::to_string( header.formatVersion ) + " instead of " + std::to_string( FORMAT_VERSION );
+        return eSnapshotStatus::Invalid;
+    }
+    if ( header.sdeBuildNumber != expectedSdeBuildNumber )
+    {
+        error = "built from SDE " + std::to_string( header.sdeBuildNumber ) + " instead of " + std::to_string( expectedSdeBuildNumber );
+        return eSnapshotStatus::Invalid;
+    }
+    if ( static_cast< uint64_t >( file.size() ) != sizeof( header ) + header.storedSize )
+    {
+        error = "file size does not match its header";
+        return eSnapshotStatus::Invalid;
+    }
+    const eSnapshotCompression compression = static_cast< eSnapshotCompression >( header.compression );
+    if ( compression != eSnapshotCompression::None && compression != eSnapshotCompression::ZlibBlocks )
+    {
+        error = "unknown compression " + std::to_string( header.compression );
+        return eSnapshotStatus::Invalid;
+    }
+
+    QByteArray stored = file.readAll();
+    if ( static_cast< uint64_t >( stored.size() ) != header.storedSize )
+    {
+        error = "truncated payload";
+        return eSnapshotStatus::Invalid;
+    }
+    if ( ComputeCrc32( stored.constData(), static_cast< size_t >( stored.size() ) ) != header.storedCrc32 )
+    {
+        error = "payload checksum mismatch";
+        return eSnapshotStatus::Invalid;
+    }
+    if ( compression == eSnapshotCompression::ZlibBlocks )
+    {
+        if ( !DecompressBlocks( stored, header.blockCount, header.rawSize, payload, error ) )
+            return eSnapshotStatus::Invalid;
+    }
+    else
+        payload = std::move( stored );
+    metadata.sdeBuildNumber = header.sdeBuildNumber;
+    metadata.marketPricesTimestampMs = header.marketPricesTimestampMs;
+    return eSnapshotStatus::Valid;
+}
@@ -1,4 +1,6 @@
 #include "ZipExtractor.h"
+#include "Profiler.h"
+#include "ProgressReporter.h"
 
 #include <qdir.h>
 #include <qfileinfo.h>
@@ -57,8 +59,14 @@ ZipExtractor::ZipExtractor( QObject* parent )
 {
 }
 
+void ZipExtractor::SetProgressReporter( ProgressReporter* progress )
+{
+    progress_ = progress;
+}
+
 bool ZipExtractor::ExtractZip( const QString& zipPath, const QString& destPath )
 {
+    PROFILE_FUNCTION();
     if ( zipPath.isEmpty() || destPath.isEmpty() )
     {
         ErrorOccurred( QStringLiteral( "Zip path or destination path is empty." ) );
@@ -101,6 +109,8 @@ bool ZipExtractor::ExtractZip( const QString& zipPath, const QString& destPath )
 
     int completed = 0;
     constexpr size_t BUF_SIZE = 1 << 16;
+    if ( progress_ )
+        progress_->SetSubTask( "Extracting", totalFiles );
 
     for ( zip_uint64_t i = 0; i < entryCount; ++i )
     {
@@ -117,6 +127,9 @@ bool ZipExtractor::ExtractZip( const QString& zipPath, const QString& destPath )
             continue;
         }
 
+        PROFILE_ZONE( "ExtractZipEntry" );
+        if ( progress_ )
+            progress_->SetSubDetail( st.name );
         zip_file_t* zf = zip_fopen_index( za, i, 0 );
         if ( !zf )
         {
@@ -174,7 +187,8 @@ bool ZipExtractor::ExtractZip( const QString& zipPath, const QString& destPath )
         zip_fclose( zf );
 
         ++completed;
-        emit ExtractionProgress( completed, totalFiles, relName );
+        if ( progress_ )
+            progress_->SetSubProgress( completed );
     }
 
     zip_close( za );
@@ -183,6 +197,7 @@ bool ZipExtractor::ExtractZip( const QString& zipPath, const QString& destPath )
 
 bool ZipExtractor::ValidateExtractedData( const QString& zipPath, const QString& destPath )
 {
+    PROFILE_FUNCTION();
     int err = 0;
     const QByteArray zipPathBytes = QFile::encodeName( zipPath );
     zip_t* za = zip_open( zipPathBytes.constData(), ZIP_CHECKCONS, &err );
@@ -215,6 +230,8 @@ bool ZipExtractor::ValidateExtractedData( const QString& zipPath, const QString&
     }
 
     int completed = 0;
+    if ( progress_ )
+        progress_->SetSubTask( "Validating", totalFiles );
 
     for ( zip_uint64_t i = 0; i < static_cast< zip_uint64_t >( entryCount ); ++i )
     {
@@ -270,8 +287,11 @@ bool ZipExtractor::ValidateExtractedData( const QString& zipPath, const QString&
         }
 
         ++completed;
-        if ( completed % 100 == 0 || completed == totalFiles )
-            Q_EMIT ValidationProgress( completed, totalFiles, relName );
+        if ( progress_ )
+        {
+            progress_->SetSubDetail( st.name );
+            progress_->SetSubProgress( completed );
+        }
     }
 
     zip_close( za );
@@ -0,0 +1,251 @@
+#include "LogManager.h"
+#include "LogRecord.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <string_view>
+
+// Decodes a binary log written with LOG_BINARY_OUTPUT / EOMULTITOOL_BINARY_LOG.
+// Text output matches the regular log files, JSON output has one object per line with the callsite and the typed arguments.
+
+// Same as LogManager::GetSeparator(), which would open a log file of its own.
+static const std::string SEPARATOR = " || ";
+
+struct DecodedCallsite
+{
+    e_Loglevel level = e_Loglevel::LOG_NONE;
+    uint32_t line = 0;
+    std::string functionName;
+    std::string format;
+};
+
+class LogFileReader
+{
+public:
+    explicit LogFileReader( std::string_view data )
+        : data_( data )
+    {
+    }
+
+    bool IsAtEnd() const
+    {
+        return offset_ >= data_.size();
+    }
+
+    template< typename T >
+    bool Read( T& value )
+    {
+        if ( offset_ + sizeof( T ) > data_.size() )
+            return false;
+        std::memcpy( &value, data_.data() + offset_, sizeof( T ) );
+        offset_ += sizeof( T );
+        return true;
+    }
+
+    bool Skip( size_t size )
+    {
+        if ( offset_ + size > data_.size() )
+            return false;
+        offset_ += size;
+        return true;
+    }
+
+    bool ReadString( std::string_view& text )
+    {
+        uint32_t size = 0;
+        if ( !Read( size ) || offset_ + size > data_.size() )
+            return false;
+        text = data_.substr( offset_, size );
+        offset_ += size;
+        return true;
+    }
+
+    size_t GetOffset() const
+    {
+        return offset_;
+    }
+
+private:
+    std::string_view data_;
+    size_t offset_ = 0;
+};
+
+static std::string EscapeJson( std::string_view text )
+{
+    std::string escaped;
+    escaped.reserve( text.size() );
+    for ( const char character : text )
+    {
+        switch ( character )
+        {
+            case '"':
+                escaped += "\\\"";
+                break;
+            case '\\':
+                escaped += "\\\\";
+                break;
+            case '\n':
+                escaped += "\\n";
+                break;
+            case '\r':
+                escaped += "\\r";
+                break;
+            case '\t':
+                escaped += "\\t";
+                break;
+            default:
+                if ( static_cast< unsigned char >( character ) < 0x20 )
+                    escaped += fmt::format( "\\u{:04x}", static_cast< int >( character ) );
+                else
+                    escaped.push_back( character );
+        }
+    }
+    return escaped;
+}
+
+static std::string ArgumentsToJson( std::string_view arguments )
+{
+    std::string json = "[";
+    auto appendValue = [ &json ]( const auto& value )
+    {
+        using tValue = std::decay_t< decltype( value ) >;
+        if ( json.size() > 1 )
+            json += ",";
+        if constexpr ( std::is_same_v< tValue, std::string_view > )
+            json += fmt::format( "\"{}\"", EscapeJson( value ) );
+        else if constexpr ( std::is_same_v< tValue, char > )
+            json += fmt::format( "\"{}\"", EscapeJson( std::string_view( &value, 1 ) ) );
+        else
+            json += fmt::format( "{}", value );
+    };
+    VisitLogArguments( arguments, appendValue );
+    return json + "]";
+}
+
+static void PrintUsage()
+{
+    fmt::print( stderr, "Usage : LogDecoder <log.bin> [--json]\n" );
+}
+
+int main( int argc, char** argv )
+{
+    std::string inputPath;
+    bool isJsonOutput = false;
+    for ( int i = 1; i < argc; ++i )
+    {
+        const std::string argument = argv[ i ];
+        if ( argument == "--json" )
+            isJsonOutput = true;
+        else if ( argument == "-h" || argument == "--help" )
+        {
+            PrintUsage();
+            return EXIT_SUCCESS;
+        }
+        else
+            inputPath = argument;
+    }
+    if ( inputPath.empty() )
+    {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream inputFile( inputPath, std::ios::binary );
+    if ( !inputFile.is_open() )
+    {
+        fmt::print( stderr, "Could not open {}\n", inputPath );
+        return EXIT_FAILURE;
+    }
+    const std::string data( ( std::istreambuf_iterator< char >( inputFile ) ), std::istreambuf_iterator< char >() );
+
+    LogFileReader reader( data );
+    uint32_t version = 0;
+    int64_t creationTimeNs = 0;
+    if ( data.compare( 0, LOG_BINARY_MAGIC.size(), LOG_BINARY_MAGIC ) != 0 )
+    {
+        fmt::print( stderr, "{} is not a binary log file\n", inputPath );
+        return EXIT_FAILURE;
+    }
+    if ( !reader.Skip( LOG_BINARY_MAGIC.size() ) || !reader.Read( version ) || version != LOG_BINARY_VERSION || !reader.Read( creationTimeNs ) )
+    {
+        fmt::print( stderr, "Unsupported binary log version {} in {}\n", version, inputPath );
+        return EXIT_FAILURE;
+    }
+
+    std::map< uint32_t, DecodedCallsite > callsites;
+    while ( !reader.IsAtEnd() )
+    {
+        const size_t recordOffset = reader.GetOffset();
+        uint8_t kind = 0;
+        uint32_t callsiteId = 0;
+        bool isValid = reader.Read( kind ) && reader.Read( callsiteId );
+        if ( isValid && kind == static_cast< uint8_t >( eLogRecordKind::Callsite ) )
+        {
+            uint8_t level = 0;
+            std::string_view functionName;
+            std::string_view format;
+            DecodedCallsite& callsite = callsites[ callsiteId ];
+            isValid = reader.Read( level ) && reader.Read( callsite.line ) && reader.ReadString( functionName ) && reader.ReadString( format );
+            callsite.level = static_cast< e_Loglevel >( level );
+            callsite.functionName = functionName;
+            callsite.format = format;
+        }
+        else if ( isValid && ( kind == static_cast< uint8_t >( eLogRecordKind::Message ) || kind == static_cast< uint8_t >( eLogRecordKind::Formatted ) ) )
+        {
+            int64_t timestampNs = 0;
+            std::string_view payload;
+            const auto callsiteIterator = callsites.find( callsiteId );
+            isValid = reader.Read( timestampNs ) && reader.ReadString( payload ) && callsiteIterator != callsites.end();
+            if ( isValid )
+            {
+                const DecodedCallsite& callsite = callsiteIterator->second;
+                const bool isFormatted = kind == static_cast< uint8_t >( eLogRecordKind::Formatted );
+                std::string message = isFormatted ? std::string( payload ) : FormatLogRecord( callsite.format, payload );
+                const auto time = std::chrono::system_clock::time_point( std::chrono::duration_cast< std::chrono::system_clock::duration >(
+                    std::chrono::nanoseconds( timestampNs ) ) );
+                const std::time_t seconds = std::chrono::system_clock::to_time_t( time );
+                if ( isJsonOutput )
+                {
+                    fmt::print( "{{\"time\":\"{:%Y-%m-%dT%H:%M:%S}.{:03}\",\"level\":\"{}\",\"function\":\"{}\",\"line\":{},\"callsite\":{},"
+                                "\"format\":\"{}\",\"message\":\"{}\",\"args\":{}}}\n",
+                                fmt::localtime( seconds ),
+                                ( timestampNs / 1000000 ) % 1000,
+                                LogLevelToString( callsite.level ),
+                                EscapeJson( callsite.functionName ),
+                                callsite.line,
+                                callsiteId,
+                                EscapeJson( callsite.format ),
+                                EscapeJson( message ),
+                                isFormatted ? "null" : ArgumentsToJson( payload ) );
+                }
+                else
+                {
+                    ClearAllSeparatorsFromLine( message, SEPARATOR );
+                    fmt::print( "{:%H:%M:%S}{}{}{}{}{}Line : {}{}{}\n",
+                                fmt::localtime( seconds ),
+                                SEPARATOR,
+                                LogLevelToString( callsite.level ),
+                                SEPARATOR,
+                                callsite.functionName,
+                                SEPARATOR,
+                                callsite.line,
+                                SEPARATOR,
+                                message );
+                }
+            }
+        }
+        else
+            isValid = false;
+
+        if ( !isValid )
+        {
+            // A log cut by a crash ends with a partial record, everything before it is still valid.
+            fmt::print( stderr, "Stopped at invalid or truncated record at offset {}\n", recordOffset );
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}